@@ -0,0 +1,328 @@
+/**
+ *  Runs MovingAI benchmark scenarios through dgm::TileNavMesh and
+ *  dgm::WorldNavMesh and reports throughput, latency percentiles and path
+ *  lengths.
+ *
+ *  Usage: pathfinding-benchmark <file.scen> [map directory]
+ *
+ *  Map paths from the scenario file are resolved against the map directory
+ *  (defaults to the directory of the scenario file), falling back to just
+ *  the file name of the map.
+ *
+ *  Optimal lengths listed in MovingAI scenarios are 8-connected, which is
+ *  not the metric of either navmesh. TileNavMesh is 4-connected, so its
+ *  paths are compared to the shortest 4-connected path found by
+ *  a breadth-first search. WorldNavMesh paths go straight between jump
+ *  points and there is no cheap any-angle optimum to compare them to, so
+ *  only their mean length is reported next to the 8-connected one.
+ *
+ *  Benchmark data can be downloaded from https://movingai.com/benchmarks
+ */
+
+#include <DGM/classes/MovingAiLoader.hpp>
+#include <DGM/classes/NavMesh.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <optional>
+#include <queue>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+    using Microseconds = std::chrono::duration<double, std::micro>;
+
+    struct [[nodiscard]] QueryResult final
+    {
+        Microseconds latency = {};
+        std::optional<double> length = {};
+        /// Optimum with the connectivity of the pathfinder, if known
+        std::optional<double> optimalLength = {};
+        /// Optimal length listed in the scenario, 8-connected
+        double scenarioLength = 0.0;
+    };
+
+    struct [[nodiscard]] Report final
+    {
+        std::string name;
+        std::vector<QueryResult> results = {};
+        Microseconds buildTime = {};
+    };
+
+    [[nodiscard]] double getMean(const std::vector<double>& values)
+    {
+        return values.empty()
+                   ? 0.0
+                   : std::accumulate(values.begin(), values.end(), 0.0)
+                         / static_cast<double>(values.size());
+    }
+
+    [[nodiscard]] double getPercentile(
+        const std::vector<Microseconds>& sortedLatencies, double percentile)
+    {
+        if (sortedLatencies.empty()) return 0.0;
+        const auto rank = static_cast<std::size_t>(std::ceil(
+            percentile / 100.0 * static_cast<double>(sortedLatencies.size())));
+        const auto index =
+            std::clamp<std::size_t>(rank, 1u, sortedLatencies.size()) - 1;
+        return sortedLatencies[index].count();
+    }
+
+    void printReport(const Report& report)
+    {
+        auto&& latencies = std::vector<Microseconds>();
+        auto&& ratios = std::vector<double>();
+        auto&& lengths = std::vector<double>();
+        auto&& scenarioLengths = std::vector<double>();
+        std::size_t failures = 0;
+        for (auto&& result : report.results)
+        {
+            latencies.push_back(result.latency);
+            if (!result.length)
+            {
+                ++failures;
+                continue;
+            }
+
+            lengths.push_back(*result.length);
+            scenarioLengths.push_back(result.scenarioLength);
+            if (result.optimalLength && *result.optimalLength > 0.0)
+                ratios.push_back(*result.length / *result.optimalLength);
+        }
+        std::sort(latencies.begin(), latencies.end());
+
+        const auto totalTime = std::accumulate(
+            latencies.begin(), latencies.end(), Microseconds {});
+        const double throughput =
+            totalTime.count() > 0.0
+                ? static_cast<double>(latencies.size()) * 1e6
+                      / totalTime.count()
+                : 0.0;
+        const double maxRatio =
+            ratios.empty() ? 0.0
+                           : *std::max_element(ratios.begin(), ratios.end());
+
+        std::cout << std::fixed << std::setprecision(1) << report.name
+                  << "\n  queries: " << latencies.size()
+                  << ", no path found: " << failures
+                  << "\n  preprocessing: " << report.buildTime.count() / 1000.0
+                  << " ms\n  throughput: " << throughput << " queries/s"
+                  << "\n  latency [us]: p50 " << getPercentile(latencies, 50.0)
+                  << ", p95 " << getPercentile(latencies, 95.0) << ", p99 "
+                  << getPercentile(latencies, 99.0) << ", max "
+                  << getPercentile(latencies, 100.0)
+                  << "\n  mean length: " << getMean(lengths)
+                  << ", 8-connected optimum " << getMean(scenarioLengths);
+        if (!ratios.empty())
+        {
+            std::cout << std::setprecision(4)
+                      << "\n  length / optimal: mean " << getMean(ratios)
+                      << ", max " << maxRatio;
+        }
+        std::cout << "\n";
+    }
+
+    [[nodiscard]] std::optional<std::filesystem::path> resolveMapPath(
+        const std::filesystem::path& mapDir, const std::string& mapPath)
+    {
+        const auto fileName = std::filesystem::path(mapPath).filename();
+        for (auto&& candidate : { mapDir / mapPath, mapDir / fileName })
+        {
+            if (std::filesystem::exists(candidate)) return candidate;
+        }
+        return std::nullopt;
+    }
+
+    /**
+     *  WorldNavMesh needs impassable tiles on the border of the mesh,
+     *  MovingAI maps do not always have them
+     */
+    [[nodiscard]] dgm::Mesh addBorder(const dgm::Mesh& mesh)
+    {
+        const auto size = mesh.getDataSize();
+        auto&& result = dgm::Mesh(
+            std::vector<int>((size.x + 2) * (size.y + 2), 1),
+            { size.x + 2, size.y + 2 },
+            mesh.getVoxelSize());
+        for (unsigned y = 0; y < size.y; ++y)
+        {
+            for (unsigned x = 0; x < size.x; ++x)
+                result[sf::Vector2u(x + 1, y + 1)] = mesh[sf::Vector2u(x, y)];
+        }
+        return result;
+    }
+
+    /**
+     *  Number of steps of the shortest 4-connected path, which is the
+     *  metric of TileNavMesh paths
+     */
+    [[nodiscard]] std::optional<double> getFourConnectedOptimum(
+        const dgm::Mesh& mesh, const sf::Vector2u& from, const sf::Vector2u& to)
+    {
+        // Mesh has impassable border, so neighbors are always inside
+        const auto width = mesh.getDataSize().x;
+        auto&& distances = std::vector<unsigned>(
+            std::size_t(width) * mesh.getDataSize().y, 0u);
+        auto&& frontier = std::queue<sf::Vector2u>();
+        frontier.push(from);
+        distances[from.y * width + from.x] = 1u;
+
+        while (!frontier.empty())
+        {
+            const auto tile = frontier.front();
+            frontier.pop();
+            const auto distance = distances[tile.y * width + tile.x];
+            if (tile == to) return static_cast<double>(distance - 1u);
+
+            for (auto&& neighbor :
+                 { sf::Vector2u(tile.x - 1, tile.y),
+                   sf::Vector2u(tile.x + 1, tile.y),
+                   sf::Vector2u(tile.x, tile.y - 1),
+                   sf::Vector2u(tile.x, tile.y + 1) })
+            {
+                auto& neighborDistance =
+                    distances[neighbor.y * width + neighbor.x];
+                if (neighborDistance > 0u || mesh[neighbor] > 0) continue;
+                neighborDistance = distance + 1u;
+                frontier.push(neighbor);
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    [[nodiscard]] sf::Vector2f toWorldCoord(const sf::Vector2u& tile)
+    {
+        return sf::Vector2f(tile) + sf::Vector2f(0.5f, 0.5f);
+    }
+
+    void benchmarkMap(
+        const dgm::Mesh& mesh,
+        const std::vector<dgm::MovingAiScenario>& scenarios,
+        Report& tileReport,
+        Report& worldReport)
+    {
+        const auto offset = sf::Vector2u(1u, 1u);
+        auto&& context = dgm::PathSearchContext(
+            mesh.getDataSize().x * mesh.getDataSize().y);
+
+        for (auto&& scenario : scenarios)
+        {
+            const auto from = scenario.from + offset;
+            const auto to = scenario.to + offset;
+
+            const auto start = Clock::now();
+            const auto path =
+                dgm::TileNavMesh::computePath(from, to, mesh, context);
+            const auto end = Clock::now();
+
+            tileReport.results.push_back(QueryResult {
+                .latency = end - start,
+                .length = path ? std::optional<double>(path->getLength())
+                               : std::nullopt,
+                .optimalLength = getFourConnectedOptimum(mesh, from, to),
+                .scenarioLength = scenario.optimalLength,
+            });
+        }
+
+        const auto buildStart = Clock::now();
+        const auto navmesh = dgm::WorldNavMesh(mesh.clone());
+        worldReport.buildTime += Clock::now() - buildStart;
+
+        for (auto&& scenario : scenarios)
+        {
+            const auto from = toWorldCoord(scenario.from + offset);
+            const auto to = toWorldCoord(scenario.to + offset);
+
+            const auto start = Clock::now();
+            auto path = navmesh.computePath(from, to, context);
+            const auto end = Clock::now();
+
+            // Empty path means failure unless start and goal are the same
+            auto&& length = std::optional<double>();
+            if (path.getLength() > 0 || scenario.from == scenario.to)
+            {
+                length = 0.0;
+                for (auto previous = from; !path.isTraversed(); path.advance())
+                {
+                    const auto current = path.getCurrentPoint().coord;
+                    *length += std::hypot(
+                        current.x - previous.x, current.y - previous.y);
+                    previous = current;
+                }
+            }
+
+            worldReport.results.push_back(QueryResult {
+                .latency = end - start,
+                .length = length,
+                .optimalLength = std::nullopt,
+                .scenarioLength = scenario.optimalLength,
+            });
+        }
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0]
+                  << " <file.scen> [map directory]\n";
+        return 1;
+    }
+
+    const auto scenarioPath = std::filesystem::path(argv[1]);
+    const auto mapDir =
+        argc > 2 ? std::filesystem::path(argv[2]) : scenarioPath.parent_path();
+
+    const auto scenarios = dgm::MovingAiLoader::loadScenarios(scenarioPath);
+    if (!scenarios)
+    {
+        std::cerr << scenarios.error().getMessage() << "\n";
+        return 1;
+    }
+
+    auto&& scenariosByMap =
+        std::map<std::string, std::vector<dgm::MovingAiScenario>>();
+    for (auto&& scenario : scenarios.value())
+        scenariosByMap[scenario.mapPath].push_back(scenario);
+
+    auto&& tileReport = Report { .name = "TileNavMesh::computePath" };
+    auto&& worldReport = Report { .name = "WorldNavMesh::computePath" };
+    for (auto&& [mapPath, mapScenarios] : scenariosByMap)
+    {
+        const auto resolvedPath = resolveMapPath(mapDir, mapPath);
+        if (!resolvedPath)
+        {
+            std::cerr << "Could not find map '" << mapPath << "' in '"
+                      << mapDir.string() << "'\n";
+            return 1;
+        }
+
+        const auto mesh =
+            dgm::MovingAiLoader::loadMap(*resolvedPath, { 1u, 1u });
+        if (!mesh)
+        {
+            std::cerr << mesh.error().getMessage() << "\n";
+            return 1;
+        }
+
+        std::cout << mapPath << ": " << mesh->getDataSize().x << "x"
+                  << mesh->getDataSize().y << ", " << mapScenarios.size()
+                  << " scenarios\n";
+        benchmarkMap(
+            addBorder(mesh.value()), mapScenarios, tileReport, worldReport);
+    }
+
+    std::cout << "\n";
+    printReport(tileReport);
+    printReport(worldReport);
+    return 0;
+}
@@ -40,6 +40,9 @@ int main()
         dgm::Window(WINDOW_SIZE_U, "Example: Particle Effects", false);
     dgm::Time time;
 
+    // Shared by all particle systems that simulate in chunks
+    auto&& workerPool = dgm::WorkerPool();
+
     // Images & configs
     auto&& resmgr = DemoData::loadDemoResources();
 
@@ -54,12 +57,13 @@ int main()
     }
 
     // Create actual effects
-    EffectWaterFountain effectFountain(
+    auto&& effectFountain = dgm::ps::ParticleEffectSystem(
         256_numparticles,
-        { boxes[0].getGlobalBounds().position.x
-              + boxes[0].getGlobalBounds().size.x / 2.f,
-          boxes[0].getGlobalBounds().position.y
-              + boxes[0].getGlobalBounds().size.y });
+        createWaterFountainEffect(
+            { boxes[0].getGlobalBounds().position.x
+                  + boxes[0].getGlobalBounds().size.x / 2.f,
+              boxes[0].getGlobalBounds().position.y
+                  + boxes[0].getGlobalBounds().size.y }));
 
     EffectBloodSpatter effectBloodSpatter(
         128_numparticles,
@@ -134,7 +138,7 @@ int main()
 
         soldierAnimation.update(time);
 
-        effectFountain.update(time);
+        effectFountain.update(time, workerPool);
         effectBloodSpatter.update(time);
         if (effectBloodSpatter.finished()) effectBloodSpatter.reset();
 
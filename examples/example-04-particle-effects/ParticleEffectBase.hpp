@@ -10,7 +10,7 @@ public:
     {
     }
 
-    float getRandomFloat(float min, float max)
+    static float getRandomFloat(float min, float max)
     {
         return min
                + static_cast<float>(rand())
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <DGM/classes/Objects.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dgm
+{
+
+    /**
+     * @brief Distance of every tile of a dgm::Mesh to the closest obstacle
+     *
+     * Clearance of a passable tile is the chessboard distance to the
+     * closest impassable tile or to the outside of the mesh, so an agent
+     * covering a square of (2 * radius + 1) tiles centered on the tile fits
+     * there if the clearance is greater than the radius. Impassable tiles
+     * have zero clearance.
+     *
+     * Values are capped at maxClearance, which bounds the area an edit of
+     * the mesh can affect. The clearance does not observe the mesh, call
+     * updateTile or updateRegion whenever tiles of the mesh change.
+     */
+    class [[nodiscard]] ClearanceMap final
+    {
+    public:
+        /**
+         * @param maxClearance At most 255, agents with radius up to
+         * maxClearance - 1 can be told apart
+         */
+        explicit ClearanceMap(
+            const dgm::Mesh& mesh,
+            unsigned maxClearance = DEFAULT_MAX_CLEARANCE);
+
+        ClearanceMap(ClearanceMap&&) = default;
+        ClearanceMap(const ClearanceMap&) = delete;
+
+    public:
+        /**
+         * @brief Refresh clearance after a tile in the mesh changed
+         *
+         * Only tiles closer than maxClearance to the tile are recomputed.
+         */
+        void updateTile(const dgm::Mesh& mesh, const sf::Vector2u& tile)
+        {
+            updateRegion(mesh, sf::Rect<unsigned>(tile, { 1u, 1u }));
+        }
+
+        /**
+         * @brief Refresh clearance after tiles within region changed
+         */
+        void
+        updateRegion(const dgm::Mesh& mesh, const sf::Rect<unsigned>& region);
+
+        [[nodiscard]] unsigned
+        getClearance(const sf::Vector2u& tile) const noexcept
+        {
+            return values[getIndex(tile)];
+        }
+
+        /**
+         * @brief Get clearance by index of the tile in the mesh data
+         */
+        [[nodiscard]] unsigned getClearance(std::size_t index) const noexcept
+        {
+            return values[index];
+        }
+
+        /**
+         * @brief Test whether an agent with given radius in tiles fits
+         * on tile, radius 0 is a single tile agent
+         */
+        [[nodiscard]] bool
+        canFit(const sf::Vector2u& tile, unsigned agentRadius) const noexcept
+        {
+            return getClearance(tile) > agentRadius;
+        }
+
+        [[nodiscard]] unsigned getMaxClearance() const noexcept
+        {
+            return maxClearance;
+        }
+
+        [[nodiscard]] const sf::Vector2u& getDataSize() const noexcept
+        {
+            return dataSize;
+        }
+
+    public:
+        static constexpr unsigned DEFAULT_MAX_CLEARANCE = 8;
+
+    private:
+        [[nodiscard]] std::size_t
+        getIndex(const sf::Vector2u& tile) const noexcept
+        {
+            return static_cast<std::size_t>(tile.y) * dataSize.x + tile.x;
+        }
+
+        /**
+         * @brief Recompute tiles within inclusive bounds, tiles around
+         * them must be up to date
+         */
+        void recompute(
+            const dgm::Mesh& mesh,
+            const sf::Vector2u& min,
+            const sf::Vector2u& max);
+
+    private:
+        sf::Vector2u dataSize;
+        unsigned maxClearance;
+        std::vector<std::uint8_t> values = {};
+    };
+
+} // namespace dgm
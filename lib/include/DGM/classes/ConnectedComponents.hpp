@@ -0,0 +1,123 @@
+#pragma once
+
+#include <DGM/classes/Objects.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace dgm
+{
+
+    /**
+     * @brief Labelling of connected areas of passable tiles of a dgm::Mesh
+     *
+     * Two passable tiles (value <= 0) share a component when they are
+     * connected through horizontally or vertically adjacent passable tiles.
+     * This matches reachability in dgm::TileNavMesh and dgm::WorldNavMesh,
+     * so queries between different components can be rejected in O(1)
+     * instead of exploring the whole reachable area first.
+     *
+     * The labelling does not observe the mesh. Whenever a tile of the mesh
+     * changes, call updateTile so the labelling stays in sync. Opening a tile
+     * relabels all but the largest of the components it joins. Closing a tile
+     * searches from its neighbors in lockstep, so only the parts that split
+     * off are visited, not the part that keeps the label.
+     */
+    class [[nodiscard]] ConnectedComponents final
+    {
+    public:
+        explicit ConnectedComponents(const dgm::Mesh& mesh);
+
+        ConnectedComponents(ConnectedComponents&&) = default;
+        ConnectedComponents(const ConnectedComponents&) = delete;
+
+    public:
+        /**
+         * @brief Refresh the labelling after a tile in the mesh changed
+         *
+         * Nothing happens unless the passability of the tile changed.
+         */
+        void updateTile(const dgm::Mesh& mesh, const sf::Vector2u& tile);
+
+        /**
+         * @brief Get label of the component a tile belongs to
+         *
+         * @return NO_COMPONENT for impassable tiles and tiles outside of
+         * the mesh
+         */
+        [[nodiscard]] unsigned
+        getComponent(const sf::Vector2u& tile) const noexcept
+        {
+            if (tile.x >= dataSize.x || tile.y >= dataSize.y)
+                return NO_COMPONENT;
+            return labels[getIndex(tile)];
+        }
+
+        /**
+         * @brief Test whether a path between two tiles can exist
+         *
+         * Always false if any of the tiles is impassable.
+         */
+        [[nodiscard]] bool areConnected(
+            const sf::Vector2u& a, const sf::Vector2u& b) const noexcept
+        {
+            const unsigned component = getComponent(a);
+            return component != NO_COMPONENT && component == getComponent(b);
+        }
+
+        /**
+         * @brief Get number of distinct components
+         */
+        [[nodiscard]] std::size_t getComponentCount() const noexcept
+        {
+            return componentSizes.size() - freeLabels.size();
+        }
+
+    public:
+        static constexpr unsigned NO_COMPONENT =
+            std::numeric_limits<unsigned>::max();
+
+    private:
+        [[nodiscard]] std::size_t
+        getIndex(const sf::Vector2u& tile) const noexcept
+        {
+            return static_cast<std::size_t>(tile.y) * dataSize.x + tile.x;
+        }
+
+        /**
+         * @brief Call callback for each passable neighbor of tile index
+         */
+        template<class Callback>
+        void forEachPassableNeighbor(unsigned index, Callback&& callback) const;
+
+        [[nodiscard]] unsigned createLabel();
+
+        void releaseLabel(unsigned label);
+
+        /**
+         * @brief Assign a new label to all tiles connected to start that
+         * currently have the label of start
+         */
+        void relabel(unsigned start, unsigned label);
+
+        void onTileOpened(unsigned index);
+
+        void onTileClosed(unsigned index);
+
+    private:
+        sf::Vector2u dataSize;
+        std::vector<unsigned> labels = {};
+        std::vector<unsigned> componentSizes = {};
+        std::vector<unsigned> freeLabels = {};
+
+        // Scratch memory of updates
+        std::vector<unsigned> queue = {};
+        std::array<std::vector<unsigned>, 4> splitQueues = {};
+        std::vector<std::uint32_t> visitStamps = {};
+        std::vector<std::uint8_t> visitOwners = {};
+        std::uint32_t stamp = 0;
+    };
+
+} // namespace dgm
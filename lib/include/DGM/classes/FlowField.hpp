@@ -0,0 +1,175 @@
+#pragma once
+
+#include <DGM/classes/Objects.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace dgm
+{
+
+    /**
+     *  \brief Shortest-path field over a dgm::Mesh towards one or more goals
+     *
+     *  Instead of searching a path for every agent, a single Dijkstra pass
+     *  expands from all goals at once and stores, for every tile, the distance
+     *  to the nearest goal (integration field) and the direction of the next
+     *  step on a shortest path towards it. Agents then look up their next step
+     *  in O(1), no matter how many of them share the goal.
+     *
+     *  Movement is 8-connected, straight steps cost 1 and diagonal steps cost
+     *  sqrt(2). Diagonal steps are only allowed when both adjacent straight
+     *  neighbors are passable, so agents never cut corners of solid tiles.
+     *  Tiles with value > 0 are impassable, same as for dgm::TileNavMesh.
+     *
+     *  Recompute the field whenever its goals or the mesh change, the memory
+     *  of the previous computation is reused.
+     */
+    class [[nodiscard]] FlowField final
+    {
+    public:
+        /**
+         *  \brief Compute the field towards a single goal tile
+         *
+         *  Results of any previous call are discarded.
+         */
+        void compute(const sf::Vector2u& goal, const dgm::Mesh& mesh)
+        {
+            compute(std::span(&goal, 1), mesh);
+        }
+
+        /**
+         *  \brief Compute the field towards the nearest of given goal tiles
+         *
+         *  Goals outside of the mesh or inside of impassable tiles are
+         *  ignored. Results of any previous call are discarded.
+         */
+        void
+        compute(std::span<const sf::Vector2u> goals, const dgm::Mesh& mesh);
+
+        /**
+         *  \brief Test whether any goal can be reached from given tile
+         */
+        [[nodiscard]] bool isReachable(const sf::Vector2u& tile) const noexcept
+        {
+            return isInside(tile)
+                   && distances[getIndex(tile)] != UNREACHABLE_DISTANCE;
+        }
+
+        /**
+         *  \brief Get length of the shortest path from tile to the nearest
+         *  goal, in tiles
+         *
+         *  \return UNREACHABLE_DISTANCE if no goal is reachable from the tile
+         */
+        [[nodiscard]] float getDistance(const sf::Vector2u& tile) const noexcept
+        {
+            return isInside(tile) ? distances[getIndex(tile)]
+                                  : UNREACHABLE_DISTANCE;
+        }
+
+        /**
+         *  \brief Get offset of the next tile on a shortest path to the
+         *  nearest goal
+         *
+         *  \return Zero vector for goals and for tiles from which no goal
+         *  can be reached
+         */
+        [[nodiscard]] sf::Vector2i
+        getDirection(const sf::Vector2u& tile) const noexcept
+        {
+            if (!isInside(tile)) return {};
+            const auto direction = directions[getIndex(tile)];
+            return direction == NO_DIRECTION ? sf::Vector2i {}
+                                             : OFFSETS[direction];
+        }
+
+        /**
+         *  \brief Get the tile an agent standing on given tile should move to
+         *
+         *  Returns the tile itself for goals and for tiles from which no goal
+         *  can be reached.
+         */
+        [[nodiscard]] sf::Vector2u
+        getNextTile(const sf::Vector2u& tile) const noexcept
+        {
+            const auto direction = getDirection(tile);
+            return sf::Vector2u(
+                static_cast<unsigned>(static_cast<int>(tile.x) + direction.x),
+                static_cast<unsigned>(static_cast<int>(tile.y) + direction.y));
+        }
+
+        /**
+         *  \brief Get unit vector pointing from position towards the center
+         *  of the next tile on a shortest path
+         *
+         *  Position is in world coordinates. Steering towards the center of
+         *  the next tile instead of following the raw tile direction keeps
+         *  agents from scraping along walls.
+         *
+         *  \return Zero vector when the position lies in a goal tile, in a
+         *  tile from which no goal can be reached or outside of the mesh
+         */
+        [[nodiscard]] sf::Vector2f
+        getFlowVector(const sf::Vector2f& position) const noexcept;
+
+        [[nodiscard]] constexpr const sf::Vector2u&
+        getDataSize() const noexcept
+        {
+            return dataSize;
+        }
+
+    public:
+        static constexpr float UNREACHABLE_DISTANCE =
+            std::numeric_limits<float>::infinity();
+
+    private:
+        struct [[nodiscard]] OpenSetEntry final
+        {
+            float distance;
+            unsigned index;
+
+            [[nodiscard]] constexpr bool
+            operator<(const OpenSetEntry& other) const noexcept
+            {
+                // Reversed so std::push_heap keeps the closest tile on top
+                if (distance != other.distance)
+                    return distance > other.distance;
+                return index > other.index;
+            }
+        };
+
+    private:
+        [[nodiscard]] constexpr bool
+        isInside(const sf::Vector2u& tile) const noexcept
+        {
+            return tile.x < dataSize.x && tile.y < dataSize.y;
+        }
+
+        [[nodiscard]] constexpr std::size_t
+        getIndex(const sf::Vector2u& tile) const noexcept
+        {
+            return static_cast<std::size_t>(tile.y) * dataSize.x + tile.x;
+        }
+
+    private:
+        static constexpr std::uint8_t NO_DIRECTION = 8;
+
+        // Straight directions first, diagonals second
+        static constexpr std::array<sf::Vector2i, 8> OFFSETS = {
+            sf::Vector2i(0, -1),  sf::Vector2i(1, 0),  sf::Vector2i(0, 1),
+            sf::Vector2i(-1, 0),  sf::Vector2i(1, -1), sf::Vector2i(1, 1),
+            sf::Vector2i(-1, 1),  sf::Vector2i(-1, -1),
+        };
+
+        sf::Vector2u dataSize = {};
+        sf::Vector2u voxelSize = {};
+        std::vector<float> distances = {};
+        std::vector<std::uint8_t> directions = {};
+        std::vector<OpenSetEntry> openSet = {};
+    };
+
+} // namespace dgm
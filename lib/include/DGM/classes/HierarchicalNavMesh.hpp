@@ -0,0 +1,183 @@
+#pragma once
+
+#include <DGM/classes/Objects.hpp>
+#include <DGM/classes/Path.hpp>
+#include <DGM/classes/PathSearchContext.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <optional>
+#include <vector>
+
+namespace dgm
+{
+    /**
+     *  \brief Hierarchical navmesh for long queries on large meshes (HPA*)
+     *
+     *  The mesh is split into square clusters. Wherever two neighboring
+     *  clusters share a passable border, entrance tiles are placed on both
+     *  sides of it. Entrances within one cluster are connected by the length
+     *  of the shortest path between them that stays inside the cluster.
+     *  Together with the steps across cluster borders, this forms a small
+     *  abstract graph.
+     *
+     *  A query links its start and goal to entrances of their clusters,
+     *  searches the abstract graph and then refines only those abstract
+     *  edges that the found path uses, each with a search bounded by a
+     *  single cluster. Cost of a query thus depends on the number of
+     *  clusters it crosses rather than the number of tiles.
+     *
+     *  Movement is 4-connected, same as in dgm::TileNavMesh. Resulting paths
+     *  are not always the shortest ones, since they have to pass through
+     *  entrances, but they are usually within a few percent of them.
+     *
+     *  Queries do not modify the object, so any number of threads can
+     *  compute paths on a single object at the same time.
+     */
+    class [[nodiscard]] HierarchicalNavMesh final
+    {
+    public:
+        /**
+         *  \param clusterSize Width and height of a cluster in tiles. Larger
+         *  clusters mean a smaller abstract graph, but more expensive
+         *  refinement.
+         */
+        explicit HierarchicalNavMesh(
+            dgm::Mesh mesh, unsigned clusterSize = 16u);
+        HierarchicalNavMesh(HierarchicalNavMesh&&) = default;
+        HierarchicalNavMesh(const HierarchicalNavMesh&) = delete;
+
+    public:
+        /**
+         *  \brief Get path represented by tile coordinates
+         *
+         *  Same conventions as dgm::TileNavMesh::computePath apply. The
+         *  resulting path will not include 'from' coord, but it includes
+         *  'to' coord. If no path exists, empty optional is returned. If
+         *  from == to, an empty path is returned.
+         */
+        [[nodiscard]] std::optional<dgm::Path<TileNavpoint>> computeTilePath(
+            const sf::Vector2u& from, const sf::Vector2u& to) const;
+
+        /**
+         *  \brief Same as computeTilePath without context, but all scratch
+         *  memory is taken from the context
+         *
+         *  Concurrent calls must each use a different context.
+         */
+        [[nodiscard]] std::optional<dgm::Path<TileNavpoint>> computeTilePath(
+            const sf::Vector2u& from,
+            const sf::Vector2u& to,
+            PathSearchContext& context) const;
+
+        /**
+         *  \brief Get path represented by world coordinates
+         *
+         *  Same conventions as dgm::WorldNavMesh::computePath apply. Points
+         *  are centers of tiles where the path turns, so there is no
+         *  obstacle between two subsequent points.
+         *
+         *  If no path exists, empty path is returned (isTraversed is true)
+         */
+        [[nodiscard]] dgm::Path<WorldNavpoint>
+        computePath(const sf::Vector2f& from, const sf::Vector2f& to) const;
+
+        [[nodiscard]] dgm::Path<WorldNavpoint> computePath(
+            const sf::Vector2f& from,
+            const sf::Vector2f& to,
+            PathSearchContext& context) const;
+
+        [[nodiscard]] unsigned getClusterSize() const noexcept
+        {
+            return clusterSize;
+        }
+
+        /**
+         *  \brief Get number of nodes of the abstract graph
+         */
+        [[nodiscard]] std::size_t getEntranceCount() const noexcept
+        {
+            return entrances.size();
+        }
+
+        [[nodiscard]] const dgm::Mesh& getMesh() const noexcept
+        {
+            return mesh;
+        }
+
+    private:
+        struct [[nodiscard]] Edge final
+        {
+            unsigned destination; ///< Id of the destination entrance
+            unsigned distance;    ///< Length of the path in tiles
+        };
+
+        struct [[nodiscard]] ClusterBounds final
+        {
+            sf::Vector2u position;
+            sf::Vector2u size;
+        };
+
+    private:
+        void discoverEntrances();
+
+        void addTransition(const sf::Vector2u& a, const sf::Vector2u& b);
+
+        [[nodiscard]] unsigned getOrAddEntrance(const sf::Vector2u& tile);
+
+        void connectEntrancesWithinClusters();
+
+        /**
+         *  \brief Search a path between two tiles of the same cluster,
+         *  not leaving the cluster
+         *
+         *  If goal is not set, the search explores the whole reachable part
+         *  of the cluster so distances to all tiles can be read from the
+         *  search space afterwards.
+         */
+        [[nodiscard]] bool searchWithinCluster(
+            priv::AstarSearchSpace& space,
+            const sf::Vector2u& from,
+            std::optional<sf::Vector2u> goal) const;
+
+        /**
+         *  \brief Collect entrances of the cluster of given tile reachable
+         *  from it within the cluster
+         */
+        void linkToClusterEntrances(
+            const sf::Vector2u& tile,
+            priv::AstarSearchSpace& space,
+            std::vector<PathSearchContext::Link>& links) const;
+
+        /**
+         *  \brief Append path between two tiles of the same cluster to
+         *  context.tilePoints, excluding 'from'
+         */
+        [[nodiscard]] bool appendClusterPath(
+            const sf::Vector2u& from,
+            const sf::Vector2u& to,
+            PathSearchContext& context) const;
+
+        [[nodiscard]] unsigned
+        getClusterIndex(const sf::Vector2u& tile) const noexcept
+        {
+            return (tile.y / clusterSize) * clusterCount.x
+                   + tile.x / clusterSize;
+        }
+
+        [[nodiscard]] ClusterBounds
+        getClusterBounds(const sf::Vector2u& tile) const noexcept;
+
+    private:
+        dgm::Mesh mesh;
+        unsigned clusterSize;
+        sf::Vector2u clusterCount;
+
+        /// Tile coordinate of each node of the abstract graph
+        std::vector<sf::Vector2u> entrances = {};
+
+        /// Outgoing edges of each node of the abstract graph
+        std::vector<std::vector<Edge>> edges = {};
+
+        /// Ids of entrances that lie in each cluster
+        std::vector<std::vector<unsigned>> clusterEntrances = {};
+    };
+} // namespace dgm
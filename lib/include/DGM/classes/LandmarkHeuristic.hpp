@@ -0,0 +1,146 @@
+#pragma once
+
+#include <DGM/classes/Objects.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace dgm
+{
+    namespace priv
+    {
+        /**
+         *  Shortest distances from a few landmark nodes to every node of
+         *  a graph with symmetric edges
+         *
+         *  Distances are stored node by node, so the bound for a pair of
+         *  nodes reads two short contiguous rows.
+         */
+        class [[nodiscard]] LandmarkDistances final
+        {
+        public:
+            LandmarkDistances() = default;
+
+            LandmarkDistances(
+                std::vector<unsigned> landmarks,
+                std::vector<unsigned> distances)
+                : landmarks(std::move(landmarks))
+                , distances(std::move(distances))
+            {
+            }
+
+        public:
+            [[nodiscard]] bool isEmpty() const noexcept
+            {
+                return landmarks.empty();
+            }
+
+            [[nodiscard]] std::span<const unsigned>
+            getLandmarks() const noexcept
+            {
+                return landmarks;
+            }
+
+            /**
+             *  Distances from all landmarks to node, UNREACHABLE where
+             *  there is no path
+             */
+            [[nodiscard]] std::span<const unsigned>
+            getDistances(unsigned node) const noexcept
+            {
+                return std::span(distances)
+                    .subspan(
+                        static_cast<std::size_t>(node) * landmarks.size(),
+                        landmarks.size());
+            }
+
+            /**
+             *  Largest triangle inequality bound of the distance between
+             *  two nodes, given their rows of getDistances
+             *
+             *  Landmarks that do not reach both nodes are skipped.
+             */
+            [[nodiscard]] static unsigned getLowerBound(
+                std::span<const unsigned> a,
+                std::span<const unsigned> b) noexcept
+            {
+                unsigned bound = 0;
+                for (std::size_t i = 0; i < a.size(); ++i)
+                {
+                    if (a[i] == UNREACHABLE || b[i] == UNREACHABLE) continue;
+                    const unsigned difference =
+                        a[i] < b[i] ? b[i] - a[i] : a[i] - b[i];
+                    if (bound < difference) bound = difference;
+                }
+                return bound;
+            }
+
+        public:
+            static constexpr unsigned UNREACHABLE =
+                std::numeric_limits<unsigned>::max();
+
+        private:
+            std::vector<unsigned> landmarks = {};
+            std::vector<unsigned> distances = {};
+        };
+    } // namespace priv
+
+    /**
+     *  \brief Precomputed landmark (ALT) heuristic of dgm::TileNavMesh
+     *
+     *  Distances from a few landmark tiles to every tile of the mesh are
+     *  computed up front. By the triangle inequality, the distance between
+     *  two tiles is at least the difference of their distances to any
+     *  landmark. On maze-like maps, this bound is far tighter than the
+     *  manhattan distance, so the search explores a fraction of the tiles.
+     *
+     *  Landmarks are spread over the largest connected area by farthest
+     *  point sampling. Queries in other areas fall back to the manhattan
+     *  distance.
+     *
+     *  Memory cost is one unsigned per tile and landmark. The heuristic
+     *  does not observe the mesh, construct a new one after passability
+     *  of tiles changes. A stale one still finds paths, but not
+     *  necessarily the shortest ones.
+     */
+    class [[nodiscard]] LandmarkHeuristic final
+    {
+    public:
+        explicit LandmarkHeuristic(
+            const dgm::Mesh& mesh,
+            unsigned landmarkCount = DEFAULT_LANDMARK_COUNT);
+
+        LandmarkHeuristic(LandmarkHeuristic&&) = default;
+        LandmarkHeuristic(const LandmarkHeuristic&) = delete;
+
+    public:
+        /**
+         *  \brief Get lower bound of the length of the path between two
+         *  passable tiles found by dgm::TileNavMesh
+         *
+         *  The bound is never smaller than the manhattan distance.
+         */
+        [[nodiscard]] unsigned getLowerBound(
+            const sf::Vector2u& from, const sf::Vector2u& to) const noexcept;
+
+        /**
+         *  \brief Get tiles picked as landmarks
+         */
+        [[nodiscard]] std::vector<sf::Vector2u> getLandmarks() const;
+
+        [[nodiscard]] const sf::Vector2u& getDataSize() const noexcept
+        {
+            return dataSize;
+        }
+
+    public:
+        static constexpr unsigned DEFAULT_LANDMARK_COUNT = 8;
+
+    private:
+        sf::Vector2u dataSize;
+        priv::LandmarkDistances distances;
+    };
+
+} // namespace dgm
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <DGM/classes/Objects.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace dgm
+{
+
+    /**
+     * @brief Memoizing wrapper around dgm::Raycaster::hasDirectVisibility
+     * for tile-to-tile line of sight checks.
+     *
+     * Visibility between centers of two tiles is computed once and then
+     * served from the cache until a tile that the result depends on changes.
+     *
+     * The cache takes ownership of the mesh so all writes go through setTile
+     * and can be tracked. The mesh is split into square regions. Every cached
+     * result is registered with each region its ray passed through, and when
+     * a tile changes its solidity, only the results registered with the
+     * region of that tile are discarded.
+     *
+     * Pairs are ordered, (A, B) and (B, A) are cached separately so the
+     * results are always identical to what dgm::Raycaster would return.
+     *
+     * @warn This class is not thread-safe, even queries modify the cache.
+     */
+    class [[nodiscard]] LineOfSightCache final
+    {
+    public:
+        /**
+         * @param[in] mesh        Level mesh. Tiles with value > 0 are solid.
+         * @param[in] regionSize  Width and height of a single invalidation
+         *                        region in tiles.
+         */
+        explicit LineOfSightCache(dgm::Mesh mesh, unsigned regionSize = 16u);
+
+        LineOfSightCache(LineOfSightCache&&) = default;
+        LineOfSightCache(const LineOfSightCache&) = delete;
+
+    public:
+        /**
+         * @brief Test whether there is a direct line of sight between centers
+         * of two tiles.
+         *
+         * Both tiles must lie within the mesh.
+         */
+        [[nodiscard]] bool hasDirectVisibility(
+            const sf::Vector2u& fromTile, const sf::Vector2u& toTile);
+
+        /**
+         * @brief Change value of a tile in the owned mesh
+         *
+         * If the solidity of the tile changes, every cached result that
+         * depends on the region of the tile is discarded.
+         */
+        void setTile(const sf::Vector2u& tile, int value);
+
+        [[nodiscard]] const dgm::Mesh& getMesh() const noexcept
+        {
+            return mesh;
+        }
+
+        /**
+         * @brief Get number of currently cached tile pairs
+         */
+        [[nodiscard]] std::size_t getCachedPairCount() const noexcept
+        {
+            return cache.size();
+        }
+
+        /**
+         * @brief Get number of registrations of cached pairs with regions
+         *
+         * Every cached pair is registered once with each region its ray
+         * passed through.
+         */
+        [[nodiscard]] std::size_t getDependencyCount() const noexcept;
+
+        /**
+         * @brief Drop all cached results
+         */
+        void clear();
+
+    private:
+        [[nodiscard]] std::size_t
+        getRegionIndex(const sf::Vector2u& tile) const noexcept
+        {
+            return (tile.y / regionSize) * regionCountX + tile.x / regionSize;
+        }
+
+        [[nodiscard]] std::uint64_t
+        getTileIndex(const sf::Vector2u& tile) const noexcept
+        {
+            return static_cast<std::uint64_t>(tile.y) * mesh.getDataSize().x
+                   + tile.x;
+        }
+
+    private:
+        dgm::Mesh mesh;
+        unsigned regionSize;
+        unsigned regionCountX;
+        struct [[nodiscard]] CachedResult final
+        {
+            bool visible;
+            std::vector<std::size_t> regions; ///< Sorted, without duplicates
+        };
+
+        std::unordered_map<std::uint64_t, CachedResult> cache = {};
+
+        /**
+         * For each region, cache keys that depend on it. A discarded result
+         * is removed from all of its regions, so the sets never hold more
+         * keys than the cache.
+         */
+        std::vector<std::unordered_set<std::uint64_t>> regionDependants = {};
+        std::vector<std::size_t> traversedRegions = {};
+    };
+
+} // namespace dgm
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <DGM/classes/Error.hpp>
+#include <DGM/classes/Objects.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <expected>
+#include <filesystem>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace dgm
+{
+    /**
+     *  \brief Single query of a MovingAI benchmark scenario file
+     */
+    struct [[nodiscard]] MovingAiScenario final
+    {
+        unsigned bucket = 0;
+
+        /// Path to the map as written in the scenario file
+        std::string mapPath = {};
+
+        sf::Vector2u mapSize = {};
+        sf::Vector2u from = {};
+        sf::Vector2u to = {};
+
+        /// Length of the shortest 8-connected path, diagonal steps cost
+        /// sqrt(2) and corners cannot be cut
+        double optimalLength = 0.0;
+    };
+
+    /**
+     *  \brief Loader of the MovingAI pathfinding benchmark formats
+     *
+     *  Maps (.map) are grids of characters. Tiles '.', 'G' and 'S' are
+     *  passable and become 0 in the resulting mesh, everything else ('@',
+     *  'O', 'T', 'W') is impassable and becomes 1.
+     *
+     *  Scenario files (.scen) list queries on maps, version 1 of the format
+     *  is supported.
+     *
+     *  See https://movingai.com/benchmarks/formats.html
+     */
+    class [[nodiscard]] MovingAiLoader final
+    {
+    public:
+        [[nodiscard]] static std::expected<dgm::Mesh, dgm::Error> loadMap(
+            const std::filesystem::path& path, const sf::Vector2u& voxelSize);
+
+        [[nodiscard]] static std::expected<dgm::Mesh, dgm::Error>
+        loadMap(std::istream& stream, const sf::Vector2u& voxelSize);
+
+        [[nodiscard]] static std::expected<
+            std::vector<MovingAiScenario>,
+            dgm::Error>
+        loadScenarios(const std::filesystem::path& path);
+
+        [[nodiscard]] static std::expected<
+            std::vector<MovingAiScenario>,
+            dgm::Error>
+        loadScenarios(std::istream& stream);
+    };
+} // namespace dgm
@@ -1,8 +1,24 @@
+#include <DGM/classes/ClearanceMap.hpp>
+#include <DGM/classes/ConnectedComponents.hpp>
+#include <DGM/classes/Error.hpp>
+#include <DGM/classes/LandmarkHeuristic.hpp>
 #include <DGM/classes/Objects.hpp>
 #include <DGM/classes/Path.hpp>
+#include <DGM/classes/PathRequest.hpp>
+#include <DGM/classes/PathSearchContext.hpp>
 #include <DGM/classes/Utility.hpp>
+#include <DGM/classes/WorkerPool.hpp>
+#include <SFML/Graphics/Rect.hpp>
 #include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <limits>
+#include <optional>
+#include <span>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 namespace std
 {
@@ -61,6 +77,221 @@ namespace dgm
             const sf::Vector2u& from,
             const sf::Vector2u& to,
             const dgm::Mesh& mesh);
+
+        /**
+         *  \brief Same as computePath without context, but all scratch
+         *  memory is taken from the context
+         *
+         *  Reusing the context makes subsequent queries allocation-free,
+         *  with the exception of the returned path.
+         */
+        [[nodiscard]] static std::optional<dgm::Path<TileNavpoint>>
+        computePath(
+            const sf::Vector2u& from,
+            const sf::Vector2u& to,
+            const dgm::Mesh& mesh,
+            PathSearchContext& context);
+
+        /**
+         *  \brief Same as computePath, but queries between tiles that are
+         *  not connected are rejected without any search
+         *
+         *  Components must be in sync with the mesh.
+         */
+        [[nodiscard]] static std::optional<dgm::Path<TileNavpoint>>
+        computePath(
+            const sf::Vector2u& from,
+            const sf::Vector2u& to,
+            const dgm::Mesh& mesh,
+            const ConnectedComponents& components);
+
+        [[nodiscard]] static std::optional<dgm::Path<TileNavpoint>>
+        computePath(
+            const sf::Vector2u& from,
+            const sf::Vector2u& to,
+            const dgm::Mesh& mesh,
+            const ConnectedComponents& components,
+            PathSearchContext& context);
+
+        /**
+         *  \brief Same as computePath, but the search is guided by
+         *  a landmark heuristic, so far fewer tiles are explored on maps
+         *  with long detours
+         *
+         *  Landmarks must be computed from the same mesh. The path has the
+         *  same length as without them, but it may be a different one.
+         */
+        [[nodiscard]] static std::optional<dgm::Path<TileNavpoint>>
+        computePath(
+            const sf::Vector2u& from,
+            const sf::Vector2u& to,
+            const dgm::Mesh& mesh,
+            const LandmarkHeuristic& landmarks);
+
+        [[nodiscard]] static std::optional<dgm::Path<TileNavpoint>>
+        computePath(
+            const sf::Vector2u& from,
+            const sf::Vector2u& to,
+            const dgm::Mesh& mesh,
+            const LandmarkHeuristic& landmarks,
+            PathSearchContext& context);
+
+        /**
+         *  \brief Same as computePath, but only tiles where an agent with
+         *  given radius fits are used
+         *
+         *  The agent covers a square of (2 * agentRadius + 1) tiles
+         *  centered on its tile. Clearance must be in sync with the mesh
+         *  and its maxClearance must be greater than agentRadius. If the
+         *  agent does not fit on the start, no path is returned.
+         */
+        [[nodiscard]] static std::optional<dgm::Path<TileNavpoint>>
+        computePath(
+            const sf::Vector2u& from,
+            const sf::Vector2u& to,
+            const dgm::Mesh& mesh,
+            const ClearanceMap& clearance,
+            unsigned agentRadius);
+
+        [[nodiscard]] static std::optional<dgm::Path<TileNavpoint>>
+        computePath(
+            const sf::Vector2u& from,
+            const sf::Vector2u& to,
+            const dgm::Mesh& mesh,
+            const ClearanceMap& clearance,
+            unsigned agentRadius,
+            PathSearchContext& context);
+
+        /**
+         *  \brief Get path represented by tile indices using Jump Point
+         *  Search
+         *
+         *  Finds a path of the same length as computePath, but symmetric
+         *  paths are pruned, so far fewer tiles are explored on open maps.
+         *  No preprocessing is needed, the mesh can change between calls.
+         *
+         *  \param expandToTiles When true, the path lists every tile like
+         *  the one from computePath does. Otherwise, it only contains the
+         *  jump points (tiles where the path may change direction) and the
+         *  destination. Consecutive points always share a row or a column.
+         *
+         *  Edge cases are handled the same way as in computePath.
+         */
+        [[nodiscard]] static std::optional<dgm::Path<TileNavpoint>>
+        computeJumpPointPath(
+            const sf::Vector2u& from,
+            const sf::Vector2u& to,
+            const dgm::Mesh& mesh,
+            bool expandToTiles = true);
+
+        [[nodiscard]] static std::optional<dgm::Path<TileNavpoint>>
+        computeJumpPointPath(
+            const sf::Vector2u& from,
+            const sf::Vector2u& to,
+            const dgm::Mesh& mesh,
+            PathSearchContext& context,
+            bool expandToTiles = true);
+
+        /**
+         *  \brief Create a request for the same path as computePath returns,
+         *  which can be computed in steps or on a worker thread
+         *
+         *  Mesh must outlive the request and must not change until the
+         *  request is done.
+         */
+        [[nodiscard]] static PathRequest<TileNavpoint> requestPath(
+            const sf::Vector2u& from,
+            const sf::Vector2u& to,
+            const dgm::Mesh& mesh);
+
+        /**
+         *  \brief Same as requestPath, but a request between tiles that are
+         *  not connected ends immediately
+         *
+         *  Components are only used when the request is created.
+         */
+        [[nodiscard]] static PathRequest<TileNavpoint> requestPath(
+            const sf::Vector2u& from,
+            const sf::Vector2u& to,
+            const dgm::Mesh& mesh,
+            const ConnectedComponents& components);
+
+#ifdef PATHFINDING_STATS
+        /**
+         *  \brief Get totals of all queries of TileNavMesh since start of
+         *  the program or the last reset
+         *
+         *  Totals are shared by all threads.
+         */
+        [[nodiscard]] static PathSearchTotals getSearchTotals() noexcept
+        {
+            return searchTotals.get();
+        }
+
+        static void resetSearchTotals() noexcept
+        {
+            searchTotals.reset();
+        }
+#endif
+
+    private:
+        class RequestTask;
+
+        /**
+         *  \brief Optional inputs of a search, plain manhattan search over
+         *  passable tiles by default
+         */
+        struct [[nodiscard]] SearchOptions final
+        {
+            const LandmarkHeuristic* landmarks = nullptr;
+            const ClearanceMap* clearance = nullptr;
+            unsigned agentRadius = 0;
+
+            [[nodiscard]] unsigned getHeuristic(
+                const sf::Vector2u& point,
+                const sf::Vector2u& to) const noexcept;
+
+            [[nodiscard]] bool
+            isOpen(const dgm::Mesh& mesh, unsigned index) const noexcept;
+        };
+
+        static inline priv::PathSearchTotalsCounter searchTotals;
+
+        [[nodiscard]] static std::optional<dgm::Path<TileNavpoint>>
+        searchJumpPointPath(
+            const sf::Vector2u& from,
+            const sf::Vector2u& to,
+            const dgm::Mesh& mesh,
+            PathSearchContext& context,
+            bool expandToTiles);
+
+        [[nodiscard]] static std::optional<dgm::Path<TileNavpoint>>
+        searchPath(
+            const sf::Vector2u& from,
+            const sf::Vector2u& to,
+            const dgm::Mesh& mesh,
+            const SearchOptions& options,
+            PathSearchContext& context);
+
+        static void beginSearch(
+            const sf::Vector2u& from,
+            const sf::Vector2u& to,
+            const dgm::Mesh& mesh,
+            const SearchOptions& options,
+            PathSearchContext& context);
+
+        [[nodiscard]] static PathRequestStatus expandSearch(
+            const sf::Vector2u& to,
+            const dgm::Mesh& mesh,
+            const SearchOptions& options,
+            PathSearchContext& context,
+            std::size_t maxExpansions);
+
+        [[nodiscard]] static dgm::Path<TileNavpoint> buildPath(
+            const sf::Vector2u& from,
+            const sf::Vector2u& to,
+            const dgm::Mesh& mesh,
+            PathSearchContext& context);
     };
 
     /**
@@ -100,14 +331,66 @@ namespace dgm
      * [1, 2, E]. Point 3 would be ignored in this case.
      *
      *  This class makes a copy of source mesh because it needs to do some
-     * pre-processing before it can do pathfinding. As long as your mesh data
-     * don't change, you can reuse object of this class.
+     * pre-processing before it can do pathfinding. When the mesh data
+     * change, use setTile or updateRegion so only the affected part of the
+     * pre-processed data is recomputed.
+     *
+     *  Pre-processing includes labelling of connected areas, so queries
+     * between tiles that are not connected are rejected without any search.
+     *
+     *  The jump point graph is not modified by path queries, so any number
+     * of threads can compute paths on a single object at the same time.
      */
     class [[nodiscard]] WorldNavMesh
     {
+    public:
+        struct [[nodiscard]] PathQuery final
+        {
+            sf::Vector2f from;
+            sf::Vector2f to;
+            unsigned agentRadius = 0;
+        };
+
+        struct [[nodiscard]] BuildSettings final
+        {
+            /// Largest radius in tiles of agents the graph can serve,
+            /// at most 254
+            unsigned maxAgentRadius = 0;
+
+            /// Maximum number of worker threads used for the build
+            unsigned threadCount = std::thread::hardware_concurrency();
+        };
+
     public:
         WorldNavMesh() = delete;
-        explicit WorldNavMesh(dgm::Mesh mesh);
+
+        /**
+         *  \brief Build the jump point graph of the mesh
+         *
+         *  Jump points and their connections are discovered in parallel.
+         *  The resulting graph does not depend on the number of threads.
+         *
+         *  \param threadCount Maximum number of worker threads. With one
+         *  thread, everything runs on the calling thread.
+         */
+        explicit WorldNavMesh(
+            dgm::Mesh mesh,
+            unsigned threadCount = std::thread::hardware_concurrency());
+
+        /**
+         *  \brief Build the jump point graph serving agents of several
+         *  sizes
+         *
+         *  An agent with radius r covers a square of (2r + 1) tiles around
+         *  its tile. The graph is a union of the graphs of the mesh with
+         *  walls grown by every radius up to maxAgentRadius. Each
+         *  connection remembers the narrowest spot it passes through, so
+         *  a query skips connections its agent does not fit into.
+         *
+         *  With maxAgentRadius 0, the graph is the same as the one built
+         *  by the other constructor.
+         */
+        WorldNavMesh(dgm::Mesh mesh, const BuildSettings& settings);
         WorldNavMesh(WorldNavMesh&& other) = default;
         WorldNavMesh(const WorldNavMesh& other) = delete;
 
@@ -120,60 +403,350 @@ namespace dgm
          *
          *  If no path exists, empty path is returned (isTraversed is true)
          *
-         *  \warn This function is not thread-safe.
+         *  \param agentRadius Radius of the agent in tiles, at most
+         *  the maxAgentRadius the navmesh was built with. Every tile of
+         *  the path keeps the agent clear of walls.
          */
-        [[nodiscard]] dgm::Path<WorldNavpoint>
-        computePath(const sf::Vector2f& from, const sf::Vector2f& to);
+        [[nodiscard]] dgm::Path<WorldNavpoint> computePath(
+            const sf::Vector2f& from,
+            const sf::Vector2f& to,
+            unsigned agentRadius = 0) const;
+
+        /**
+         *  \brief Same as computePath without context, but all scratch
+         *  memory is taken from the context
+         *
+         *  Reusing the context makes subsequent queries allocation-free,
+         *  with the exception of the returned path.
+         *
+         *  Concurrent calls must each use a different context.
+         */
+        [[nodiscard]] dgm::Path<WorldNavpoint> computePath(
+            const sf::Vector2f& from,
+            const sf::Vector2f& to,
+            PathSearchContext& context,
+            unsigned agentRadius = 0) const;
+
+        /**
+         *  \brief Compute paths for a batch of queries in parallel
+         *
+         *  Queries are distributed among threads of the pool, each with its
+         *  own PathSearchContext. Results are in the same order as queries
+         *  and identical to calling computePath for each of them.
+         *
+         *  Threads of the pool are kept alive between calls, so batches
+         *  can be computed every frame.
+         */
+        [[nodiscard]] std::vector<dgm::Path<WorldNavpoint>> computePaths(
+            std::span<const PathQuery> queries, dgm::WorkerPool& pool) const;
+
+        /**
+         *  \brief Create a request for the same path as computePath returns,
+         *  which can be computed in steps or on a worker thread
+         *
+         *  Navmesh must outlive the request and must not be modified until
+         *  the request is done. Linking start and goal to the jump point
+         *  network happens in the first step and is not limited by the
+         *  number of expansions.
+         */
+        [[nodiscard]] PathRequest<WorldNavpoint> requestPath(
+            const sf::Vector2f& from,
+            const sf::Vector2f& to,
+            unsigned agentRadius = 0) const;
+
+#ifdef PATHFINDING_STATS
+        /**
+         *  \brief Get totals of all queries of this navmesh since its
+         *  construction or the last reset
+         */
+        [[nodiscard]] PathSearchTotals getSearchTotals() const noexcept
+        {
+            return searchTotals.get();
+        }
+
+        void resetSearchTotals() noexcept
+        {
+            searchTotals.reset();
+        }
+#endif
+
+        /**
+         *  \brief Change a single tile of the mesh and repair the jump point
+         *  graph around it
+         *
+         *  Nothing is recomputed unless the passability of the tile changes.
+         *  Tiles on the border of the mesh must stay impassable.
+         */
+        void setTile(const sf::Vector2u& tile, int value);
+
+        /**
+         *  \brief Copy a rectangular region of tiles from source mesh and
+         *  repair the jump point graph
+         *
+         *  Source must have the same dimensions as the mesh this object was
+         *  constructed from. Prefer this over calling setTile for each tile
+         *  of a larger change, the graph is only repaired once.
+         *
+         *  Only jump points around tiles whose passability changed are
+         *  re-evaluated and only jump points whose connection discovery
+         *  could have passed through the change have their connections
+         *  recomputed. The rest of the graph is left untouched.
+         */
+        void updateRegion(
+            const dgm::Mesh& source, const sf::Rect<unsigned>& region);
+
+        [[nodiscard]] const dgm::Mesh& getMesh() const noexcept
+        {
+            return mesh;
+        }
+
+        /**
+         *  \brief Get clearance of tiles, kept up to date with the mesh
+         */
+        [[nodiscard]] const ClearanceMap& getClearanceMap() const noexcept
+        {
+            return clearance;
+        }
+
+        [[nodiscard]] unsigned getMaxAgentRadius() const noexcept
+        {
+            return clearance.getMaxClearance() - 1;
+        }
+
+        /**
+         *  \brief Precompute landmark (ALT) heuristic of the jump point
+         *  graph used by all subsequent queries
+         *
+         *  Distances from a few landmark jump points to all others are
+         *  computed, so the search can bound remaining distance by the
+         *  triangle inequality instead of the straight line distance. On
+         *  maps with long detours, this cuts expanded nodes several times.
+         *
+         *  Memory cost is one unsigned per jump point and landmark. The
+         *  landmarks are computed again whenever setTile or updateRegion
+         *  change the graph, which costs a full search of the graph per
+         *  landmark. Landmarks are not stored by saveGraph.
+         *
+         *  \param landmarkCount Zero turns the landmarks off
+         */
+        void buildLandmarks(
+            unsigned landmarkCount = LandmarkHeuristic::DEFAULT_LANDMARK_COUNT);
+
+        /**
+         *  \brief Store the pre-processed jump point graph in a binary blob
+         *
+         *  The blob starts with a format version and a hash of the mesh,
+         *  including its voxel size, so it can only be loaded together
+         *  with the mesh it was saved from.
+         *  The mesh itself is not stored. Numbers are stored in the byte
+         *  order of the saving machine.
+         */
+        [[nodiscard]] std::vector<std::byte> saveGraph() const;
+
+        /**
+         *  \brief Construct navmesh from a mesh and a graph created by
+         *  saveGraph without running the jump point discovery
+         *
+         *  Arrays of the graph are copied from the blob as they are, so it
+         *  can be passed straight from a memory-mapped file.
+         *
+         *  Returns error if the blob is malformed, has a different format
+         *  version or was saved for a different mesh.
+         */
+        [[nodiscard]] static std::expected<WorldNavMesh, dgm::Error>
+        loadGraph(dgm::Mesh mesh, std::span<const std::byte> graph);
+
+    public:
+        static constexpr std::uint32_t GRAPH_FORMAT_VERSION = 2;
 
     protected:
         struct [[nodiscard]] Connection final
         {
-            sf::Vector2u destination; ///< Destination node of the connection
-            unsigned distance;        ///< Distance to destination
+            unsigned destination; ///< Id of the destination jump point
+            unsigned distance;    ///< Distance to destination
+            unsigned clearance;   ///< Smallest clearance on the way
+        };
+
+        struct [[nodiscard]] TileBounds final
+        {
+            sf::Vector2u min;
+            sf::Vector2u max;
         };
 
     protected:
+        static constexpr unsigned NO_JUMP_POINT =
+            std::numeric_limits<unsigned>::max();
+
         dgm::Mesh mesh;
+        ConnectedComponents components;
+        ClearanceMap clearance;
 
         /**
-         *  \brief Map of connections between jump points
+         *  \brief Jump point graph in compressed sparse row format
          *
-         *  Map is indexed by jump point coordinates and each jump point lists
-         * set of jump points it is connected to, alonside with distance to each
-         * of them.
+         *  Jump points are numbered densely in row-major order of their
+         *  tiles. Connections of jump point with id i are stored in
+         *  connections between indices connectionOffsets[i] and
+         *  connectionOffsets[i + 1], so a search only indexes flat arrays.
          *
          *  Jump points are only relevant for computation of WorldNavpoints
          */
-        std::unordered_map<sf::Vector2u, std::vector<Connection>>
-            jumpPointConnections = {};
+        std::vector<sf::Vector2u> jumpPoints = {};
+        std::vector<unsigned> connectionOffsets = {};
+        std::vector<Connection> connections = {};
+
+        /// Id of the jump point at each tile or NO_JUMP_POINT
+        std::vector<unsigned> jumpPointIds = {};
+
+        /**
+         *  \brief Tiles read while discovering connections of each jump point
+         *
+         *  Bounds are inclusive. If no tile within them changes, neither do
+         *  the connections.
+         */
+        std::vector<TileBounds> jumpPointScanBounds = {};
+
+        /// Number of landmarks requested by buildLandmarks
+        unsigned landmarkCount = 0;
+
+        /// Distances from landmarks to jump points, indexed by jump point ids
+        priv::LandmarkDistances landmarks;
+
+        /// Queries do not modify the navmesh, but they are counted
+        mutable priv::PathSearchTotalsCounter searchTotals;
 
     protected:
-        [[nodiscard]] bool isJumpPoint(const sf::Vector2u& p) const
+        struct [[nodiscard]] PrebuiltGraphTag final
         {
-            return jumpPointConnections.contains(p);
+        };
+
+        /**
+         *  \brief Tiles of a query and their node ids in the search
+         *
+         *  Start and goal that are not jump points get ids right after
+         *  the jump points.
+         */
+        struct [[nodiscard]] SearchQuery final
+        {
+            sf::Vector2u from;
+            sf::Vector2u to;
+            unsigned fromId;
+            unsigned goalId;
+            unsigned agentRadius;
+        };
+
+        class RequestTask;
+
+        /**
+         *  \brief Construct navmesh with an empty graph that is filled
+         *  by the caller
+         */
+        WorldNavMesh(
+            dgm::Mesh mesh, unsigned maxAgentRadius, PrebuiltGraphTag);
+
+        [[nodiscard]] unsigned
+        getJumpPointId(const sf::Vector2u& p) const noexcept
+        {
+            return jumpPointIds[p.y * mesh.getDataSize().x + p.x];
         }
 
+        [[nodiscard]] bool isJumpPoint(const sf::Vector2u& p) const noexcept
+        {
+            return getJumpPointId(p) != NO_JUMP_POINT;
+        }
+
+        [[nodiscard]] std::span<const Connection>
+        getConnections(unsigned id) const noexcept
+        {
+            return std::span(connections)
+                .subspan(
+                    connectionOffsets[id],
+                    connectionOffsets[id + 1] - connectionOffsets[id]);
+        }
+
+        /**
+         *  \brief Test if a tile should be a jump point, i.e. it is at the
+         *  tip of an impassable tile for an agent of any supported size
+         */
+        [[nodiscard]] bool shouldBeJumpPoint(const sf::Vector2u& point) const;
+
+        /**
+         *  \brief Append connections of a jump point to output and record
+         *  its scan bounds
+         */
         void discoverConnectionsForJumpPoint(
-            const sf::Vector2u& point, bool symmetricConnection = false);
+            unsigned id, std::vector<Connection>& output);
 
-        void connectTwoJumpPoints(
-            const sf::Vector2u& a,
-            const sf::Vector2u& b,
-            bool symmetricConnection);
+        /**
+         *  \brief Recompute jump points and connections after passability
+         *  of tiles within inclusive bounds changed
+         *
+         *  Clearance must already be updated.
+         */
+        void repairGraph(const TileBounds& changedTiles);
+
+        /**
+         *  \brief Pick landmarks among jump points and compute their
+         *  distances over the current graph
+         */
+        void computeLandmarks();
 
-        void connectToAndFromPointsToTheNetwork(
-            const sf::Vector2u& tileFrom, const sf::Vector2u& tileTo);
+        /**
+         *  \brief Call onFound for every point that passes isJumpPoint and
+         *  is directly reachable from given point
+         *
+         *  Besides the point, onFound receives the smallest clearance of
+         *  tiles passed on the way, excluding the given point.
+         */
+        template<class IsJumpPointPredicate, class OnFoundCallback>
+        void forEachReachableJumpPoint(
+            const sf::Vector2u& point,
+            IsJumpPointPredicate&& isJumpPoint,
+            OnFoundCallback&& onFound) const;
 
-        void eraseFromAndToPointsFromTheNetwork(
+        /**
+         *  \brief Connect start and goal of a query to the jump point network
+         *
+         *  Connections are stored in the context so the network itself is
+         *  not modified.
+         */
+        void linkQueryPointsToTheNetwork(
             const sf::Vector2u& tileFrom,
-            bool wasTileFromOriginallyJumpPoint,
             const sf::Vector2u& tileTo,
-            bool wasTileToOriginallyJumpPoint);
+            unsigned agentRadius,
+            PathSearchContext& context) const;
+
+        [[nodiscard]] SearchQuery makeSearchQuery(
+            const sf::Vector2f& from,
+            const sf::Vector2f& to,
+            unsigned agentRadius) const;
+
+        /**
+         *  \brief Resolve trivial queries, link the query to the network
+         *  and start the search
+         *
+         *  \return Result of a query resolved without any search, empty
+         *  optional if the search was started
+         */
+        [[nodiscard]] std::optional<PathRequestStatus>
+        beginSearch(const SearchQuery& query, PathSearchContext& context) const;
+
+        [[nodiscard]] PathRequestStatus expandSearch(
+            const SearchQuery& query,
+            PathSearchContext& context,
+            std::size_t maxExpansions) const;
+
+        [[nodiscard]] dgm::Path<WorldNavpoint>
+        buildPath(const SearchQuery& query, PathSearchContext& context) const;
+
+        [[nodiscard]] unsigned getConnectionDistance(
+            const sf::Vector2u& a, const sf::Vector2u& b) const;
 
-        [[nodiscard]] sf::Vector2u toTileCoord(const sf::Vector2f& coord);
+        [[nodiscard]] sf::Vector2u
+        toTileCoord(const sf::Vector2f& coord) const;
 
         [[nodiscard]] WorldNavpoint
-        toWorldNavpoint(const sf::Vector2u& coord);
+        toWorldNavpoint(const sf::Vector2u& coord) const;
     };
 
 } // namespace dgm
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <DGM/classes/Objects.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace dgm
+{
+
+    /**
+     * @brief Multi-resolution occupancy map of a dgm::Mesh
+     *
+     * Level k (1 <= k <= getLevelCount()) splits the mesh into blocks of
+     * 2^k x 2^k tiles and remembers which of them are completely empty
+     * (all tiles have value <= 0). Blocks that are not fully inside the mesh
+     * are never considered empty.
+     *
+     * dgm::Raycaster can use this structure to leap over large empty areas in
+     * a single step instead of advancing tile by tile.
+     *
+     * The hierarchy does not observe the mesh. Whenever a tile of the mesh
+     * changes, call updateTile so the hierarchy stays in sync.
+     */
+    class [[nodiscard]] OccupancyHierarchy final
+    {
+    public:
+        /**
+         * @param[in] mesh        Mesh to build the hierarchy from
+         * @param[in] maxLevels   Maximum number of levels to build. Zero
+         *                        means as many as make sense for given mesh.
+         */
+        explicit OccupancyHierarchy(
+            const dgm::Mesh& mesh, unsigned maxLevels = 0u);
+
+        OccupancyHierarchy(OccupancyHierarchy&&) = default;
+        OccupancyHierarchy(const OccupancyHierarchy&) = delete;
+
+    public:
+        /**
+         * @brief Refresh the hierarchy after a tile in the mesh changed
+         *
+         * Runs in O(getLevelCount()).
+         */
+        void updateTile(const dgm::Mesh& mesh, const sf::Vector2u& tile);
+
+        /**
+         * @brief Get number of levels above the mesh itself
+         */
+        [[nodiscard]] constexpr unsigned getLevelCount() const noexcept
+        {
+            return static_cast<unsigned>(levels.size());
+        }
+
+        /**
+         * @brief Test whether a block at given level is completely empty
+         *
+         * @param[in] level  Level in range [1, getLevelCount()]
+         * @param[in] block  Block coordinate, i.e. tile coordinate divided
+         *                   by 2^level
+         */
+        [[nodiscard]] bool
+        isBlockEmpty(unsigned level, const sf::Vector2u& block) const noexcept
+        {
+            auto&& grid = levels[level - 1];
+            if (block.x >= grid.size.x || block.y >= grid.size.y) return false;
+            return grid.empty[block.y * grid.size.x + block.x];
+        }
+
+        /**
+         * @brief Get highest level at which the block containing the tile is
+         * empty
+         *
+         * @return Zero if even the smallest block around the tile contains a
+         * solid tile
+         */
+        [[nodiscard]] unsigned
+        getEmptyBlockLevel(const sf::Vector2u& tile) const noexcept
+        {
+            unsigned level = 0;
+            while (level < getLevelCount()
+                   && isBlockEmpty(
+                       level + 1,
+                       { tile.x >> (level + 1), tile.y >> (level + 1) }))
+                ++level;
+            return level;
+        }
+
+    private:
+        struct [[nodiscard]] Level final
+        {
+            sf::Vector2u size;
+            std::vector<std::uint8_t> empty;
+        };
+
+    private:
+        void updateBlock(
+            const dgm::Mesh& mesh, unsigned level, const sf::Vector2u& block);
+
+    private:
+        std::vector<Level> levels = {};
+    };
+
+} // namespace dgm
@@ -6,7 +6,9 @@
 #include <SFML/Graphics/Vertex.hpp>
 #include <SFML/System/Time.hpp>
 #include <SFML/System/Vector2.hpp>
+#include <algorithm>
 #include <span>
+#include <utility>
 
 namespace dgm
 {
@@ -56,6 +58,15 @@ namespace dgm
                 return forward;
             }
 
+            /**
+             *  \brief Get the quad of the particle in the vertex buffer
+             */
+            [[nodiscard]] std::span<const sf::Vertex>
+            getVertices() const noexcept
+            {
+                return vertices;
+            }
+
             [[nodiscard]] constexpr sf::Angle getRotation() const noexcept
             {
                 return rotation;
@@ -156,6 +167,19 @@ namespace dgm
                 spawn({ 0.f, 0.f }, { 0.f, 0.f }, sf::Time::Zero);
             }
 
+            /**
+             *  \brief Exchange quads in the vertex buffer with another
+             *  particle
+             *
+             *  \details Content of the quads is exchanged as well, so both
+             *  particles look the same as before.
+             */
+            void swapVertices(Particle& other) noexcept
+            {
+                std::ranges::swap_ranges(vertices, other.vertices);
+                std::swap(vertices, other.vertices);
+            }
+
         protected:
             std::span<sf::Vertex> vertices;
             float lifespan = 1.f;                 ///< How long till dead
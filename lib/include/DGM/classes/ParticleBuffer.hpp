@@ -0,0 +1,287 @@
+#pragma once
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Time.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace dgm
+{
+    namespace ps
+    {
+        /**
+         *  \brief Spans of all columns of a range of particles
+         */
+        struct [[nodiscard]] ParticleColumns final
+        {
+            std::span<float> positionsX;
+            std::span<float> positionsY;
+            std::span<float> velocitiesX;
+            std::span<float> velocitiesY;
+            std::span<float> lifespans;
+            std::span<float> initialLifespans;
+            std::span<float> rotations;
+            std::span<float> sizes;
+            std::span<sf::Color> colors;
+            std::span<sf::IntRect> textureRects;
+
+            [[nodiscard]] constexpr std::size_t getSize() const noexcept
+            {
+                return lifespans.size();
+            }
+        };
+
+        /**
+         *  \brief Storage of particles as a structure of arrays
+         *
+         *  \details Every attribute of the particles lives in its own
+         *  contiguous column, so a simulation step is a handful of tight
+         *  loops over plain numbers instead of a virtual call per particle.
+         *
+         *  Live particles occupy the first getSize() slots of every column
+         *  and column getters only return this prefix. Like with
+         *  dgm::StaticBuffer, removal moves the last particle into the
+         *  freed slot, so the order of particles is not stable.
+         *
+         *  Particles are squares centered on their position. Vertices for
+         *  rendering are generated from the columns by writeVertices,
+         *  typically once per frame after the simulation.
+         */
+        class [[nodiscard]] ParticleBuffer final
+        {
+        public:
+            explicit ParticleBuffer(std::size_t capacity);
+
+            ParticleBuffer(ParticleBuffer&&) = default;
+            ParticleBuffer(const ParticleBuffer&) = delete;
+
+        public:
+            /**
+             *  \brief Append a particle
+             *
+             *  \details Velocity and rotation of the new particle are zero,
+             *  its color is white and its texture rect is empty. Other
+             *  attributes can be set through columns at the returned index.
+             *
+             *  \return Index of the particle or nothing if the buffer is full
+             */
+            std::optional<std::size_t> spawn(
+                const sf::Vector2f& position,
+                float size,
+                const sf::Time& lifespan) noexcept;
+
+            /**
+             *  \brief Remove particle by moving the last one in its place
+             */
+            void remove(std::size_t index) noexcept;
+
+            /**
+             *  \brief Remove all particles whose lifespan ran out
+             *
+             *  \details Done in a single pass over the lifespans.
+             */
+            void removeDead() noexcept;
+
+            void clear() noexcept
+            {
+                size = 0;
+            }
+
+            /**
+             *  \brief Write quads of all live particles, six vertices each
+             *
+             *  \details Vertices are written as two triangles per particle
+             *  to the beginning of the output, which must have room for
+             *  getSize() * VERTICES_PER_PARTICLE vertices.
+             */
+            void writeVertices(std::span<sf::Vertex> output) const noexcept
+            {
+                writeVertices(output, 0, size);
+            }
+
+            /**
+             *  \brief Write quads of particles in [first, first + count)
+             *
+             *  \details Quads are written to the same place of the output
+             *  as if all particles were written, so disjoint ranges can be
+             *  written concurrently.
+             */
+            void writeVertices(
+                std::span<sf::Vertex> output,
+                std::size_t first,
+                std::size_t count) const noexcept;
+
+            [[nodiscard]] constexpr std::size_t getSize() const noexcept
+            {
+                return size;
+            }
+
+            /**
+             *  \brief Get columns of live particles in [first, first + count)
+             *
+             *  \details By default, columns of all live particles
+             *  are returned.
+             */
+            [[nodiscard]] ParticleColumns getColumns(
+                std::size_t first = 0,
+                std::size_t count = std::dynamic_extent) noexcept;
+
+            [[nodiscard]] std::size_t getCapacity() const noexcept
+            {
+                return lifespans.size();
+            }
+
+            [[nodiscard]] constexpr bool isEmpty() const noexcept
+            {
+                return size == 0;
+            }
+
+            [[nodiscard]] bool isFull() const noexcept
+            {
+                return size == getCapacity();
+            }
+
+            [[nodiscard]] std::span<float> getPositionsX() noexcept
+            {
+                return std::span(positionsX).first(size);
+            }
+
+            [[nodiscard]] std::span<const float> getPositionsX() const noexcept
+            {
+                return std::span(positionsX).first(size);
+            }
+
+            [[nodiscard]] std::span<float> getPositionsY() noexcept
+            {
+                return std::span(positionsY).first(size);
+            }
+
+            [[nodiscard]] std::span<const float> getPositionsY() const noexcept
+            {
+                return std::span(positionsY).first(size);
+            }
+
+            /**
+             *  \brief Velocities in pixels per second
+             */
+            [[nodiscard]] std::span<float> getVelocitiesX() noexcept
+            {
+                return std::span(velocitiesX).first(size);
+            }
+
+            [[nodiscard]] std::span<const float> getVelocitiesX() const noexcept
+            {
+                return std::span(velocitiesX).first(size);
+            }
+
+            [[nodiscard]] std::span<float> getVelocitiesY() noexcept
+            {
+                return std::span(velocitiesY).first(size);
+            }
+
+            [[nodiscard]] std::span<const float> getVelocitiesY() const noexcept
+            {
+                return std::span(velocitiesY).first(size);
+            }
+
+            /**
+             *  \brief Remaining lifetimes in seconds, particle is dead once
+             *  its lifespan drops to zero
+             */
+            [[nodiscard]] std::span<float> getLifespans() noexcept
+            {
+                return std::span(lifespans).first(size);
+            }
+
+            [[nodiscard]] std::span<const float> getLifespans() const noexcept
+            {
+                return std::span(lifespans).first(size);
+            }
+
+            /**
+             *  \brief Lifespans the particles were spawned with, in seconds
+             */
+            [[nodiscard]] std::span<float> getInitialLifespans() noexcept
+            {
+                return std::span(initialLifespans).first(size);
+            }
+
+            [[nodiscard]] std::span<const float>
+            getInitialLifespans() const noexcept
+            {
+                return std::span(initialLifespans).first(size);
+            }
+
+            /**
+             *  \brief Rotations in radians
+             */
+            [[nodiscard]] std::span<float> getRotations() noexcept
+            {
+                return std::span(rotations).first(size);
+            }
+
+            [[nodiscard]] std::span<const float> getRotations() const noexcept
+            {
+                return std::span(rotations).first(size);
+            }
+
+            /**
+             *  \brief Lengths of sides of the particle squares
+             */
+            [[nodiscard]] std::span<float> getSizes() noexcept
+            {
+                return std::span(sizes).first(size);
+            }
+
+            [[nodiscard]] std::span<const float> getSizes() const noexcept
+            {
+                return std::span(sizes).first(size);
+            }
+
+            [[nodiscard]] std::span<sf::Color> getColors() noexcept
+            {
+                return std::span(colors).first(size);
+            }
+
+            [[nodiscard]] std::span<const sf::Color> getColors() const noexcept
+            {
+                return std::span(colors).first(size);
+            }
+
+            /**
+             *  \brief Parts of the texture mapped onto particles
+             */
+            [[nodiscard]] std::span<sf::IntRect> getTextureRects() noexcept
+            {
+                return std::span(textureRects).first(size);
+            }
+
+            [[nodiscard]] std::span<const sf::IntRect>
+            getTextureRects() const noexcept
+            {
+                return std::span(textureRects).first(size);
+            }
+
+        public:
+            static constexpr std::size_t VERTICES_PER_PARTICLE = 6;
+
+        private:
+            std::size_t size = 0;
+            std::vector<float> positionsX;
+            std::vector<float> positionsY;
+            std::vector<float> velocitiesX;
+            std::vector<float> velocitiesY;
+            std::vector<float> lifespans;
+            std::vector<float> initialLifespans;
+            std::vector<float> rotations;
+            std::vector<float> sizes;
+            std::vector<sf::Color> colors;
+            std::vector<sf::IntRect> textureRects;
+        };
+    }; // namespace ps
+} // namespace dgm
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Angle.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <variant>
+#include <vector>
+
+namespace dgm
+{
+    namespace ps
+    {
+        /**
+         *  \brief Source of particles of a dgm::ps::ParticleEffect
+         *
+         *  \details Attributes given by a range are picked uniformly
+         *  at random for each spawned particle.
+         */
+        struct [[nodiscard]] Emitter final
+        {
+            struct Point
+            {
+            };
+
+            struct Circle
+            {
+                float radius = 0.f;
+            };
+
+            /**
+             *  Rectangle centered on the position of the emitter
+             */
+            struct Rectangle
+            {
+                sf::Vector2f size = {};
+            };
+
+            using Shape = std::variant<Point, Circle, Rectangle>;
+
+            sf::Vector2f position = {};
+            Shape shape = Point {};
+
+            float rate = 0.f; ///< Particles spawned per second
+            unsigned burst = 0; ///< Particles spawned at once on (re)start
+
+            /// Direction of initial velocity, default is upwards
+            sf::Angle direction = sf::degrees(-90.f);
+            /// Maximum deviation from the direction to either side
+            sf::Angle spread = sf::Angle::Zero;
+            float minSpeed = 0.f; ///< Pixels per second
+            float maxSpeed = 0.f;
+
+            float minLifespan = 1.f; ///< Seconds, must be positive
+            float maxLifespan = 1.f;
+            float minSize = 1.f;
+            float maxSize = 1.f;
+            sf::Color color = sf::Color::White;
+            sf::IntRect textureRect = {};
+        };
+
+        /**
+         *  \brief Constant acceleration, like gravity or wind
+         */
+        struct [[nodiscard]] ForceAffector final
+        {
+            sf::Vector2f acceleration = {}; ///< Pixels per second squared
+        };
+
+        /**
+         *  \brief Air resistance
+         */
+        struct [[nodiscard]] DragAffector final
+        {
+            float drag = 0.f; ///< Fraction of velocity lost per second
+        };
+
+        /**
+         *  \brief Rotation at constant speed
+         */
+        struct [[nodiscard]] SpinAffector final
+        {
+            sf::Angle angularVelocity = sf::Angle::Zero; ///< Per second
+        };
+
+        /**
+         *  \brief Color blended from start to end over the life of particles
+         */
+        struct [[nodiscard]] ColorOverLifeAffector final
+        {
+            sf::Color start = sf::Color::White;
+            sf::Color end = sf::Color::Transparent;
+        };
+
+        /**
+         *  \brief Size interpolated from start to end over the life
+         *  of particles
+         */
+        struct [[nodiscard]] SizeOverLifeAffector final
+        {
+            float start = 1.f;
+            float end = 0.f;
+        };
+
+        using Affector = std::variant<
+            ForceAffector,
+            DragAffector,
+            SpinAffector,
+            ColorOverLifeAffector,
+            SizeOverLifeAffector>;
+
+        /**
+         *  \brief Description of a particle effect as plain data
+         *
+         *  \details Affectors are applied in the given order every update,
+         *  then particles are moved by their velocity and they age.
+         *  Effect is simulated by dgm::ps::ParticleEffectSystem.
+         */
+        struct [[nodiscard]] ParticleEffect final
+        {
+            std::vector<Emitter> emitters = {};
+            std::vector<Affector> affectors = {};
+        };
+    }; // namespace ps
+} // namespace dgm
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <DGM/classes/ParticleEffect.hpp>
+#include <DGM/classes/ParticleSystem.hpp>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace dgm
+{
+    namespace ps
+    {
+        /**
+         *  \brief Particle system driven by a dgm::ps::ParticleEffect
+         *
+         *  \details Emitters spawn particles on the calling thread.
+         *  Affectors are compiled once on construction and the whole
+         *  chain, including movement and aging of particles, is applied
+         *  to one chunk of particles after another, while it is in cache.
+         *  Every affector is a single loop over a column of the chunk.
+         *
+         *  Random attributes of particles are generated from the seed,
+         *  so an effect with the same seed always looks the same.
+         */
+        class [[nodiscard]] ParticleEffectSystem final : public ParticleSystem
+        {
+        public:
+            ParticleEffectSystem(
+                unsigned particleCount,
+                const ParticleEffect& effect,
+                unsigned seed = 0);
+
+        public:
+            /**
+             *  \brief Emitters of the effect
+             *
+             *  \details Emitters can be changed between updates,
+             *  for example to follow a moving object.
+             */
+            [[nodiscard]] std::span<Emitter> getEmitters() noexcept
+            {
+                return emitters;
+            }
+
+            [[nodiscard]] std::span<const Emitter> getEmitters() const noexcept
+            {
+                return emitters;
+            }
+
+            /**
+             *  \brief Remove all particles and let emitters spawn
+             *  their bursts again on the next update
+             */
+            void restart() noexcept;
+
+            /**
+             *  \brief Test whether all particles died and emitters
+             *  will not spawn any more
+             */
+            [[nodiscard]] bool isFinished() const noexcept;
+
+        protected:
+            void simulate(const dgm::Time& time) override;
+
+            void simulateChunk(
+                const dgm::Time& time,
+                ParticleColumns chunk) noexcept override;
+
+        private:
+            void emit(const Emitter& emitter, unsigned count);
+
+        private:
+            std::vector<Emitter> emitters;
+            std::vector<Affector> affectors;
+            /// Fractions of particles carried over to the next update
+            std::vector<float> spawnDebts;
+            bool burstPending = true;
+            std::minstd_rand randomEngine;
+        };
+    }; // namespace ps
+} // namespace dgm
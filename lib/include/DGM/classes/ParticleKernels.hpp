@@ -0,0 +1,118 @@
+#pragma once
+
+#include <span>
+
+namespace dgm
+{
+    namespace ps
+    {
+        /**
+         *  \brief Batch operations over columns of dgm::ps::ParticleBuffer
+         *
+         *  \details Every kernel processes a whole column in a single loop
+         *  using SSE2 or AVX lanes, depending on the instruction set the
+         *  library was compiled for, and falls back to scalar code on other
+         *  platforms and for the tail of the column.
+         *
+         *  All spans passed to a kernel must have the same size.
+         */
+        class ParticleKernels
+        {
+        public:
+            /**
+             *  \brief Move positions by velocities
+             *
+             *  \details positions[i] += velocities[i] * deltaTime
+             */
+            static void integrate(
+                std::span<float> positions,
+                std::span<const float> velocities,
+                float deltaTime) noexcept;
+
+            /**
+             *  \brief Accelerate all particles by a constant force,
+             *  like gravity or wind
+             *
+             *  \details velocities[i] += acceleration * deltaTime
+             */
+            static void applyForce(
+                std::span<float> velocities,
+                float acceleration,
+                float deltaTime) noexcept;
+
+            /**
+             *  \brief Slow all particles down by air resistance
+             *
+             *  \details velocities[i] *= max(0, 1 - drag * deltaTime)
+             *
+             *  \param drag  Fraction of velocity lost per second
+             */
+            static void applyDrag(
+                std::span<float> velocities,
+                float drag,
+                float deltaTime) noexcept;
+
+            /**
+             *  \brief Rotate all particles at the same speed
+             *
+             *  \details Resulting rotations are wrapped into [-pi, pi],
+             *  so they stay precise no matter how long particles spin.
+             *  Rotations must be within [-pi, pi] before the call,
+             *  which holds for rotations produced by this kernel.
+             *
+             *  \param angularVelocity  Radians per second
+             */
+            static void rotate(
+                std::span<float> rotations,
+                float angularVelocity,
+                float deltaTime) noexcept;
+
+            /**
+             *  \brief Shorten remaining lifetimes by elapsed time
+             */
+            static void decayLifespans(
+                std::span<float> lifespans, float deltaTime) noexcept;
+
+            /**
+             *  \brief Interpolate values between start and end by the age
+             *  of particles
+             *
+             *  \details Particles that were just spawned get the start
+             *  value, particles whose lifespan ran out get the end value.
+             *  Initial lifespans must be positive.
+             */
+            static void interpolateOverLife(
+                std::span<float> values,
+                std::span<const float> lifespans,
+                std::span<const float> initialLifespans,
+                float start,
+                float end) noexcept;
+
+            /**
+             *  \brief Compute offsets of corners of rotated particle squares
+             *
+             *  \details Corners of a square with half side h rotated by
+             *  angle a are (-q, -p), (p, -q), (q, p) and (-p, q) relative
+             *  to its center, where p = h * (cos a + sin a) and
+             *  q = h * (cos a - sin a).
+             *
+             *  Sine and cosine are approximated by polynomials. Error of
+             *  the offsets is below 1e-6 * h for rotations within
+             *  +- 1e4 radians and grows quickly beyond that, which is why
+             *  rotate keeps rotations within [-pi, pi].
+             */
+            static void computeCornerOffsets(
+                std::span<const float> sizes,
+                std::span<const float> rotations,
+                std::span<float> p,
+                std::span<float> q) noexcept;
+
+            /**
+             *  \brief Name of the instruction set used by the kernels
+             *
+             *  \return "AVX", "SSE2" or "scalar"
+             */
+            [[nodiscard]] static const char* getInstructionSet() noexcept;
+        };
+    }; // namespace ps
+} // namespace dgm
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <DGM/classes/ParticleBuffer.hpp>
+#include <DGM/classes/ParticleSystemRenderer.hpp>
+#include <DGM/classes/Time.hpp>
+#include <DGM/classes/Window.hpp>
+#include <DGM/classes/WorkerPool.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <algorithm>
+
+namespace dgm
+{
+    namespace ps
+    {
+        /**
+         *  \brief Base of particle systems with data-oriented storage
+         *
+         *  \details Unlike dgm::ps::ParticleSystemInterface, particles are
+         *  not objects. Inherited systems implement simulate, which works
+         *  on columns of the particles buffer, and vertices of all
+         *  particles are regenerated in one pass afterwards.
+         *
+         *  Work that only touches individual particles can be moved to
+         *  simulateChunk. Particles are then split into chunks of
+         *  CHUNK_SIZE which can be simulated in parallel by a WorkerPool.
+         */
+        class [[nodiscard]] ParticleSystem
+        {
+        public:
+            explicit ParticleSystem(unsigned particleCount)
+                : renderer(particleCount), particles(particleCount)
+            {
+            }
+
+            ParticleSystem(ParticleSystem&& other) = default;
+            ParticleSystem(const ParticleSystem& other) = delete;
+            virtual ~ParticleSystem() = default;
+
+        public:
+            /**
+             *  \brief Render particle system to target window
+             */
+            void draw(dgm::Window& window)
+            {
+                window.draw(renderer);
+            }
+
+            /**
+             *  \brief Bind the texture to the particle system
+             *
+             *  \details All particles share the same texture, each of them
+             *  displays the part of it given by its texture rect.
+             */
+            constexpr void setTexture(const sf::Texture& texture) noexcept
+            {
+                renderer.setTexture(texture);
+            }
+
+            /**
+             *  \brief Simulate particles and regenerate their vertices
+             *
+             *  \details Calls simulate, then simulateChunk for every
+             *  chunk, removes dead particles and writes vertices.
+             *  Everything runs on the calling thread.
+             */
+            void update(const dgm::Time& time)
+            {
+                updateImpl(time, nullptr);
+            }
+
+            /**
+             *  \brief Same as update, but chunks are simulated and their
+             *  vertices written by threads of the pool
+             *
+             *  \details Systems with a single chunk run on the calling
+             *  thread without waking up the pool.
+             */
+            void update(const dgm::Time& time, dgm::WorkerPool& pool)
+            {
+                updateImpl(time, &pool);
+            }
+
+            [[nodiscard]] const ParticleBuffer& getParticles() const noexcept
+            {
+                return particles;
+            }
+
+        public:
+            static constexpr std::size_t CHUNK_SIZE = 1024;
+
+        protected:
+            /**
+             *  \brief Advance the simulation
+             *
+             *  \details This is the only method you have to implement
+             *  in your inherited particle system. It always runs on
+             *  the thread calling update, so it is the place for
+             *  spawning particles and other work on the whole buffer.
+             *
+             *  Particles whose lifespan ran out are removed after
+             *  the simulation.
+             */
+            virtual void simulate(const dgm::Time& time) = 0;
+
+            /**
+             *  \brief Advance the simulation of a chunk of particles
+             *
+             *  \details Called after simulate. Chunks are disjoint and
+             *  may be simulated concurrently, so the implementation must
+             *  only access the given columns and must not modify the rest
+             *  of the system.
+             */
+            virtual void simulateChunk(
+                [[maybe_unused]] const dgm::Time& time,
+                [[maybe_unused]] ParticleColumns chunk) noexcept
+            {
+            }
+
+        private:
+            void updateImpl(const dgm::Time& time, dgm::WorkerPool* pool)
+            {
+                simulate(time);
+                forEachChunk(
+                    pool,
+                    [&](std::size_t first, std::size_t count)
+                    {
+                        simulateChunk(
+                            time, particles.getColumns(first, count));
+                    });
+
+                // Compaction is a single pass over lifespans
+                // which is not worth splitting among threads
+                particles.removeDead();
+                updateVertices(pool);
+            }
+
+            void updateVertices(dgm::WorkerPool* pool) noexcept
+            {
+                auto&& vertices = renderer.getVertices();
+                forEachChunk(
+                    pool,
+                    [&](std::size_t first, std::size_t count)
+                    { particles.writeVertices(vertices, first, count); });
+
+                // Quads of particles that died since the last update
+                // are left behind the live ones and not drawn
+                renderer.setLiveParticleCount(particles.getSize());
+            }
+
+            template<class Task>
+            void forEachChunk(dgm::WorkerPool* pool, Task&& task)
+            {
+                const auto size = particles.getSize();
+                const auto chunkCount = (size + CHUNK_SIZE - 1) / CHUNK_SIZE;
+                auto&& runChunk = [&](std::size_t chunk)
+                {
+                    const auto first = chunk * CHUNK_SIZE;
+                    task(first, std::min(CHUNK_SIZE, size - first));
+                };
+
+                if (pool)
+                    pool->forEach(chunkCount, runChunk);
+                else
+                    for (std::size_t i = 0; i < chunkCount; ++i)
+                        runChunk(i);
+            }
+
+        protected:
+            dgm::ps::ParticleSystemRenderer renderer;
+            dgm::ps::ParticleBuffer particles;
+        };
+    }; // namespace ps
+}; // namespace dgm
@@ -10,6 +10,7 @@
 #include <SFML/Graphics/Vertex.hpp>
 #include <concepts>
 #include <span>
+#include <vector>
 
 namespace dgm
 {
@@ -29,10 +30,12 @@ namespace dgm
             {
                 try
                 {
+                    vertexOwners.reserve(particles.getCapacity());
                     for (unsigned i = 0; i < particles.getCapacity(); i++)
                     {
                         particles[i] =
                             createParticle(renderer.getParticleVertices(i), i);
+                        vertexOwners.push_back(particles[i].get());
                     }
                 }
                 catch (std::exception& e)
@@ -48,9 +51,13 @@ namespace dgm
         public:
             /**
              *  \brief Render particle system to target window
+             *
+             *  \details Only quads of live particles are drawn.
              */
             inline void draw(dgm::Window& window)
             {
+                compactVertices();
+                renderer.setLiveParticleCount(particles.getSize());
                 window.draw(renderer);
             }
 
@@ -107,9 +114,36 @@ namespace dgm
                 return std::make_unique<Particle>(vertices);
             }
 
+        private:
+            /**
+             *  Removing from particles only swaps pointers, so quads of live
+             *  particles get scattered over the vertex array. Give i-th live
+             *  particle the i-th quad, so the renderer only draws a prefix.
+             */
+            void compactVertices() noexcept
+            {
+                const auto* firstVertex = renderer.getVertices().data();
+                for (std::size_t i = 0; i < particles.getSize(); ++i)
+                {
+                    auto* particle = particles[i].get();
+                    auto* owner = vertexOwners[i];
+                    if (particle == owner) continue;
+
+                    const auto particleQuad = static_cast<std::size_t>(
+                        (particle->getVertices().data() - firstVertex)
+                        / ParticleSystemRenderer::VERTICES_PER_QUAD);
+                    particle->swapVertices(*owner);
+                    vertexOwners[particleQuad] = owner;
+                    vertexOwners[i] = particle;
+                }
+            }
+
         protected:
             dgm::ps::ParticleSystemRenderer renderer;
             dgm::StaticBuffer<std::unique_ptr<Particle>> particles;
+
+        private:
+            std::vector<Particle*> vertexOwners; ///< Particle using each quad
         };
     }; // namespace ps
 }; // namespace dgm
\ No newline at end of file
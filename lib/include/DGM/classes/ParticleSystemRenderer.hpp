@@ -19,7 +19,9 @@ namespace dgm
         {
         public:
             explicit ParticleSystemRenderer(unsigned particleCount)
-                : sf::Drawable(), sf::Transformable()
+                : sf::Drawable()
+                , sf::Transformable()
+                , liveParticleCount(particleCount)
             {
                 vertices = sf::VertexArray(
                     sf::PrimitiveType::Triangles,
@@ -27,6 +29,28 @@ namespace dgm
             }
 
         public:
+            /**
+             *  \brief Set how many particles from the beginning of the
+             *  vertex array are drawn
+             *
+             *  \details Quads of other particles are not submitted at all,
+             *  so they cost nothing regardless of their content.
+             *  By default, all particles are drawn.
+             */
+            void setLiveParticleCount(std::size_t count) noexcept
+            {
+                assert(count * VERTICES_PER_QUAD <= vertices.getVertexCount());
+                liveParticleCount = count;
+            }
+
+            /**
+             *  \brief Number of vertices submitted by the last draw call
+             */
+            [[nodiscard]] std::size_t getSubmittedVertexCount() const noexcept
+            {
+                return submittedVertexCount;
+            }
+
             /**
              *  \brief Get array of vertices for given particle
              *
@@ -40,6 +64,16 @@ namespace dgm
                     &vertices[index * VERTICES_PER_QUAD], VERTICES_PER_QUAD);
             }
 
+            /**
+             *  \brief Get vertices of all particles, VERTICES_PER_QUAD for
+             *  each of them
+             */
+            [[nodiscard]] std::span<sf::Vertex> getVertices() noexcept
+            {
+                if (vertices.getVertexCount() == 0) return {};
+                return std::span(&vertices[0], vertices.getVertexCount());
+            }
+
             /**
              *  \brief Bind texture to the object
              *
@@ -64,15 +98,24 @@ namespace dgm
                 // apply the tileset texture
                 states.texture = texture;
 
-                // draw the vertex array
-                target.draw(vertices, states);
+                // draw quads of live particles
+                submittedVertexCount = liveParticleCount * VERTICES_PER_QUAD;
+                if (submittedVertexCount == 0) return;
+                target.draw(
+                    &vertices[0],
+                    submittedVertexCount,
+                    sf::PrimitiveType::Triangles,
+                    states);
             }
 
-        private:
+        public:
             constexpr static inline const unsigned VERTICES_PER_QUAD = 6;
 
+        private:
             sf::VertexArray vertices;
             const sf::Texture* texture = nullptr;
+            std::size_t liveParticleCount;
+            mutable std::size_t submittedVertexCount = 0;
         };
     }; // namespace ps
 }; // namespace dgm
\ No newline at end of file
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <DGM/classes/Path.hpp>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace dgm
+{
+    enum class PathRequestStatus
+    {
+        InProgress,
+        Found,
+        NotFound,
+        Cancelled
+    };
+
+    namespace priv
+    {
+        /**
+         *  Resumable search behind dgm::PathRequest, implemented by
+         *  navmeshes. Owns all scratch memory of the search.
+         */
+        template<class NavpointType>
+        class [[nodiscard]] PathSearchTask
+        {
+        public:
+            virtual ~PathSearchTask() = default;
+
+        public:
+            /**
+             *  Continue the search, expanding at most maxExpansions nodes
+             *
+             *  \return InProgress until the search ends, then Found or
+             *  NotFound
+             */
+            [[nodiscard]] virtual PathRequestStatus
+            expand(std::size_t maxExpansions) = 0;
+
+            /**
+             *  Build the path once expand returned Found
+             */
+            [[nodiscard]] virtual dgm::Path<NavpointType> buildPath() = 0;
+        };
+    } // namespace priv
+
+    /**
+     *  \brief Path query that can be computed over several frames or on
+     *  a worker thread
+     *
+     *  Requests are created by dgm::TileNavMesh::requestPath and
+     *  dgm::WorldNavMesh::requestPath. They find the same paths as the
+     *  corresponding computePath, but the search can be advanced by a given
+     *  number of node expansions at a time, so an expensive query does not
+     *  stall a whole frame.
+     *
+     *  A request keeps a reference to the source of the query (the mesh
+     *  or the navmesh), which must outlive the request and must not change
+     *  until the request is done.
+     *
+     *  To compute the path on another thread, call run from that thread.
+     *  getStatus, wait and cancel can be called from any thread at the same
+     *  time, other methods must not be called concurrently.
+     */
+    template<class NavpointType>
+    class [[nodiscard]] PathRequest final
+    {
+    public:
+        explicit PathRequest(
+            std::unique_ptr<priv::PathSearchTask<NavpointType>> task)
+            : state(std::make_unique<State>())
+        {
+            state->task = std::move(task);
+        }
+
+        PathRequest(PathRequest&&) = default;
+        PathRequest(const PathRequest&) = delete;
+        PathRequest& operator=(PathRequest&&) = default;
+
+    public:
+        /**
+         *  \brief Continue the search, expanding at most maxExpansions nodes
+         *
+         *  Does nothing if the request is already done.
+         *
+         *  \return Status after the step
+         */
+        PathRequestStatus step(std::size_t maxExpansions)
+        {
+            if (getStatus() != PathRequestStatus::InProgress)
+                return getStatus();
+
+            if (state->cancelRequested.load(std::memory_order_relaxed))
+                return finish(PathRequestStatus::Cancelled);
+
+            const auto status = state->task->expand(maxExpansions);
+            if (status == PathRequestStatus::Found)
+                state->path.emplace(state->task->buildPath());
+            if (status != PathRequestStatus::InProgress) return finish(status);
+            return status;
+        }
+
+        /**
+         *  \brief Compute the request until it is done or cancelled
+         *
+         *  Cancellation is checked every CANCEL_CHECK_INTERVAL expansions.
+         */
+        PathRequestStatus run()
+        {
+            while (step(CANCEL_CHECK_INTERVAL) == PathRequestStatus::InProgress)
+                ;
+            return getStatus();
+        }
+
+        /**
+         *  \brief Stop the request at the next step
+         *
+         *  Safe to call from any thread. Has no effect on requests that are
+         *  already done.
+         */
+        void cancel() noexcept
+        {
+            state->cancelRequested.store(true, std::memory_order_relaxed);
+        }
+
+        /**
+         *  \brief Safe to call from any thread
+         */
+        [[nodiscard]] PathRequestStatus getStatus() const noexcept
+        {
+            return state->status.load(std::memory_order_acquire);
+        }
+
+        [[nodiscard]] bool isDone() const noexcept
+        {
+            return getStatus() != PathRequestStatus::InProgress;
+        }
+
+        /**
+         *  \brief Block until the request is done
+         *
+         *  Safe to call from any thread, but some other thread must be
+         *  computing the request.
+         */
+        void wait() const noexcept
+        {
+            state->status.wait(
+                PathRequestStatus::InProgress, std::memory_order_acquire);
+        }
+
+        /**
+         *  \brief Move the found path out of the request
+         *
+         *  \return Path if status is Found and the path was not taken yet,
+         *  empty optional otherwise
+         */
+        [[nodiscard]] std::optional<dgm::Path<NavpointType>> takePath()
+        {
+            if (getStatus() != PathRequestStatus::Found) return std::nullopt;
+            return std::exchange(state->path, std::nullopt);
+        }
+
+    public:
+        static constexpr std::size_t CANCEL_CHECK_INTERVAL = 256;
+
+    private:
+        /**
+         *  Kept on heap so the request can be moved while atomics and the
+         *  task stay in place
+         */
+        struct State
+        {
+            std::unique_ptr<priv::PathSearchTask<NavpointType>> task = {};
+            std::optional<dgm::Path<NavpointType>> path = {};
+            std::atomic<PathRequestStatus> status =
+                PathRequestStatus::InProgress;
+            std::atomic_bool cancelRequested = false;
+        };
+
+    private:
+        PathRequestStatus finish(PathRequestStatus status)
+        {
+            // Scratch memory of the search is no longer needed
+            state->task.reset();
+            state->status.store(status, std::memory_order_release);
+            state->status.notify_all();
+            return status;
+        }
+
+    private:
+        std::unique_ptr<State> state;
+    };
+} // namespace dgm
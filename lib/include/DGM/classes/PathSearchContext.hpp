@@ -0,0 +1,354 @@
+#pragma once
+
+#include <DGM/classes/Path.hpp>
+#include <DGM/classes/PathSearchStats.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace dgm
+{
+    class HierarchicalNavMesh;
+    class TileNavMesh;
+    class WorldNavMesh;
+
+    namespace priv
+    {
+        /**
+         *  Per-node bookkeeping of the A* search. Nodes are identified by
+         *  a dense numerical id (for navmeshes, the index of the tile),
+         *  so all records live in a single flat array.
+         *
+         *  Records are not cleared between searches. A record is only
+         *  valid if its visitedStamp matches generation of the current
+         *  search.
+         */
+        struct [[nodiscard]] AstarNodeRecord final
+        {
+            unsigned gcost = 0;
+            unsigned parent = 0;
+            std::uint32_t visitedStamp = 0;
+            std::uint32_t closedStamp = 0;
+        };
+
+        struct [[nodiscard]] AstarOpenSetEntry final
+        {
+            unsigned fcost;
+            unsigned hcost;
+            unsigned id;
+
+            /**
+             *  Ordering for std::push_heap/pop_heap so the best entry
+             *  ends up on top. Ties are broken by lower hcost and then by
+             *  lower id so the search is fully deterministic.
+             */
+            [[nodiscard]] constexpr bool
+            operator<(const AstarOpenSetEntry& other) const noexcept
+            {
+                if (fcost != other.fcost) return fcost > other.fcost;
+                if (hcost != other.hcost) return hcost > other.hcost;
+                return id > other.id;
+            }
+        };
+
+        /**
+         *  Scratch memory of the A* search
+         *
+         *  Open set is a binary heap with lazy deletion - when a node gets
+         *  cheaper, a new entry is pushed and the stale one is skipped once
+         *  it surfaces.
+         */
+        class [[nodiscard]] AstarSearchSpace final
+        {
+        public:
+            /**
+             *  Prepare the space for a new search over nodeCount nodes.
+             *  Runs in O(1) unless the space needs to grow.
+             */
+            void reset(std::size_t nodeCount)
+            {
+                if (records.size() < nodeCount) records.resize(nodeCount);
+                openSet.clear();
+
+                if (++generation == 0)
+                {
+                    // Stamps wrapped around, old records could look valid
+                    for (auto&& record : records)
+                        record = AstarNodeRecord {};
+                    generation = 1;
+                }
+            }
+
+            void reserve(std::size_t nodeCount, std::size_t openSetSize)
+            {
+                if (records.size() < nodeCount) records.resize(nodeCount);
+                openSet.reserve(openSetSize);
+            }
+
+            [[nodiscard]] bool isVisited(unsigned id) const noexcept
+            {
+                return records[id].visitedStamp == generation;
+            }
+
+            [[nodiscard]] bool isClosed(unsigned id) const noexcept
+            {
+                return records[id].closedStamp == generation;
+            }
+
+            [[nodiscard]] unsigned getGcost(unsigned id) const noexcept
+            {
+                return records[id].gcost;
+            }
+
+            [[nodiscard]] unsigned getParent(unsigned id) const noexcept
+            {
+                return records[id].parent;
+            }
+
+#ifdef PATHFINDING_STATS
+            /**
+             *  Counters are not cleared by reset, so they can span
+             *  several searches of a single query
+             */
+            void resetStats() noexcept
+            {
+                expandedNodeCount = 0;
+                generatedNodeCount = 0;
+                peakOpenSetSize = 0;
+            }
+
+            [[nodiscard]] PathSearchStats getStats() const noexcept
+            {
+                return PathSearchStats {
+                    .expandedNodeCount = expandedNodeCount,
+                    .generatedNodeCount = generatedNodeCount,
+                    .peakOpenSetSize = peakOpenSetSize,
+                };
+            }
+#endif
+
+            /**
+             *  Record a path to node id with given cost
+             *
+             *  Equally expensive paths overwrite the parent, but do not
+             *  create a duplicate entry in the open set.
+             */
+            void relax(
+                unsigned id, unsigned parent, unsigned gcost, unsigned hcost)
+            {
+                auto& record = records[id];
+                const bool visited = record.visitedStamp == generation;
+                if (visited && record.gcost < gcost) return;
+
+                record.parent = parent;
+                if (visited && record.gcost == gcost) return;
+
+                record.gcost = gcost;
+                record.visitedStamp = generation;
+                openSet.push_back(AstarOpenSetEntry {
+                    .fcost = gcost + hcost, .hcost = hcost, .id = id });
+                std::push_heap(openSet.begin(), openSet.end());
+
+#ifdef PATHFINDING_STATS
+                ++generatedNodeCount;
+                peakOpenSetSize = std::max(peakOpenSetSize, openSet.size());
+#endif
+            }
+
+            /**
+             *  Pop the best open node and close it
+             *
+             *  \return Id of the node or NO_NODE if the open set
+             *  is exhausted
+             */
+            [[nodiscard]] unsigned popBestNode()
+            {
+                while (!openSet.empty())
+                {
+                    std::pop_heap(openSet.begin(), openSet.end());
+                    const auto entry = openSet.back();
+                    openSet.pop_back();
+
+                    auto& record = records[entry.id];
+                    if (record.closedStamp == generation) continue;
+                    // Stale entry, node got cheaper since it was pushed
+                    if (entry.fcost - entry.hcost != record.gcost) continue;
+
+                    record.closedStamp = generation;
+#ifdef PATHFINDING_STATS
+                    ++expandedNodeCount;
+#endif
+                    return entry.id;
+                }
+
+                return NO_NODE;
+            }
+
+        public:
+            static constexpr unsigned NO_NODE =
+                std::numeric_limits<unsigned>::max();
+
+        private:
+            std::vector<AstarNodeRecord> records = {};
+            std::vector<AstarOpenSetEntry> openSet = {};
+            std::uint32_t generation = 0;
+
+#ifdef PATHFINDING_STATS
+            std::size_t expandedNodeCount = 0;
+            std::size_t generatedNodeCount = 0;
+            std::size_t peakOpenSetSize = 0;
+#endif
+        };
+    } // namespace priv
+
+    /**
+     *  \brief Reusable scratch memory for path queries of dgm::TileNavMesh,
+     *  dgm::WorldNavMesh and dgm::HierarchicalNavMesh
+     *
+     *  Every path query needs per-tile bookkeeping, an open set and some
+     *  temporary lists. Passing the same context to subsequent queries
+     *  reuses all of that memory, so once the context is warmed up (or
+     *  sized up front), a query only allocates the returned dgm::Path.
+     *
+     *  One context can be used with navmeshes of different sizes, it grows
+     *  as needed. A context must not be used by two queries at the same
+     *  time, use one context per thread.
+     */
+    class [[nodiscard]] PathSearchContext final
+    {
+    public:
+        PathSearchContext() = default;
+
+        /**
+         *  \brief Create a context sized for a mesh with given number of
+         *  tiles
+         */
+        explicit PathSearchContext(std::size_t tileCount)
+        {
+            reserve(tileCount);
+        }
+
+        PathSearchContext(PathSearchContext&&) = default;
+        PathSearchContext(const PathSearchContext&) = delete;
+        PathSearchContext& operator=(PathSearchContext&&) = default;
+
+    public:
+        /**
+         *  \brief Preallocate memory for meshes with up to tileCount tiles
+         *
+         *  The open set is sized heuristically, very long queries might
+         *  still grow it once.
+         */
+        void reserve(std::size_t tileCount)
+        {
+            space.reserve(tileCount, std::max<std::size_t>(tileCount / 8, 64));
+            tilePoints.reserve(std::min<std::size_t>(tileCount, 1024));
+            worldPoints.reserve(256);
+            startLinks.reserve(64);
+            goalLinks.reserve(64);
+        }
+
+#ifdef PATHFINDING_STATS
+        /**
+         *  \brief Get stats of the last query that used this context
+         */
+        [[nodiscard]] const PathSearchStats& getLastStats() const noexcept
+        {
+            return lastStats;
+        }
+#endif
+
+    private:
+        friend class HierarchicalNavMesh;
+        friend class TileNavMesh;
+        friend class WorldNavMesh;
+
+        struct [[nodiscard]] Link final
+        {
+            unsigned id;       ///< Tile index of the linked jump point
+            unsigned distance; ///< Distance to the linked jump point
+        };
+
+        priv::AstarSearchSpace space;
+        std::vector<TileNavpoint> tilePoints = {};
+        std::vector<WorldNavpoint> worldPoints = {};
+
+        /**
+         *  Connections of the query start and goal to the jump point
+         *  graph of dgm::WorldNavMesh. They are kept aside so the graph
+         *  itself does not change during a query.
+         */
+        std::vector<Link> startLinks = {};
+        std::vector<Link> goalLinks = {};
+
+        /// Distances from landmarks of dgm::WorldNavMesh to the query goal
+        std::vector<unsigned> goalLandmarkDistances = {};
+
+        /// Path through the abstract graph of dgm::HierarchicalNavMesh
+        std::vector<unsigned> nodePath = {};
+
+#ifdef PATHFINDING_STATS
+        PathSearchStats lastStats = {};
+#endif
+
+    private:
+        template<class T>
+        [[nodiscard]] static std::size_t
+        getPathLength(const std::optional<dgm::Path<T>>& path) noexcept
+        {
+            return path ? path->getLength() : 0u;
+        }
+
+        template<class T>
+        [[nodiscard]] static std::size_t
+        getPathLength(const dgm::Path<T>& path) noexcept
+        {
+            return path.getLength();
+        }
+
+        /**
+         *  Call query, which returns a path or an optional path, and
+         *  record its stats into lastStats and totals
+         *
+         *  Without PATHFINDING_STATS, only the query is called.
+         */
+        template<class Query>
+        [[nodiscard]] auto measureQuery(
+            [[maybe_unused]] priv::PathSearchTotalsCounter& totals,
+            Query&& query)
+        {
+#ifdef PATHFINDING_STATS
+            space.resetStats();
+            const auto start = std::chrono::steady_clock::now();
+            auto result = query();
+            finishStats(
+                std::chrono::steady_clock::now() - start,
+                getPathLength(result),
+                totals);
+            return result;
+#else
+            return query();
+#endif
+        }
+
+#ifdef PATHFINDING_STATS
+        /**
+         *  Store stats collected since the last space.resetStats
+         */
+        void finishStats(
+            std::chrono::nanoseconds duration,
+            std::size_t pathLength,
+            priv::PathSearchTotalsCounter& totals) noexcept
+        {
+            lastStats = space.getStats();
+            lastStats.duration = duration;
+            lastStats.pathLength = pathLength;
+            totals.add(lastStats);
+        }
+#endif
+    };
+
+} // namespace dgm
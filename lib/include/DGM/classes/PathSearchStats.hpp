@@ -0,0 +1,151 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+namespace dgm
+{
+    /**
+     *  \brief Measurements of a single path query
+     *
+     *  Only collected when the library is built with
+     *  ENABLE_PATHFINDING_STATS (PATHFINDING_STATS is defined). Otherwise
+     *  the counting code is compiled out and no getters of stats exist.
+     */
+    struct [[nodiscard]] PathSearchStats final
+    {
+        /// Number of nodes taken from the open set and closed
+        std::size_t expandedNodeCount = 0;
+
+        /// Number of entries pushed to the open set
+        std::size_t generatedNodeCount = 0;
+
+        /// Largest size of the open set, including stale entries
+        std::size_t peakOpenSetSize = 0;
+
+        /// Wall time of the query
+        std::chrono::nanoseconds duration = {};
+
+        /// Number of points of the resulting path, zero if none was found
+        std::size_t pathLength = 0;
+    };
+
+    /**
+     *  \brief Running totals of all queries of a navmesh
+     */
+    struct [[nodiscard]] PathSearchTotals final
+    {
+        std::size_t queryCount = 0;
+        std::size_t expandedNodeCount = 0;
+        std::size_t generatedNodeCount = 0;
+
+        /// Largest peak open set size of a single query
+        std::size_t peakOpenSetSize = 0;
+
+        std::chrono::nanoseconds duration = {};
+
+        /// Duration of the slowest single query
+        std::chrono::nanoseconds longestDuration = {};
+
+        std::size_t pathLength = 0;
+    };
+
+    namespace priv
+    {
+        /**
+         *  Thread-safe accumulator of PathSearchTotals
+         *
+         *  Empty unless PATHFINDING_STATS is defined. Moving copies the
+         *  current values, moved object must not be in use.
+         */
+        class [[nodiscard]] PathSearchTotalsCounter final
+        {
+        public:
+            PathSearchTotalsCounter() = default;
+
+#ifdef PATHFINDING_STATS
+            PathSearchTotalsCounter(PathSearchTotalsCounter&& other) noexcept
+            {
+                store(other.get());
+            }
+
+            PathSearchTotalsCounter&
+            operator=(PathSearchTotalsCounter&& other) noexcept
+            {
+                store(other.get());
+                return *this;
+            }
+
+        public:
+            void add(const PathSearchStats& stats) noexcept
+            {
+                constexpr auto relaxed = std::memory_order_relaxed;
+                queryCount.fetch_add(1, relaxed);
+                expandedNodeCount.fetch_add(stats.expandedNodeCount, relaxed);
+                generatedNodeCount.fetch_add(
+                    stats.generatedNodeCount, relaxed);
+                storeMax(peakOpenSetSize, stats.peakOpenSetSize);
+                duration.fetch_add(stats.duration.count(), relaxed);
+                storeMax(longestDuration, stats.duration.count());
+                pathLength.fetch_add(stats.pathLength, relaxed);
+            }
+
+            [[nodiscard]] PathSearchTotals get() const noexcept
+            {
+                constexpr auto relaxed = std::memory_order_relaxed;
+                return PathSearchTotals {
+                    .queryCount = queryCount.load(relaxed),
+                    .expandedNodeCount = expandedNodeCount.load(relaxed),
+                    .generatedNodeCount = generatedNodeCount.load(relaxed),
+                    .peakOpenSetSize = peakOpenSetSize.load(relaxed),
+                    .duration =
+                        std::chrono::nanoseconds(duration.load(relaxed)),
+                    .longestDuration =
+                        std::chrono::nanoseconds(longestDuration.load(relaxed)),
+                    .pathLength = pathLength.load(relaxed),
+                };
+            }
+
+            void reset() noexcept
+            {
+                store(PathSearchTotals {});
+            }
+
+        private:
+            template<class T>
+            static void storeMax(std::atomic<T>& target, T value) noexcept
+            {
+                T current = target.load(std::memory_order_relaxed);
+                while (current < value
+                       && !target.compare_exchange_weak(
+                           current, value, std::memory_order_relaxed))
+                    ;
+            }
+
+            void store(const PathSearchTotals& totals) noexcept
+            {
+                constexpr auto relaxed = std::memory_order_relaxed;
+                queryCount.store(totals.queryCount, relaxed);
+                expandedNodeCount.store(totals.expandedNodeCount, relaxed);
+                generatedNodeCount.store(totals.generatedNodeCount, relaxed);
+                peakOpenSetSize.store(totals.peakOpenSetSize, relaxed);
+                duration.store(totals.duration.count(), relaxed);
+                longestDuration.store(totals.longestDuration.count(), relaxed);
+                pathLength.store(totals.pathLength, relaxed);
+            }
+
+        private:
+            using Rep = std::chrono::nanoseconds::rep;
+
+            std::atomic_size_t queryCount = 0;
+            std::atomic_size_t expandedNodeCount = 0;
+            std::atomic_size_t generatedNodeCount = 0;
+            std::atomic_size_t peakOpenSetSize = 0;
+            std::atomic<Rep> duration = 0;
+            std::atomic<Rep> longestDuration = 0;
+            std::atomic_size_t pathLength = 0;
+#endif
+        };
+    } // namespace priv
+} // namespace dgm
@@ -1,8 +1,13 @@
 #pragma once
 
+#include <DGM/classes/Math.hpp>
 #include <DGM/classes/Objects.hpp>
+#include <DGM/classes/OccupancyHierarchy.hpp>
+#include <DGM/classes/SpatialBuffer.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <functional>
+#include <optional>
+#include <type_traits>
 
 namespace dgm
 {
@@ -40,6 +45,29 @@ namespace dgm
             sf::Vector2f hitLocation;  ///< Precise world-space hit position.
         };
 
+        /**
+         * @brief Kind of object hit by a combined raycast.
+         */
+        enum class [[nodiscard]] HitKind : bool
+        {
+            Tile,  ///< The ray hit a solid tile of the mesh.
+            Actor, ///< The ray hit an item of the spatial buffer.
+        };
+
+        /**
+         * @brief Result of a raycast against both a mesh and a
+         * dgm::SpatialBuffer.
+         */
+        template<class IndexType>
+        struct [[nodiscard]] CombinedResult final
+        {
+            HitKind kind;             ///< What the ray hit.
+            sf::Vector2u tile;        ///< Hit tile, valid for HitKind::Tile.
+            IndexType actorId;        ///< Hit item, valid for HitKind::Actor.
+            sf::Vector2f hitLocation; ///< Precise world-space hit position.
+            float distance;           ///< World distance from the origin.
+        };
+
     public:
         /**
          * @brief Check whether there is an unobstructed line of sight between
@@ -61,6 +89,51 @@ namespace dgm
             const sf::Vector2f& to,
             const dgm::Mesh& levelMesh);
 
+        /**
+         * @brief Check line of sight, invoking a callback for every tile the
+         * check depends on.
+         *
+         * @param[in] from                 Starting point in world coordinates.
+         * @param[in] to                   Target point in world coordinates.
+         * @param[in] levelMesh            Grid mesh defining the level
+         *                                 geometry. Tiles with value > 0 are
+         *                                 solid.
+         * @param[in] forEachTileCallback  Callback invoked with the grid
+         *                                 coordinates of each tile the ray
+         *                                 passes through, in order, up to the
+         *                                 tile containing @p to or the first
+         *                                 solid tile (inclusive).
+         * @return @c true if the path is clear, @c false if a solid tile
+         *         blocks the line of sight.
+         */
+        [[nodiscard]] static bool hasDirectVisibility(
+            const sf::Vector2f& from,
+            const sf::Vector2f& to,
+            const dgm::Mesh& levelMesh,
+            std::function<void(const sf::Vector2u&)> forEachTileCallback);
+
+        /**
+         * @brief Check line of sight, skipping over empty areas.
+         *
+         * Same as the overload without @p hierarchy, but whenever the ray
+         * enters a block that @p hierarchy marks as empty, the whole block is
+         * crossed in a single step.
+         *
+         * @param[in] from       Starting point in world coordinates.
+         * @param[in] to         Target point in world coordinates.
+         * @param[in] levelMesh  Grid mesh defining the level geometry.
+         *                       Tiles with value > 0 are solid.
+         * @param[in] hierarchy  Occupancy hierarchy built over
+         *                       @p levelMesh and kept up to date with it.
+         * @return @c true if the path is clear, @c false if a solid tile
+         *         blocks the line of sight.
+         */
+        [[nodiscard]] static bool hasDirectVisibility(
+            const sf::Vector2f& from,
+            const sf::Vector2f& to,
+            const dgm::Mesh& levelMesh,
+            const dgm::OccupancyHierarchy& hierarchy);
+
         /**
          * @brief Cast a ray and return the first solid tile it hits.
          *
@@ -99,6 +172,128 @@ namespace dgm
             const dgm::Mesh& levelMesh,
             std::function<void(const sf::Vector2u&)> forEachTileCallback);
 
+        /**
+         * @brief Cast a ray and return the first solid tile it hits,
+         * skipping over empty areas.
+         *
+         * Same as the overload without @p hierarchy, but whenever the ray
+         * enters a block that @p hierarchy marks as empty, the whole block is
+         * crossed in a single step.
+         *
+         * @param[in] origin     Ray origin in world coordinates.
+         * @param[in] direction  Ray direction (does not need to be
+         *                       normalized).
+         * @param[in] levelMesh  Grid mesh defining the level geometry.
+         *                       Tiles with value > 0 are solid.
+         * @param[in] hierarchy  Occupancy hierarchy built over
+         *                       @p levelMesh and kept up to date with it.
+         * @return A Result describing the hit tile, the boundary crossed, and
+         *         the hit location.
+         */
+        static Result raycast(
+            const sf::Vector2f& origin,
+            const sf::Vector2f& direction,
+            const dgm::Mesh& levelMesh,
+            const dgm::OccupancyHierarchy& hierarchy);
+
+        /**
+         * @brief Cast a ray through a mesh and a spatial buffer of actors and
+         * return the nearest hit of either kind.
+         *
+         * The mesh is traced first and its hit distance then limits the walk
+         * through @p actors, so only cells of the buffer that lie in front of
+         * the wall are visited.
+         *
+         * If the shooter itself is stored in @p actors, remove it from lookup
+         * before the call. On equal distances, the tile wins.
+         *
+         * @param[in] origin     Ray origin in world coordinates.
+         * @param[in] direction  Ray direction (does not need to be
+         *                       normalized, must not be zero).
+         * @param[in] levelMesh  Grid mesh defining the level geometry.
+         *                       Tiles with value > 0 are solid.
+         * @param[in] actors     Spatial buffer with dynamic objects.
+         * @param[in] getShape   Projection returning dgm::Circle or dgm::Rect
+         *                       of an actor, used for the hit test.
+         * @return A CombinedResult describing the nearest hit.
+         */
+        template<
+            class T,
+            class IndexType,
+            class GridResolutionType,
+            class ShapeProjection>
+            requires std::is_same_v<
+                         std::remove_cvref_t<
+                             std::invoke_result_t<ShapeProjection, const T&>>,
+                         dgm::Circle>
+                     || std::is_same_v<
+                         std::remove_cvref_t<
+                             std::invoke_result_t<ShapeProjection, const T&>>,
+                         dgm::Rect>
+        static CombinedResult<IndexType> raycast(
+            const sf::Vector2f& origin,
+            const sf::Vector2f& direction,
+            const dgm::Mesh& levelMesh,
+            const dgm::SpatialBuffer<T, IndexType, GridResolutionType>& actors,
+            ShapeProjection&& getShape)
+        {
+            // Ray started inside a solid tile
+            const auto originTile = sf::Vector2u(origin.componentWiseDiv(
+                sf::Vector2f(levelMesh.getVoxelSize())));
+            if (levelMesh[originTile] > 0)
+            {
+                return CombinedResult<IndexType> {
+                    .kind = HitKind::Tile,
+                    .tile = originTile,
+                    .actorId = {},
+                    .hitLocation = origin,
+                    .distance = 0.f,
+                };
+            }
+
+            const auto meshHit = raycast(origin, direction, levelMesh);
+            const auto unitDirection = dgm::Math::toUnit(direction);
+
+            auto result = CombinedResult<IndexType> {
+                .kind = HitKind::Tile,
+                .tile = meshHit.tile,
+                .actorId = {},
+                .hitLocation = meshHit.hitLocation,
+                .distance = (meshHit.hitLocation - origin).length(),
+            };
+
+            actors.forEachCellAlongRay(
+                origin,
+                unitDirection,
+                result.distance,
+                [&](const auto& ids, float cellExitDistance)
+                {
+                    for (auto&& id : ids)
+                    {
+                        const auto distance = getRayDistance(
+                            origin,
+                            unitDirection,
+                            std::invoke(getShape, actors[id]));
+                        if (!distance || *distance >= result.distance)
+                            continue;
+
+                        result = CombinedResult<IndexType> {
+                            .kind = HitKind::Actor,
+                            .tile = {},
+                            .actorId = id,
+                            .hitLocation = origin + unitDirection * *distance,
+                            .distance = *distance,
+                        };
+                    }
+
+                    // Anything in the following cells is further than the
+                    // current cell exit
+                    return result.distance > cellExitDistance;
+                });
+
+            return result;
+        }
+
     private:
         struct [[nodiscard]] RaycasterState final
         {
@@ -106,6 +301,14 @@ namespace dgm
             sf::Vector2i tileStep;
             sf::Vector2f rayStep;
             sf::Vector2f intercept; // precise hit position on tile boundary
+            sf::Vector2f firstIntercept; // intercept before any advancement
+            sf::Vector2u crossings; // number of tile boundaries crossed
+        };
+
+        struct [[nodiscard]] BlockLeap final
+        {
+            HitDirection direction; ///< Boundary crossed when leaving block
+            float exitDistance; ///< Distance at which the ray left the block
         };
 
     private:
@@ -115,6 +318,75 @@ namespace dgm
         [[nodiscard]] static HitDirection
         advanceRaycaster(RaycasterState& state);
 
+        /**
+         * Move the ray to the first tile past the largest empty block
+         * containing its current tile. Returns nothing if there is no such
+         * block.
+         */
+        [[nodiscard]] static std::optional<BlockLeap> leapOverEmptyBlock(
+            RaycasterState& state, const dgm::OccupancyHierarchy& hierarchy);
+
+        /**
+         * Count how many of the next (at most maxCount) boundary crossings
+         * on one axis happen before given distance.
+         */
+        [[nodiscard]] static unsigned countCrossingsBefore(
+            float firstIntercept,
+            unsigned crossings,
+            float rayStep,
+            unsigned maxCount,
+            float limit,
+            bool inclusive);
+
+        /**
+         * Distance from origin along unit direction to the first point of
+         * the shape. Zero if origin lies within the shape.
+         */
+        [[nodiscard]] static std::optional<float> getRayDistance(
+            const sf::Vector2f& origin,
+            const sf::Vector2f& direction,
+            const dgm::Circle& circle) noexcept;
+
+        [[nodiscard]] static std::optional<float> getRayDistance(
+            const sf::Vector2f& origin,
+            const sf::Vector2f& direction,
+            const dgm::Rect& rect) noexcept;
+
+        template<class TileCallback>
+        [[nodiscard]] static bool traceVisibility(
+            const sf::Vector2f& from,
+            const sf::Vector2f& to,
+            const dgm::Mesh& levelMesh,
+            TileCallback&& forEachTileCallback);
+
+        /**
+         * Distance at which the ray crosses a boundary after given number
+         * of crossings.
+         *
+         * Intercepts are always computed through this function instead of
+         * being accumulated, so the result does not depend on whether the
+         * ray advanced one tile at a time or leaped over a block.
+         */
+        [[nodiscard]] static float getInterceptAfter(
+            float firstIntercept, unsigned crossings, float rayStep) noexcept
+        {
+            // Avoid 0 * inf for axis-aligned rays
+            return crossings == 0 ? firstIntercept
+                                  : firstIntercept + crossings * rayStep;
+        }
+
+        /**
+         * Distance along the ray at which the ray leaves its current tile
+         */
+        [[nodiscard]] static float
+        getExitDistance(const RaycasterState& state) noexcept
+        {
+            // Same branch as in advanceRaycaster so NaNs caused by
+            // axis-aligned rays are resolved the same way
+            return state.intercept.x < state.intercept.y ? state.intercept.x
+                                                         : state.intercept.y;
+        }
+
         [[nodiscard]] static float getInterceptDistance(
             const RaycasterState& state, const HitDirection lastDirection)
         {
@@ -5,6 +5,8 @@
 #include <algorithm>
 #include <concepts>
 #include <functional>
+#include <limits>
+#include <type_traits>
 #include <vector>
 
 namespace dgm
@@ -124,6 +126,113 @@ namespace dgm
             return result;
         }
 
+        /**
+         * \brief Visit cells of the index along a ray, in the order in which
+         * the ray passes through them
+         *
+         * \param origin Origin of the ray in world coordinates
+         * \param direction Unit direction of the ray
+         * \param maxDistance Cells beginning further than this distance from
+         * origin are not visited
+         * \param callback Called as callback(ids, cellExitDistance) for each
+         * non-empty cell, ids being the items registered in that cell.
+         * Returning false stops the walk.
+         *
+         * An item can be reported by several cells. Only the part of the ray
+         * that lies within the bounding box of the index is walked.
+         */
+        template<class Callback>
+            requires std::is_invocable_r_v<
+                bool,
+                Callback,
+                const IndexListType&,
+                float>
+        void forEachCellAlongRay(
+            const sf::Vector2f& origin,
+            const sf::Vector2f& direction,
+            float maxDistance,
+            Callback&& callback) const
+        {
+            // Walking in grid space, but parametrized by world distance
+            const auto gridOrigin = sf::Vector2f(
+                (origin.x - BOUNDING_BOX.getPosition().x) * COORD_TO_GRID_X,
+                (origin.y - BOUNDING_BOX.getPosition().y) * COORD_TO_GRID_Y);
+            const auto gridDirection = sf::Vector2f(
+                direction.x * COORD_TO_GRID_X, direction.y * COORD_TO_GRID_Y);
+            const auto resolution = static_cast<float>(GRID_RESOLUTION);
+
+            // Clip the ray against the grid
+            float enter = 0.f;
+            float exit = maxDistance;
+            auto&& clip = [&](float start, float step)
+            {
+                if (step == 0.f) return start >= 0.f && start <= resolution;
+
+                const float t1 = (0.f - start) / step;
+                const float t2 = (resolution - start) / step;
+                enter = std::max(enter, std::min(t1, t2));
+                exit = std::min(exit, std::max(t1, t2));
+                return true;
+            };
+
+            if (!clip(gridOrigin.x, gridDirection.x)
+                || !clip(gridOrigin.y, gridDirection.y) || enter > exit)
+                return;
+
+            const auto entryPoint = gridOrigin + gridDirection * enter;
+            auto cell = sf::Vector2i(
+                std::clamp(
+                    static_cast<int>(entryPoint.x),
+                    0,
+                    static_cast<int>(GRID_RESOLUTION) - 1),
+                std::clamp(
+                    static_cast<int>(entryPoint.y),
+                    0,
+                    static_cast<int>(GRID_RESOLUTION) - 1));
+
+            const auto step = sf::Vector2i(
+                gridDirection.x < 0.f ? -1 : 1,
+                gridDirection.y < 0.f ? -1 : 1);
+            auto&& getNextBoundary =
+                [](int coord, int dir, float start, float delta)
+            {
+                if (delta == 0.f) return std::numeric_limits<float>::infinity();
+                return (static_cast<float>(coord + (dir > 0 ? 1 : 0)) - start)
+                       / delta;
+            };
+            auto boundary = sf::Vector2f(
+                getNextBoundary(cell.x, step.x, gridOrigin.x, gridDirection.x),
+                getNextBoundary(
+                    cell.y, step.y, gridOrigin.y, gridDirection.y));
+            const auto boundaryStep = sf::Vector2f(
+                gridDirection.x == 0.f ? 0.f : 1.f / std::abs(gridDirection.x),
+                gridDirection.y == 0.f ? 0.f : 1.f / std::abs(gridDirection.y));
+
+            while (true)
+            {
+                const float cellExit = std::min(boundary.x, boundary.y);
+                const auto& ids = grid[cell.y * GRID_RESOLUTION + cell.x];
+                if (!ids.empty() && !callback(ids, cellExit)) return;
+                if (cellExit > exit) return;
+
+                if (boundary.x < boundary.y)
+                {
+                    cell.x += step.x;
+                    boundary.x += boundaryStep.x;
+                }
+                else
+                {
+                    cell.y += step.y;
+                    boundary.y += boundaryStep.y;
+                }
+
+                if (cell.x < 0 || cell.y < 0
+                    || cell.x >= static_cast<int>(GRID_RESOLUTION)
+                    || cell.y >= static_cast<int>(GRID_RESOLUTION))
+                    return;
+            }
+        }
+
         [[nodiscard]] const constexpr dgm::Rect&
         getBoundingBox() const noexcept
         {
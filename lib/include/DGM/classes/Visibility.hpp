@@ -0,0 +1,152 @@
+#pragma once
+
+#include <DGM/classes/Objects.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+namespace dgm
+{
+
+    /**
+     * @brief Field-of-view computation over a dgm::Mesh using recursive
+     * shadowcasting.
+     *
+     * Computes the set of tiles visible from an origin within a radius in a
+     * single pass over the grid. Each tile is visited at most once per octant,
+     * unlike casting many independent rays with dgm::Raycaster which
+     * re-traverse the tiles near the origin over and over.
+     *
+     * Uses the same solidity convention as dgm::Raycaster: tiles with value
+     * > 0 are solid and block sight. Solid tiles that are lit are reported as
+     * visible so the walls bounding the visible area can be rendered. Tiles
+     * outside of the mesh are treated as solid and are never reported.
+     *
+     * All spatial parameters are specified in world coordinates, the same way
+     * as for dgm::Raycaster. Shadowcasting itself is done from the center of
+     * the tile containing the origin.
+     *
+     * The object keeps its buffers between calls to compute, so it is meant
+     * to be kept around (for example one per light source) and reused every
+     * frame.
+     */
+    class [[nodiscard]] Visibility final
+    {
+    public:
+        /**
+         * @brief Compute visible tiles and optionally the visibility polygon.
+         *
+         * Results of any previous call are discarded.
+         *
+         * @param[in] origin          Viewer position in world coordinates.
+         * @param[in] radius          Maximum view distance in world units.
+         * @param[in] levelMesh       Grid mesh defining the level geometry.
+         *                            Tiles with value > 0 are solid.
+         * @param[in] computePolygon  Whether to also build the visibility
+         *                            polygon (see getVisibilityPolygon).
+         */
+        void compute(
+            const sf::Vector2f& origin,
+            float radius,
+            const dgm::Mesh& levelMesh,
+            bool computePolygon = false);
+
+        /**
+         * @brief Get tiles visible after last call to compute.
+         *
+         * Each tile is listed exactly once, in no particular order.
+         */
+        [[nodiscard]] const std::vector<sf::Vector2u>&
+        getVisibleTiles() const noexcept
+        {
+            return visibleTiles;
+        }
+
+        /**
+         * @brief Test whether a tile was visible after last call to compute.
+         *
+         * This is an O(1) lookup.
+         */
+        [[nodiscard]] bool
+        isTileVisible(const sf::Vector2u& tile) const noexcept
+        {
+            if (tile.x >= dataSize.x || tile.y >= dataSize.y) return false;
+            return stamps[tile.y * dataSize.x + tile.x] == currentStamp;
+        }
+
+        /**
+         * @brief Get the visibility polygon computed by last call to compute.
+         *
+         * Vertices are in world coordinates, ordered counter-clockwise by
+         * angle around the origin (clockwise on screen, since y points down).
+         * The polygon is meant to be rendered as a triangle fan centered at
+         * the origin. Directions that are not blocked by any wall within
+         * radius end on a polyline approximating the view circle.
+         *
+         * Empty if polygon computation was not requested.
+         */
+        [[nodiscard]] const std::vector<sf::Vector2f>&
+        getVisibilityPolygon() const noexcept
+        {
+            return polygon;
+        }
+
+    private:
+        struct [[nodiscard]] Octant final
+        {
+            int xx, xy, yx, yy;
+        };
+
+        struct [[nodiscard]] CastContext final
+        {
+            const dgm::Mesh& mesh;
+            sf::Vector2i center;
+            sf::Vector2f voxelSize;
+            float radiusSquared;
+            int radiusInTiles;
+        };
+
+        /**
+         * Axis-aligned face of a lit solid tile, in tile units
+         */
+        struct [[nodiscard]] Face final
+        {
+            bool vertical; ///< Face lies on line x = position
+            float position;
+            float from;
+            float to;
+        };
+
+    private:
+        void castLight(
+            const CastContext& context,
+            const Octant& octant,
+            int row,
+            float startSlope,
+            float endSlope);
+
+        void markVisible(const sf::Vector2u& tile, bool solid);
+
+        void buildPolygon(
+            const sf::Vector2f& origin,
+            float radius,
+            const dgm::Mesh& levelMesh);
+
+        void collectFaces(const sf::Vector2f& origin, const dgm::Mesh& mesh);
+
+        [[nodiscard]] float getHitDistance(
+            const sf::Vector2f& origin,
+            const sf::Vector2f& direction,
+            float maxDistance) const noexcept;
+
+    private:
+        std::vector<sf::Vector2u> visibleTiles = {};
+        std::vector<sf::Vector2u> litWalls = {};
+        std::vector<sf::Vector2f> polygon = {};
+        std::vector<Face> faces = {};
+        std::vector<float> angles = {};
+        std::vector<unsigned> stamps = {};
+        sf::Vector2u dataSize = {};
+        unsigned currentStamp = 0;
+    };
+
+} // namespace dgm
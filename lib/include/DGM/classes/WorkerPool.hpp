@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace dgm
+{
+    /**
+     *  \brief Persistent threads for splitting per-frame work into tasks
+     *
+     *  \details Threads are created once and sleep between jobs, so
+     *  the pool is cheap enough to be used every frame, unlike spawning
+     *  threads for each job. A single pool can be shared by any number
+     *  of objects, for example all particle systems in a scene.
+     *
+     *  Jobs from different threads are serialized.
+     */
+    class [[nodiscard]] WorkerPool final
+    {
+    public:
+        /**
+         *  \param threadCount Number of threads working on a job, including
+         *  the one that calls forEach. With one thread, everything runs on
+         *  the calling thread and no threads are created.
+         */
+        explicit WorkerPool(
+            unsigned threadCount = std::thread::hardware_concurrency());
+
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool(WorkerPool&&) = delete;
+        ~WorkerPool() = default;
+
+    public:
+        /**
+         *  \brief Call task for each index in [0, taskCount) and wait
+         *  until all calls finish
+         *
+         *  \details Threads pick tasks one by one, calling thread included.
+         *  Tasks must not throw.
+         */
+        template<class Task>
+        void forEach(std::size_t taskCount, Task&& task)
+        {
+            using TaskType = std::remove_reference_t<Task>;
+            forEachImpl(
+                taskCount,
+                [](void* taskPtr, std::size_t index) noexcept
+                { (*static_cast<TaskType*>(taskPtr))(index); },
+                const_cast<void*>(
+                    static_cast<const void*>(std::addressof(task))));
+        }
+
+        [[nodiscard]] unsigned getThreadCount() const noexcept
+        {
+            return static_cast<unsigned>(workers.size()) + 1u;
+        }
+
+    private:
+        using TaskInvoker = void (*)(void*, std::size_t) noexcept;
+
+        void forEachImpl(
+            std::size_t taskCount, TaskInvoker invoke, void* task) noexcept;
+
+        void workerLoop(std::stop_token stopToken) noexcept;
+
+        void runTasks() noexcept;
+
+    private:
+        std::mutex jobMutex;
+        std::mutex stateMutex;
+        std::condition_variable_any jobStarted;
+        std::condition_variable jobFinished;
+
+        // Current job, modified only under stateMutex
+        std::size_t jobId = 0;
+        std::size_t taskCount = 0;
+        TaskInvoker invoke = nullptr;
+        void* task = nullptr;
+        unsigned activeWorkers = 0;
+        std::atomic_size_t nextTask = 0;
+
+        // Declared last so threads stop before the state is destroyed
+        std::vector<std::jthread> workers;
+    };
+} // namespace dgm
@@ -27,16 +27,34 @@
 #include "classes/TileMap.hpp"
 #include "classes/Time.hpp"
 #include "classes/Window.hpp"
+#include "classes/WorkerPool.hpp"
 
 // Particle Systems
 #include "classes/Particle.hpp"
+#include "classes/ParticleBuffer.hpp"
+#include "classes/ParticleEffect.hpp"
+#include "classes/ParticleEffectSystem.hpp"
+#include "classes/ParticleKernels.hpp"
+#include "classes/ParticleSystem.hpp"
 #include "classes/ParticleSystemInterface.hpp"
 #include "classes/ParticleSystemRenderer.hpp"
 
 // Navigation
+#include "classes/ClearanceMap.hpp"
+#include "classes/ConnectedComponents.hpp"
+#include "classes/FlowField.hpp"
+#include "classes/HierarchicalNavMesh.hpp"
+#include "classes/LandmarkHeuristic.hpp"
+#include "classes/LineOfSightCache.hpp"
+#include "classes/MovingAiLoader.hpp"
 #include "classes/NavMesh.hpp"
+#include "classes/OccupancyHierarchy.hpp"
 #include "classes/Path.hpp"
+#include "classes/PathRequest.hpp"
+#include "classes/PathSearchContext.hpp"
+#include "classes/PathSearchStats.hpp"
 #include "classes/Raycaster.hpp"
+#include "classes/Visibility.hpp"
 
 // Helpers
 #include "classes/Traits.hpp"
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <DGM/classes/PathSearchContext.hpp>
+#include <cstddef>
+#include <limits>
+
+namespace dgm
+{
+
+    namespace priv
+    {
+        enum class [[nodiscard]] AstarStatus
+        {
+            InProgress,
+            GoalReached,
+            Exhausted
+        };
+
+        /**
+         *  Prepare a resumable A* search from start, see astarExpand
+         *
+         *  \param space Scratch memory, reset by this function
+         *  \param heuristic Callable unsigned(unsigned id)
+         */
+        template<class Heuristic>
+        void astarBegin(
+            AstarSearchSpace& space,
+            std::size_t nodeCount,
+            unsigned start,
+            Heuristic&& heuristic)
+        {
+            space.reset(nodeCount);
+            space.relax(start, start, 0, heuristic(start));
+        }
+
+        /**
+         *  Continue A* search started by astarBegin, expanding at most
+         *  maxExpansions nodes
+         *
+         *  All state lives in the space, so the search can be resumed by
+         *  another call as long as the space is not used in between.
+         *
+         *  \param forEachNeighbor Callable void(unsigned id, Callback visit)
+         *  that calls visit(neighborId, edgeCost) for every neighbor of id
+         *
+         *  \return InProgress if the budget ran out before the search ended
+         */
+        template<class Heuristic, class ForEachNeighbor>
+        [[nodiscard]] AstarStatus astarExpand(
+            AstarSearchSpace& space,
+            unsigned goal,
+            Heuristic&& heuristic,
+            ForEachNeighbor&& forEachNeighbor,
+            std::size_t maxExpansions)
+        {
+            for (std::size_t i = 0; i < maxExpansions; ++i)
+            {
+                const unsigned id = space.popBestNode();
+                if (id == AstarSearchSpace::NO_NODE)
+                    return AstarStatus::Exhausted;
+                if (id == goal) return AstarStatus::GoalReached;
+
+                const unsigned gcost = space.getGcost(id);
+                forEachNeighbor(
+                    id,
+                    [&](unsigned neighbor, unsigned cost)
+                    {
+                        if (space.isClosed(neighbor)) return;
+                        space.relax(
+                            neighbor, id, gcost + cost, heuristic(neighbor));
+                    });
+            }
+
+            return AstarStatus::InProgress;
+        }
+
+        /**
+         *  Generic A* over nodes with dense ids
+         *
+         *  \param space Scratch memory, reset by this function
+         *  \param heuristic Callable unsigned(unsigned id)
+         *  \param forEachNeighbor Callable void(unsigned id, Callback visit)
+         *  that calls visit(neighborId, edgeCost) for every neighbor of id
+         *
+         *  \return True if goal was reached. Path can be then reconstructed
+         *  by following AstarSearchSpace::getParent from goal to start.
+         */
+        template<class Heuristic, class ForEachNeighbor>
+        [[nodiscard]] bool astarSearch(
+            AstarSearchSpace& space,
+            std::size_t nodeCount,
+            unsigned start,
+            unsigned goal,
+            Heuristic&& heuristic,
+            ForEachNeighbor&& forEachNeighbor)
+        {
+            astarBegin(space, nodeCount, start, heuristic);
+            return astarExpand(
+                       space,
+                       goal,
+                       heuristic,
+                       forEachNeighbor,
+                       std::numeric_limits<std::size_t>::max())
+                   == AstarStatus::GoalReached;
+        }
+    } // namespace priv
+
+} // namespace dgm
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <AstarSearch.hpp>
+#include <DGM/classes/LandmarkHeuristic.hpp>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace dgm
+{
+
+    namespace priv
+    {
+        /**
+         *  Pick landmarks by farthest point sampling and compute their
+         *  distances to all nodes
+         *
+         *  Distances are computed by A* with zero heuristic (Dijkstra)
+         *  running until the open set is exhausted. All landmarks lie in
+         *  the largest connected area. The first one is the node farthest
+         *  from where the area was found, each next one is the node
+         *  farthest from all landmarks picked so far.
+         *
+         *  \param isNode Callable bool(unsigned id), false for ids that do
+         *  not represent a node of the graph (e.g. impassable tiles)
+         *  \param forEachNeighbor Same as in astarExpand, edges must be
+         *  symmetric
+         */
+        template<class IsNode, class ForEachNeighbor>
+        [[nodiscard]] LandmarkDistances computeLandmarkDistances(
+            std::size_t nodeCount,
+            unsigned landmarkCount,
+            IsNode&& isNode,
+            ForEachNeighbor&& forEachNeighbor)
+        {
+            constexpr unsigned UNREACHABLE = LandmarkDistances::UNREACHABLE;
+
+            // Nodes are expanded in order of their distance, so the last
+            // one is the farthest
+            auto&& space = AstarSearchSpace();
+            auto&& expanded = std::vector<unsigned>();
+            auto&& zero = [](unsigned) { return 0u; };
+            auto&& runDijkstra = [&](unsigned source)
+            {
+                expanded.clear();
+                astarBegin(space, nodeCount, source, zero);
+                (void)astarExpand(
+                    space,
+                    AstarSearchSpace::NO_NODE,
+                    zero,
+                    [&](unsigned id, auto&& visit)
+                    {
+                        expanded.push_back(id);
+                        forEachNeighbor(id, visit);
+                    },
+                    std::numeric_limits<std::size_t>::max());
+            };
+
+            unsigned candidate = AstarSearchSpace::NO_NODE;
+            std::size_t largestAreaSize = 0;
+            auto&& isCovered = std::vector<bool>(nodeCount, false);
+            for (unsigned id = 0; id < nodeCount; ++id)
+            {
+                if (isCovered[id] || !isNode(id)) continue;
+
+                runDijkstra(id);
+                for (auto&& node : expanded)
+                    isCovered[node] = true;
+                if (expanded.size() > largestAreaSize)
+                {
+                    largestAreaSize = expanded.size();
+                    candidate = expanded.back();
+                }
+            }
+
+            if (candidate == AstarSearchSpace::NO_NODE || landmarkCount == 0)
+                return LandmarkDistances();
+
+            // Rows are laid out for all landmarks, compacted at the end
+            // if the area has fewer nodes than landmarks
+            const std::size_t stride = landmarkCount;
+            auto&& landmarks = std::vector<unsigned>();
+            auto&& distances =
+                std::vector<unsigned>(nodeCount * stride, UNREACHABLE);
+            auto&& minDistances =
+                std::vector<unsigned>(nodeCount, UNREACHABLE);
+
+            while (landmarks.size() < stride)
+            {
+                const std::size_t column = landmarks.size();
+                landmarks.push_back(candidate);
+                runDijkstra(candidate);
+
+                unsigned farthest = 0;
+                for (auto&& id : expanded)
+                {
+                    const unsigned distance = space.getGcost(id);
+                    distances[id * stride + column] = distance;
+                    if (distance < minDistances[id])
+                        minDistances[id] = distance;
+                    if (minDistances[id] > farthest)
+                    {
+                        farthest = minDistances[id];
+                        candidate = id;
+                    }
+                }
+
+                // Every node of the area already is a landmark
+                if (farthest == 0) break;
+            }
+
+            if (landmarks.size() < stride)
+            {
+                const std::size_t count = landmarks.size();
+                for (std::size_t id = 0; id < nodeCount; ++id)
+                {
+                    for (std::size_t i = 0; i < count; ++i)
+                        distances[id * count + i] = distances[id * stride + i];
+                }
+                distances.resize(nodeCount * count);
+            }
+
+            return LandmarkDistances(
+                std::move(landmarks), std::move(distances));
+        }
+    } // namespace priv
+
+} // namespace dgm
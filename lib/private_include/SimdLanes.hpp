@@ -0,0 +1,254 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define DGM_SIMD_AVX
+#elif defined(__SSE2__) || defined(_M_X64)                                     \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DGM_SIMD_SSE2
+#endif
+
+namespace dgm
+{
+
+    namespace priv
+    {
+
+        /**
+         *  Single float with the same interface as vector lanes, used for
+         *  tails of columns and on platforms without SIMD
+         */
+        struct [[nodiscard]] ScalarLanes final
+        {
+            static constexpr std::size_t WIDTH = 1;
+            static constexpr const char* INSTRUCTION_SET = "scalar";
+
+            using Mask = bool;
+
+            float value;
+
+            static ScalarLanes load(const float* data) noexcept
+            {
+                return { *data };
+            }
+
+            static ScalarLanes broadcast(float value) noexcept
+            {
+                return { value };
+            }
+
+            void store(float* data) const noexcept
+            {
+                *data = value;
+            }
+
+            friend ScalarLanes operator+(ScalarLanes a, ScalarLanes b) noexcept
+            {
+                return { a.value + b.value };
+            }
+
+            friend ScalarLanes operator-(ScalarLanes a, ScalarLanes b) noexcept
+            {
+                return { a.value - b.value };
+            }
+
+            friend ScalarLanes operator*(ScalarLanes a, ScalarLanes b) noexcept
+            {
+                return { a.value * b.value };
+            }
+
+            friend ScalarLanes operator/(ScalarLanes a, ScalarLanes b) noexcept
+            {
+                return { a.value / b.value };
+            }
+
+            friend Mask operator>(ScalarLanes a, ScalarLanes b) noexcept
+            {
+                return a.value > b.value;
+            }
+
+            friend Mask operator<(ScalarLanes a, ScalarLanes b) noexcept
+            {
+                return a.value < b.value;
+            }
+
+            /**
+             *  Round half to even, like the vector conversions
+             */
+            friend ScalarLanes round(ScalarLanes a) noexcept
+            {
+                return { std::nearbyint(a.value) };
+            }
+
+            friend ScalarLanes
+            select(Mask mask, ScalarLanes a, ScalarLanes b) noexcept
+            {
+                return mask ? a : b;
+            }
+        };
+
+#if defined(DGM_SIMD_AVX)
+        struct [[nodiscard]] VectorLanes final
+        {
+            static constexpr std::size_t WIDTH = 8;
+            static constexpr const char* INSTRUCTION_SET = "AVX";
+
+            using Mask = __m256;
+
+            __m256 value;
+
+            static VectorLanes load(const float* data) noexcept
+            {
+                return { _mm256_loadu_ps(data) };
+            }
+
+            static VectorLanes broadcast(float value) noexcept
+            {
+                return { _mm256_set1_ps(value) };
+            }
+
+            void store(float* data) const noexcept
+            {
+                _mm256_storeu_ps(data, value);
+            }
+
+            friend VectorLanes operator+(VectorLanes a, VectorLanes b) noexcept
+            {
+                return { _mm256_add_ps(a.value, b.value) };
+            }
+
+            friend VectorLanes operator-(VectorLanes a, VectorLanes b) noexcept
+            {
+                return { _mm256_sub_ps(a.value, b.value) };
+            }
+
+            friend VectorLanes operator*(VectorLanes a, VectorLanes b) noexcept
+            {
+                return { _mm256_mul_ps(a.value, b.value) };
+            }
+
+            friend VectorLanes operator/(VectorLanes a, VectorLanes b) noexcept
+            {
+                return { _mm256_div_ps(a.value, b.value) };
+            }
+
+            friend Mask operator>(VectorLanes a, VectorLanes b) noexcept
+            {
+                return _mm256_cmp_ps(a.value, b.value, _CMP_GT_OQ);
+            }
+
+            friend Mask operator<(VectorLanes a, VectorLanes b) noexcept
+            {
+                return _mm256_cmp_ps(a.value, b.value, _CMP_LT_OQ);
+            }
+
+            friend VectorLanes round(VectorLanes a) noexcept
+            {
+                return { _mm256_round_ps(
+                    a.value, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC) };
+            }
+
+            friend VectorLanes
+            select(Mask mask, VectorLanes a, VectorLanes b) noexcept
+            {
+                return { _mm256_blendv_ps(b.value, a.value, mask) };
+            }
+        };
+#elif defined(DGM_SIMD_SSE2)
+        struct [[nodiscard]] VectorLanes final
+        {
+            static constexpr std::size_t WIDTH = 4;
+            static constexpr const char* INSTRUCTION_SET = "SSE2";
+
+            using Mask = __m128;
+
+            __m128 value;
+
+            static VectorLanes load(const float* data) noexcept
+            {
+                return { _mm_loadu_ps(data) };
+            }
+
+            static VectorLanes broadcast(float value) noexcept
+            {
+                return { _mm_set1_ps(value) };
+            }
+
+            void store(float* data) const noexcept
+            {
+                _mm_storeu_ps(data, value);
+            }
+
+            friend VectorLanes operator+(VectorLanes a, VectorLanes b) noexcept
+            {
+                return { _mm_add_ps(a.value, b.value) };
+            }
+
+            friend VectorLanes operator-(VectorLanes a, VectorLanes b) noexcept
+            {
+                return { _mm_sub_ps(a.value, b.value) };
+            }
+
+            friend VectorLanes operator*(VectorLanes a, VectorLanes b) noexcept
+            {
+                return { _mm_mul_ps(a.value, b.value) };
+            }
+
+            friend VectorLanes operator/(VectorLanes a, VectorLanes b) noexcept
+            {
+                return { _mm_div_ps(a.value, b.value) };
+            }
+
+            friend Mask operator>(VectorLanes a, VectorLanes b) noexcept
+            {
+                return _mm_cmpgt_ps(a.value, b.value);
+            }
+
+            friend Mask operator<(VectorLanes a, VectorLanes b) noexcept
+            {
+                return _mm_cmplt_ps(a.value, b.value);
+            }
+
+            /**
+             *  Conversion to integers rounds half to even by default,
+             *  values must fit into int32
+             */
+            friend VectorLanes round(VectorLanes a) noexcept
+            {
+                return { _mm_cvtepi32_ps(_mm_cvtps_epi32(a.value)) };
+            }
+
+            friend VectorLanes
+            select(Mask mask, VectorLanes a, VectorLanes b) noexcept
+            {
+                return { _mm_or_ps(
+                    _mm_and_ps(mask, a.value), _mm_andnot_ps(mask, b.value)) };
+            }
+        };
+#else
+        using VectorLanes = ScalarLanes;
+#endif
+
+        /**
+         *  Run op over [0, count) with vector lanes and finish the tail
+         *  that does not fill whole lanes with scalars. Op receives the
+         *  lane type as a template argument and the starting index.
+         */
+        template<class Op>
+        void forEachLanes(std::size_t count, Op&& op) noexcept
+        {
+            const std::size_t vectorEnd = count - count % VectorLanes::WIDTH;
+            std::size_t i = 0;
+            for (; i < vectorEnd; i += VectorLanes::WIDTH)
+                op.template operator()<VectorLanes>(i);
+            for (; i < count; ++i)
+                op.template operator()<ScalarLanes>(i);
+        }
+
+    } // namespace priv
+
+} // namespace dgm
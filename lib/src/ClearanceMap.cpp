@@ -0,0 +1,92 @@
+#include <DGM/classes/ClearanceMap.hpp>
+#include <algorithm>
+#include <cassert>
+
+dgm::ClearanceMap::ClearanceMap(const dgm::Mesh& mesh, unsigned maxClearance)
+    : dataSize(mesh.getDataSize())
+    , maxClearance(maxClearance)
+    , values(static_cast<std::size_t>(dataSize.x) * dataSize.y, 0)
+{
+    assert(maxClearance > 0 && maxClearance <= 255);
+    if (dataSize.x == 0 || dataSize.y == 0) return;
+    recompute(mesh, { 0u, 0u }, { dataSize.x - 1, dataSize.y - 1 });
+}
+
+void dgm::ClearanceMap::updateRegion(
+    const dgm::Mesh& mesh, const sf::Rect<unsigned>& region)
+{
+    assert(mesh.getDataSize() == dataSize);
+    if (region.size.x == 0 || region.size.y == 0) return;
+    if (region.position.x >= dataSize.x || region.position.y >= dataSize.y)
+        return;
+
+    // Tile farther than maxClearance - 1 from the change either keeps
+    // a closer obstacle or stays capped
+    const unsigned margin = maxClearance - 1;
+    const auto min = sf::Vector2u(
+        region.position.x - std::min(region.position.x, margin),
+        region.position.y - std::min(region.position.y, margin));
+    const auto last = sf::Vector2u(
+        region.position.x + region.size.x - 1,
+        region.position.y + region.size.y - 1);
+    const auto max = sf::Vector2u(
+        std::min(last.x + margin, dataSize.x - 1),
+        std::min(last.y + margin, dataSize.y - 1));
+    recompute(mesh, min, max);
+}
+
+void dgm::ClearanceMap::recompute(
+    const dgm::Mesh& mesh, const sf::Vector2u& min, const sf::Vector2u& max)
+{
+    // Outside of the mesh counts as an obstacle
+    auto&& get = [&](unsigned x, unsigned y) -> unsigned
+    {
+        if (x >= dataSize.x || y >= dataSize.y) return 0;
+        return values[getIndex({ x, y })];
+    };
+
+    for (unsigned y = min.y; y <= max.y; ++y)
+    {
+        for (unsigned x = min.x; x <= max.x; ++x)
+        {
+            const auto index = getIndex({ x, y });
+            values[index] =
+                static_cast<std::uint8_t>(mesh[index] > 0 ? 0 : maxClearance);
+        }
+    }
+
+    // Two raster scans of the chessboard distance transform, tiles around
+    // the bounds act as fixed sources. Unsigned wraparound of x - 1 and
+    // y - 1 lands outside of the mesh.
+    for (unsigned y = min.y; y <= max.y; ++y)
+    {
+        for (unsigned x = min.x; x <= max.x; ++x)
+        {
+            auto& value = values[getIndex({ x, y })];
+            if (value == 0) continue;
+            const unsigned neighbor = std::min(
+                { get(x - 1, y),
+                  get(x - 1, y - 1),
+                  get(x, y - 1),
+                  get(x + 1, y - 1) });
+            value = static_cast<std::uint8_t>(
+                std::min<unsigned>(value, neighbor + 1));
+        }
+    }
+
+    for (unsigned y = max.y + 1; y-- > min.y;)
+    {
+        for (unsigned x = max.x + 1; x-- > min.x;)
+        {
+            auto& value = values[getIndex({ x, y })];
+            if (value == 0) continue;
+            const unsigned neighbor = std::min(
+                { get(x + 1, y),
+                  get(x + 1, y + 1),
+                  get(x, y + 1),
+                  get(x - 1, y + 1) });
+            value = static_cast<std::uint8_t>(
+                std::min<unsigned>(value, neighbor + 1));
+        }
+    }
+}
@@ -0,0 +1,254 @@
+#include <DGM/classes/ConnectedComponents.hpp>
+#include <algorithm>
+
+namespace
+{
+    // Temporary label of passable tiles during construction
+    constexpr unsigned UNLABELED = dgm::ConnectedComponents::NO_COMPONENT - 1;
+} // namespace
+
+dgm::ConnectedComponents::ConnectedComponents(const dgm::Mesh& mesh)
+    : dataSize(mesh.getDataSize())
+{
+    const std::size_t tileCount =
+        static_cast<std::size_t>(dataSize.x) * dataSize.y;
+    labels.resize(tileCount, NO_COMPONENT);
+    visitStamps.resize(tileCount, 0);
+    visitOwners.resize(tileCount, 0);
+
+    for (std::size_t i = 0; i < tileCount; ++i)
+    {
+        if (mesh[i] <= 0) labels[i] = UNLABELED;
+    }
+
+    for (unsigned i = 0; i < tileCount; ++i)
+    {
+        if (labels[i] == UNLABELED) relabel(i, createLabel());
+    }
+}
+
+void dgm::ConnectedComponents::updateTile(
+    const dgm::Mesh& mesh, const sf::Vector2u& tile)
+{
+    const auto index = static_cast<unsigned>(getIndex(tile));
+    const bool wasPassable = labels[index] != NO_COMPONENT;
+    const bool isPassable = mesh[tile] <= 0;
+
+    if (!wasPassable && isPassable)
+        onTileOpened(index);
+    else if (wasPassable && !isPassable)
+        onTileClosed(index);
+}
+
+template<class Callback>
+void dgm::ConnectedComponents::forEachPassableNeighbor(
+    unsigned index, Callback&& callback) const
+{
+    const unsigned x = index % dataSize.x;
+    const unsigned y = index / dataSize.x;
+
+    if (y > 0 && labels[index - dataSize.x] != NO_COMPONENT)
+        callback(index - dataSize.x);
+    if (y + 1 < dataSize.y && labels[index + dataSize.x] != NO_COMPONENT)
+        callback(index + dataSize.x);
+    if (x > 0 && labels[index - 1] != NO_COMPONENT) callback(index - 1);
+    if (x + 1 < dataSize.x && labels[index + 1] != NO_COMPONENT)
+        callback(index + 1);
+}
+
+unsigned dgm::ConnectedComponents::createLabel()
+{
+    if (!freeLabels.empty())
+    {
+        const unsigned label = freeLabels.back();
+        freeLabels.pop_back();
+        return label;
+    }
+
+    componentSizes.push_back(0);
+    return static_cast<unsigned>(componentSizes.size() - 1);
+}
+
+void dgm::ConnectedComponents::releaseLabel(unsigned label)
+{
+    componentSizes[label] = 0;
+    freeLabels.push_back(label);
+}
+
+void dgm::ConnectedComponents::relabel(unsigned start, unsigned label)
+{
+    const unsigned oldLabel = labels[start];
+    labels[start] = label;
+    queue.clear();
+    queue.push_back(start);
+
+    for (std::size_t head = 0; head < queue.size(); ++head)
+    {
+        forEachPassableNeighbor(
+            queue[head],
+            [&](unsigned neighbor)
+            {
+                if (labels[neighbor] != oldLabel) return;
+                labels[neighbor] = label;
+                queue.push_back(neighbor);
+            });
+    }
+
+    componentSizes[label] += static_cast<unsigned>(queue.size());
+}
+
+void dgm::ConnectedComponents::onTileOpened(unsigned index)
+{
+    // Distinct components around the tile, each with one of its tiles
+    auto&& joined = std::array<std::pair<unsigned, unsigned>, 4> {};
+    std::size_t joinedCount = 0;
+    forEachPassableNeighbor(
+        index,
+        [&](unsigned neighbor)
+        {
+            const unsigned label = labels[neighbor];
+            const auto end = joined.begin() + joinedCount;
+            if (std::find_if(
+                    joined.begin(),
+                    end,
+                    [&](auto&& item) { return item.first == label; })
+                == end)
+                joined[joinedCount++] = { label, neighbor };
+        });
+
+    if (joinedCount == 0)
+    {
+        labels[index] = createLabel();
+        componentSizes[labels[index]] = 1;
+        return;
+    }
+
+    // Largest component keeps its label, the others are merged into it
+    const auto largest = *std::max_element(
+        joined.begin(),
+        joined.begin() + joinedCount,
+        [&](auto&& a, auto&& b)
+        { return componentSizes[a.first] < componentSizes[b.first]; });
+
+    for (std::size_t i = 0; i < joinedCount; ++i)
+    {
+        const auto [label, tile] = joined[i];
+        if (label == largest.first) continue;
+
+        relabel(tile, largest.first);
+        releaseLabel(label);
+    }
+
+    labels[index] = largest.first;
+    ++componentSizes[largest.first];
+}
+
+void dgm::ConnectedComponents::onTileClosed(unsigned index)
+{
+    const unsigned label = labels[index];
+    labels[index] = NO_COMPONENT;
+
+    auto&& seeds = std::array<unsigned, 4> {};
+    std::size_t seedCount = 0;
+    forEachPassableNeighbor(
+        index, [&](unsigned neighbor) { seeds[seedCount++] = neighbor; });
+
+    if (seedCount == 0)
+    {
+        releaseLabel(label);
+        return;
+    }
+
+    --componentSizes[label];
+    if (seedCount == 1) return;
+
+    if (++stamp == 0)
+    {
+        // Stamps wrapped around, old marks could look valid
+        std::fill(visitStamps.begin(), visitStamps.end(), 0);
+        stamp = 1;
+    }
+
+    /**
+     *  Each neighbor starts its own search and the searches advance in
+     *  lockstep. Searches that meet are joined into a group. A group that
+     *  runs out of tiles before meeting the others is a component that
+     *  split off and gets a new label. Once a single group is left, it
+     *  keeps the original label without being explored any further.
+     */
+    auto&& groups = std::array<std::size_t, 4> { 0, 1, 2, 3 };
+    auto&& finished = std::array<bool, 4> {};
+    auto&& heads = std::array<std::size_t, 4> {};
+    auto&& findGroup = [&](std::size_t i)
+    {
+        while (groups[i] != i)
+            i = groups[i];
+        return i;
+    };
+
+    for (std::size_t i = 0; i < seedCount; ++i)
+    {
+        splitQueues[i].clear();
+        splitQueues[i].push_back(seeds[i]);
+        visitStamps[seeds[i]] = stamp;
+        visitOwners[seeds[i]] = static_cast<std::uint8_t>(i);
+    }
+
+    std::size_t activeGroupCount = seedCount;
+    while (activeGroupCount > 1)
+    {
+        for (std::size_t i = 0; i < seedCount; ++i)
+        {
+            if (heads[i] == splitQueues[i].size()) continue;
+
+            forEachPassableNeighbor(
+                splitQueues[i][heads[i]++],
+                [&](unsigned neighbor)
+                {
+                    if (visitStamps[neighbor] != stamp)
+                    {
+                        visitStamps[neighbor] = stamp;
+                        visitOwners[neighbor] = static_cast<std::uint8_t>(i);
+                        splitQueues[i].push_back(neighbor);
+                        return;
+                    }
+
+                    const auto a = findGroup(visitOwners[neighbor]);
+                    const auto b = findGroup(i);
+                    if (a == b) return;
+                    groups[a] = b;
+                    --activeGroupCount;
+                });
+        }
+
+        for (std::size_t root = 0;
+             root < seedCount && activeGroupCount > 1;
+             ++root)
+        {
+            if (finished[root] || findGroup(root) != root) continue;
+
+            bool exhausted = true;
+            for (std::size_t i = 0; i < seedCount; ++i)
+            {
+                if (findGroup(i) == root)
+                    exhausted = exhausted && heads[i] == splitQueues[i].size();
+            }
+            if (!exhausted) continue;
+
+            const unsigned newLabel = createLabel();
+            for (std::size_t i = 0; i < seedCount; ++i)
+            {
+                if (findGroup(i) != root) continue;
+                for (auto&& tile : splitQueues[i])
+                    labels[tile] = newLabel;
+
+                const auto size = static_cast<unsigned>(splitQueues[i].size());
+                componentSizes[newLabel] += size;
+                componentSizes[label] -= size;
+            }
+
+            finished[root] = true;
+            --activeGroupCount;
+        }
+    }
+}
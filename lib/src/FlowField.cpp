@@ -0,0 +1,97 @@
+#include <DGM/classes/FlowField.hpp>
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+void dgm::FlowField::compute(
+    std::span<const sf::Vector2u> goals, const dgm::Mesh& mesh)
+{
+    dataSize = mesh.getDataSize();
+    voxelSize = mesh.getVoxelSize();
+
+    const std::size_t tileCount =
+        static_cast<std::size_t>(dataSize.x) * dataSize.y;
+    distances.assign(tileCount, UNREACHABLE_DISTANCE);
+    directions.assign(tileCount, NO_DIRECTION);
+    openSet.clear();
+
+    auto&& isPassable = [&](int x, int y)
+    {
+        return x >= 0 && y >= 0 && static_cast<unsigned>(x) < dataSize.x
+               && static_cast<unsigned>(y) < dataSize.y
+               && mesh[sf::Vector2u(x, y)] <= 0;
+    };
+
+    for (auto&& goal : goals)
+    {
+        if (!isInside(goal) || mesh[goal] > 0) continue;
+
+        const auto index = static_cast<unsigned>(getIndex(goal));
+        if (distances[index] == 0.f) continue;
+
+        distances[index] = 0.f;
+        openSet.push_back(OpenSetEntry { .distance = 0.f, .index = index });
+        std::push_heap(openSet.begin(), openSet.end());
+    }
+
+    // Expanding from the goals, each tile that relaxes a neighbor becomes
+    // the next step of that neighbor. Directions point back towards the
+    // tile the expansion came from.
+    while (!openSet.empty())
+    {
+        std::pop_heap(openSet.begin(), openSet.end());
+        const auto entry = openSet.back();
+        openSet.pop_back();
+
+        // Stale entry, tile got closer since it was pushed
+        if (entry.distance > distances[entry.index]) continue;
+
+        const int x = static_cast<int>(entry.index % dataSize.x);
+        const int y = static_cast<int>(entry.index / dataSize.x);
+
+        for (std::uint8_t dir = 0; dir < OFFSETS.size(); ++dir)
+        {
+            const auto& offset = OFFSETS[dir];
+            const int nx = x + offset.x;
+            const int ny = y + offset.y;
+            if (!isPassable(nx, ny)) continue;
+
+            const bool diagonal = offset.x != 0 && offset.y != 0;
+            if (diagonal && !(isPassable(nx, y) && isPassable(x, ny)))
+                continue;
+
+            const float stepCost =
+                diagonal ? std::numbers::sqrt2_v<float> : 1.f;
+            const float distance = entry.distance + stepCost;
+            const auto neighbor = static_cast<unsigned>(
+                static_cast<unsigned>(ny) * dataSize.x + nx);
+            if (distance >= distances[neighbor]) continue;
+
+            distances[neighbor] = distance;
+            // Opposite direction has index shifted by two within its group
+            directions[neighbor] = (dir & 4) | ((dir + 2) & 3);
+            openSet.push_back(
+                OpenSetEntry { .distance = distance, .index = neighbor });
+            std::push_heap(openSet.begin(), openSet.end());
+        }
+    }
+}
+
+sf::Vector2f
+dgm::FlowField::getFlowVector(const sf::Vector2f& position) const noexcept
+{
+    if (position.x < 0.f || position.y < 0.f) return {};
+
+    const auto tile = sf::Vector2u(
+        static_cast<unsigned>(position.x) / voxelSize.x,
+        static_cast<unsigned>(position.y) / voxelSize.y);
+    const auto direction = getDirection(tile);
+    if (direction == sf::Vector2i {}) return {};
+
+    const auto next = getNextTile(tile);
+    const auto target = sf::Vector2f(
+        (next.x + 0.5f) * voxelSize.x, (next.y + 0.5f) * voxelSize.y);
+    const auto delta = target - position;
+    const float length = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+    return length > 0.f ? delta / length : sf::Vector2f {};
+}
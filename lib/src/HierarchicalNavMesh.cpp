@@ -0,0 +1,428 @@
+#include <AstarSearch.hpp>
+#include <DGM/classes/HierarchicalNavMesh.hpp>
+#include <algorithm>
+
+namespace
+{
+    // Borders shorter than this get a single transition in the middle,
+    // longer ones get a transition at each end
+    constexpr unsigned MAX_SINGLE_TRANSITION_LENGTH = 6u;
+
+    [[nodiscard]] unsigned
+    getManhattanDistance(const sf::Vector2u& a, const sf::Vector2u& b) noexcept
+    {
+        return (a.x < b.x ? b.x - a.x : a.x - b.x)
+               + (a.y < b.y ? b.y - a.y : a.y - b.y);
+    }
+} // namespace
+
+dgm::HierarchicalNavMesh::HierarchicalNavMesh(
+    dgm::Mesh _mesh, unsigned _clusterSize)
+    : mesh(std::move(_mesh))
+    , clusterSize(std::max(_clusterSize, 1u))
+    , clusterCount(
+          (mesh.getDataSize().x + clusterSize - 1) / clusterSize,
+          (mesh.getDataSize().y + clusterSize - 1) / clusterSize)
+{
+    clusterEntrances.resize(clusterCount.x * clusterCount.y);
+    discoverEntrances();
+    connectEntrancesWithinClusters();
+}
+
+std::optional<dgm::Path<dgm::TileNavpoint>>
+dgm::HierarchicalNavMesh::computeTilePath(
+    const sf::Vector2u& from, const sf::Vector2u& to) const
+{
+    auto&& context = PathSearchContext();
+    return computeTilePath(from, to, context);
+}
+
+std::optional<dgm::Path<dgm::TileNavpoint>>
+dgm::HierarchicalNavMesh::computeTilePath(
+    const sf::Vector2u& from,
+    const sf::Vector2u& to,
+    PathSearchContext& context) const
+{
+    auto& points = context.tilePoints;
+    points.clear();
+
+    const auto& size = mesh.getDataSize();
+    if (from.x >= size.x || from.y >= size.y || to.x >= size.x
+        || to.y >= size.y)
+        return std::nullopt;
+    else if (mesh[from] > 0 || mesh[to] > 0)
+        return std::nullopt;
+    else if (from == to)
+        return dgm::Path<TileNavpoint>({}, false);
+
+    // Within a single cluster, a local search is much cheaper than going
+    // through the abstract graph. It might miss a path that leaves the
+    // cluster, in which case the abstract search is used.
+    if (getClusterIndex(from) == getClusterIndex(to)
+        && appendClusterPath(from, to, context))
+        return dgm::Path<TileNavpoint>(points, false);
+
+    auto& space = context.space;
+    linkToClusterEntrances(from, space, context.startLinks);
+    linkToClusterEntrances(to, space, context.goalLinks);
+    if (context.startLinks.empty() || context.goalLinks.empty())
+        return std::nullopt;
+
+    // Start and goal get ids right after the entrances
+    const auto startId = static_cast<unsigned>(entrances.size());
+    const auto goalId = startId + 1;
+    auto&& getTile = [&](unsigned id)
+    {
+        if (id == startId) return from;
+        if (id == goalId) return to;
+        return entrances[id];
+    };
+
+    const bool found = dgm::priv::astarSearch(
+        space,
+        entrances.size() + 2,
+        startId,
+        goalId,
+        [&](unsigned id) { return getManhattanDistance(getTile(id), to); },
+        [&](unsigned id, auto&& visit)
+        {
+            if (id == startId)
+            {
+                for (auto&& link : context.startLinks)
+                    visit(link.id, link.distance);
+                return;
+            }
+
+            for (auto&& edge : edges[id])
+                visit(edge.destination, edge.distance);
+
+            for (auto&& link : context.goalLinks)
+            {
+                if (link.id == id) visit(goalId, link.distance);
+            }
+        });
+
+    if (!found) return std::nullopt;
+
+    // Refinement reuses the search space, so the abstract path
+    // has to be stored first
+    auto& nodePath = context.nodePath;
+    nodePath.clear();
+    for (unsigned id = goalId; id != startId; id = space.getParent(id))
+        nodePath.push_back(id);
+    std::reverse(nodePath.begin(), nodePath.end());
+
+    auto previous = from;
+    for (auto&& id : nodePath)
+    {
+        const auto tile = getTile(id);
+        if (tile == previous) continue;
+
+        if (getClusterIndex(tile) != getClusterIndex(previous))
+        {
+            // Transition between neighboring clusters
+            points.push_back(TileNavpoint(tile, 0u));
+        }
+        else if (!appendClusterPath(previous, tile, context))
+        {
+            // Every intra-cluster edge is backed by a path
+            return std::nullopt;
+        }
+
+        previous = tile;
+    }
+
+    return dgm::Path<TileNavpoint>(points, false);
+}
+
+dgm::Path<dgm::WorldNavpoint> dgm::HierarchicalNavMesh::computePath(
+    const sf::Vector2f& from, const sf::Vector2f& to) const
+{
+    auto&& context = PathSearchContext();
+    return computePath(from, to, context);
+}
+
+dgm::Path<dgm::WorldNavpoint> dgm::HierarchicalNavMesh::computePath(
+    const sf::Vector2f& from,
+    const sf::Vector2f& to,
+    PathSearchContext& context) const
+{
+    if (from.x < 0.f || from.y < 0.f || to.x < 0.f || to.y < 0.f)
+        return dgm::Path<WorldNavpoint>({}, false);
+
+    const auto& voxelSize = mesh.getVoxelSize();
+    auto&& toTile = [&](const sf::Vector2f& coord)
+    {
+        return sf::Vector2u(
+            static_cast<unsigned>(coord.x) / voxelSize.x,
+            static_cast<unsigned>(coord.y) / voxelSize.y);
+    };
+
+    const auto tileFrom = toTile(from);
+    const auto tilePath = computeTilePath(tileFrom, toTile(to), context);
+    if (!tilePath) return dgm::Path<WorldNavpoint>({}, false);
+
+    auto&& toWorldNavpoint = [&](const sf::Vector2u& tile)
+    {
+        return WorldNavpoint(
+            sf::Vector2f(
+                (tile.x + 0.5f) * voxelSize.x, (tile.y + 0.5f) * voxelSize.y),
+            0u);
+    };
+
+    // Only keep tiles where the direction changes, straight segments
+    // between them are free of obstacles
+    const auto& tiles = context.tilePoints;
+    auto& points = context.worldPoints;
+    points.clear();
+    for (std::size_t i = 0; i < tiles.size(); ++i)
+    {
+        const auto& previous = i == 0 ? tileFrom : tiles[i - 1].coord;
+        const bool isLast = i + 1 == tiles.size();
+        if (isLast
+            || (previous.x != tiles[i + 1].coord.x
+                && previous.y != tiles[i + 1].coord.y))
+            points.push_back(toWorldNavpoint(tiles[i].coord));
+    }
+
+    return dgm::Path<WorldNavpoint>(points, false);
+}
+
+void dgm::HierarchicalNavMesh::discoverEntrances()
+{
+    const auto& size = mesh.getDataSize();
+    auto&& isFree = [&](unsigned x, unsigned y)
+    { return mesh[sf::Vector2u(x, y)] <= 0; };
+
+    /**
+     *  Walk along a border between two clusters and place transitions on
+     *  each maximal run of tiles that are passable on both sides.
+     *  toSides maps position along the border to the pair of tiles.
+     */
+    auto&& scanBorder = [&](unsigned begin, unsigned end, auto toSides)
+    {
+        unsigned runStart = begin;
+        for (unsigned i = begin; i <= end; ++i)
+        {
+            bool open = false;
+            if (i < end)
+            {
+                const auto [a, b] = toSides(i);
+                open = isFree(a.x, a.y) && isFree(b.x, b.y);
+            }
+
+            if (open) continue;
+
+            if (i > runStart)
+            {
+                const unsigned length = i - runStart;
+                if (length < MAX_SINGLE_TRANSITION_LENGTH)
+                {
+                    const auto [a, b] = toSides(runStart + length / 2);
+                    addTransition(a, b);
+                }
+                else
+                {
+                    const auto [a1, b1] = toSides(runStart);
+                    const auto [a2, b2] = toSides(i - 1);
+                    addTransition(a1, b1);
+                    addTransition(a2, b2);
+                }
+            }
+            runStart = i + 1;
+        }
+    };
+
+    for (unsigned cy = 0; cy < clusterCount.y; ++cy)
+    {
+        for (unsigned cx = 0; cx < clusterCount.x; ++cx)
+        {
+            const unsigned x0 = cx * clusterSize;
+            const unsigned y0 = cy * clusterSize;
+            const unsigned x1 = std::min(x0 + clusterSize, size.x);
+            const unsigned y1 = std::min(y0 + clusterSize, size.y);
+
+            if (cx + 1 < clusterCount.x)
+            {
+                scanBorder(
+                    y0,
+                    y1,
+                    [&](unsigned y)
+                    {
+                        return std::pair(
+                            sf::Vector2u(x1 - 1, y), sf::Vector2u(x1, y));
+                    });
+            }
+
+            if (cy + 1 < clusterCount.y)
+            {
+                scanBorder(
+                    x0,
+                    x1,
+                    [&](unsigned x)
+                    {
+                        return std::pair(
+                            sf::Vector2u(x, y1 - 1), sf::Vector2u(x, y1));
+                    });
+            }
+        }
+    }
+}
+
+void dgm::HierarchicalNavMesh::addTransition(
+    const sf::Vector2u& a, const sf::Vector2u& b)
+{
+    const unsigned idA = getOrAddEntrance(a);
+    const unsigned idB = getOrAddEntrance(b);
+    edges[idA].push_back(Edge { .destination = idB, .distance = 1u });
+    edges[idB].push_back(Edge { .destination = idA, .distance = 1u });
+}
+
+unsigned dgm::HierarchicalNavMesh::getOrAddEntrance(const sf::Vector2u& tile)
+{
+    // Tiles near cluster corners can be part of two transitions
+    auto& ids = clusterEntrances[getClusterIndex(tile)];
+    for (auto&& id : ids)
+    {
+        if (entrances[id] == tile) return id;
+    }
+
+    const auto id = static_cast<unsigned>(entrances.size());
+    entrances.push_back(tile);
+    edges.emplace_back();
+    ids.push_back(id);
+    return id;
+}
+
+void dgm::HierarchicalNavMesh::connectEntrancesWithinClusters()
+{
+    auto&& space = priv::AstarSearchSpace();
+    auto&& links = std::vector<PathSearchContext::Link>();
+
+    for (auto&& ids : clusterEntrances)
+    {
+        for (auto&& id : ids)
+        {
+            linkToClusterEntrances(entrances[id], space, links);
+            for (auto&& link : links)
+            {
+                if (link.id == id) continue;
+                edges[id].push_back(
+                    Edge { .destination = link.id, .distance = link.distance });
+            }
+        }
+    }
+}
+
+bool dgm::HierarchicalNavMesh::searchWithinCluster(
+    priv::AstarSearchSpace& space,
+    const sf::Vector2u& from,
+    std::optional<sf::Vector2u> goal) const
+{
+    const auto bounds = getClusterBounds(from);
+    auto&& toId = [&](const sf::Vector2u& tile)
+    {
+        return (tile.y - bounds.position.y) * bounds.size.x
+               + (tile.x - bounds.position.x);
+    };
+
+    // Without a goal, the search exhausts the cluster like Dijkstra would
+    const unsigned goalId =
+        goal ? toId(*goal) : priv::AstarSearchSpace::NO_NODE;
+
+    return dgm::priv::astarSearch(
+        space,
+        bounds.size.x * bounds.size.y,
+        toId(from),
+        goalId,
+        [&](unsigned id)
+        {
+            if (!goal) return 0u;
+            return getManhattanDistance(
+                sf::Vector2u(id % bounds.size.x, id / bounds.size.x),
+                *goal - bounds.position);
+        },
+        [&](unsigned id, auto&& visit)
+        {
+            const auto local =
+                sf::Vector2u(id % bounds.size.x, id / bounds.size.x);
+            auto&& visitIfEmpty = [&](unsigned neighbor, unsigned x, unsigned y)
+            {
+                if (mesh[bounds.position + sf::Vector2u(x, y)] <= 0)
+                    visit(neighbor, 1u);
+            };
+
+            if (local.y > 0)
+                visitIfEmpty(id - bounds.size.x, local.x, local.y - 1);
+            if (local.y + 1 < bounds.size.y)
+                visitIfEmpty(id + bounds.size.x, local.x, local.y + 1);
+            if (local.x > 0) visitIfEmpty(id - 1, local.x - 1, local.y);
+            if (local.x + 1 < bounds.size.x)
+                visitIfEmpty(id + 1, local.x + 1, local.y);
+        });
+}
+
+void dgm::HierarchicalNavMesh::linkToClusterEntrances(
+    const sf::Vector2u& tile,
+    priv::AstarSearchSpace& space,
+    std::vector<PathSearchContext::Link>& links) const
+{
+    links.clear();
+    (void)searchWithinCluster(space, tile, std::nullopt);
+
+    const auto bounds = getClusterBounds(tile);
+    for (auto&& id : clusterEntrances[getClusterIndex(tile)])
+    {
+        const auto local = entrances[id] - bounds.position;
+        const unsigned localId = local.y * bounds.size.x + local.x;
+        if (!space.isVisited(localId)) continue;
+
+        links.push_back(PathSearchContext::Link {
+            .id = id, .distance = space.getGcost(localId) });
+    }
+}
+
+bool dgm::HierarchicalNavMesh::appendClusterPath(
+    const sf::Vector2u& from,
+    const sf::Vector2u& to,
+    PathSearchContext& context) const
+{
+    auto& space = context.space;
+    if (!searchWithinCluster(space, from, to)) return false;
+
+    const auto bounds = getClusterBounds(from);
+    auto&& toId = [&](const sf::Vector2u& tile)
+    {
+        return (tile.y - bounds.position.y) * bounds.size.x
+               + (tile.x - bounds.position.x);
+    };
+
+    auto& points = context.tilePoints;
+    const auto segmentStart = points.size();
+    const unsigned fromId = toId(from);
+    for (unsigned id = toId(to); id != fromId; id = space.getParent(id))
+    {
+        points.push_back(TileNavpoint(
+            bounds.position
+                + sf::Vector2u(id % bounds.size.x, id / bounds.size.x),
+            0u));
+    }
+    std::reverse(points.begin() + segmentStart, points.end());
+
+    return true;
+}
+
+dgm::HierarchicalNavMesh::ClusterBounds
+dgm::HierarchicalNavMesh::getClusterBounds(
+    const sf::Vector2u& tile) const noexcept
+{
+    const auto position = sf::Vector2u(
+        tile.x / clusterSize * clusterSize, tile.y / clusterSize * clusterSize);
+    const auto& size = mesh.getDataSize();
+    return ClusterBounds {
+        .position = position,
+        .size = sf::Vector2u(
+            std::min(clusterSize, size.x - position.x),
+            std::min(clusterSize, size.y - position.y)),
+    };
+}
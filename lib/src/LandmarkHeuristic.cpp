@@ -0,0 +1,46 @@
+#include <DGM/classes/LandmarkHeuristic.hpp>
+#include <LandmarkSearch.hpp>
+
+dgm::LandmarkHeuristic::LandmarkHeuristic(
+    const dgm::Mesh& mesh, unsigned landmarkCount)
+    : dataSize(mesh.getDataSize())
+{
+    const auto& size = dataSize;
+    distances = priv::computeLandmarkDistances(
+        static_cast<std::size_t>(size.x) * size.y,
+        landmarkCount,
+        [&](unsigned id) { return mesh[id] <= 0; },
+        [&](unsigned id, auto&& visit)
+        {
+            const unsigned x = id % size.x;
+            const unsigned y = id / size.x;
+            auto&& visitIfEmpty = [&](unsigned neighbor)
+            {
+                if (mesh[neighbor] <= 0) visit(neighbor, 1u);
+            };
+
+            if (y > 0) visitIfEmpty(id - size.x);
+            if (y + 1 < size.y) visitIfEmpty(id + size.x);
+            if (x > 0) visitIfEmpty(id - 1);
+            if (x + 1 < size.x) visitIfEmpty(id + 1);
+        });
+}
+
+unsigned dgm::LandmarkHeuristic::getLowerBound(
+    const sf::Vector2u& from, const sf::Vector2u& to) const noexcept
+{
+    const unsigned dx = from.x < to.x ? to.x - from.x : from.x - to.x;
+    const unsigned dy = from.y < to.y ? to.y - from.y : from.y - to.y;
+    const unsigned bound = priv::LandmarkDistances::getLowerBound(
+        distances.getDistances(from.y * dataSize.x + from.x),
+        distances.getDistances(to.y * dataSize.x + to.x));
+    return bound < dx + dy ? dx + dy : bound;
+}
+
+std::vector<sf::Vector2u> dgm::LandmarkHeuristic::getLandmarks() const
+{
+    auto&& result = std::vector<sf::Vector2u>();
+    for (auto&& id : distances.getLandmarks())
+        result.emplace_back(id % dataSize.x, id / dataSize.x);
+    return result;
+}
@@ -0,0 +1,101 @@
+#include <DGM/classes/LineOfSightCache.hpp>
+#include <DGM/classes/Raycaster.hpp>
+#include <algorithm>
+#include <cassert>
+
+dgm::LineOfSightCache::LineOfSightCache(dgm::Mesh _mesh, unsigned _regionSize)
+    : mesh(std::move(_mesh))
+    , regionSize(std::max(_regionSize, 1u))
+    , regionCountX((mesh.getDataSize().x + regionSize - 1) / regionSize)
+{
+    const unsigned regionCountY =
+        (mesh.getDataSize().y + regionSize - 1) / regionSize;
+    regionDependants.resize(regionCountX * regionCountY);
+}
+
+bool dgm::LineOfSightCache::hasDirectVisibility(
+    const sf::Vector2u& fromTile, const sf::Vector2u& toTile)
+{
+    assert(
+        fromTile.x < mesh.getDataSize().x && fromTile.y < mesh.getDataSize().y
+        && toTile.x < mesh.getDataSize().x
+        && toTile.y < mesh.getDataSize().y);
+
+    const auto tileCount = static_cast<std::uint64_t>(mesh.getDataSize().x)
+                           * mesh.getDataSize().y;
+    const auto key = getTileIndex(fromTile) * tileCount + getTileIndex(toTile);
+
+    if (auto itr = cache.find(key); itr != cache.end())
+        return itr->second.visible;
+
+    const auto voxelSize = sf::Vector2f(mesh.getVoxelSize());
+    auto&& toWorldCoord = [&](const sf::Vector2u& tile)
+    {
+        return (sf::Vector2f(tile) + sf::Vector2f(0.5f, 0.5f))
+            .componentWiseMul(voxelSize);
+    };
+
+    traversedRegions.clear();
+    const bool visible = dgm::Raycaster::hasDirectVisibility(
+        toWorldCoord(fromTile),
+        toWorldCoord(toTile),
+        mesh,
+        [&](const sf::Vector2u& tile)
+        {
+            // Ray stays within a region for several tiles in a row, only
+            // record when it enters a new one
+            const auto region = getRegionIndex(tile);
+            if (traversedRegions.empty() || traversedRegions.back() != region)
+                traversedRegions.push_back(region);
+        });
+
+    std::sort(traversedRegions.begin(), traversedRegions.end());
+    traversedRegions.erase(
+        std::unique(traversedRegions.begin(), traversedRegions.end()),
+        traversedRegions.end());
+
+    for (auto&& region : traversedRegions)
+        regionDependants[region].insert(key);
+
+    cache.emplace(
+        key, CachedResult { .visible = visible, .regions = traversedRegions });
+    return visible;
+}
+
+void dgm::LineOfSightCache::setTile(const sf::Vector2u& tile, int value)
+{
+    auto& current = mesh[tile];
+    const bool solidityChanged = (current > 0) != (value > 0);
+    current = value;
+
+    if (!solidityChanged) return;
+
+    const auto changedRegion = getRegionIndex(tile);
+    auto& dependants = regionDependants[changedRegion];
+    for (auto&& key : dependants)
+    {
+        auto itr = cache.find(key);
+        assert(itr != cache.end());
+        for (auto&& region : itr->second.regions)
+        {
+            if (region != changedRegion) regionDependants[region].erase(key);
+        }
+        cache.erase(itr);
+    }
+    dependants.clear();
+}
+
+std::size_t dgm::LineOfSightCache::getDependencyCount() const noexcept
+{
+    std::size_t count = 0;
+    for (auto&& dependants : regionDependants)
+        count += dependants.size();
+    return count;
+}
+
+void dgm::LineOfSightCache::clear()
+{
+    cache.clear();
+    for (auto&& dependants : regionDependants)
+        dependants.clear();
+}
@@ -0,0 +1,148 @@
+#include <DGM/classes/MovingAiLoader.hpp>
+#include <fstream>
+#include <sstream>
+
+[[nodiscard]] static bool isPassableMovingAiTile(char tile) noexcept
+{
+    return tile == '.' || tile == 'G' || tile == 'S';
+}
+
+/**
+ *  Remove trailing carriage return of files with Windows line endings
+ */
+static void trimLineEnding(std::string& line)
+{
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+}
+
+std::expected<dgm::Mesh, dgm::Error> dgm::MovingAiLoader::loadMap(
+    const std::filesystem::path& path, const sf::Vector2u& voxelSize)
+{
+    auto&& stream = std::ifstream(path);
+    if (!stream)
+        return std::unexpected(dgm::Error(
+            "Could not open file '" + path.string() + "' for reading"));
+    return loadMap(stream, voxelSize);
+}
+
+std::expected<dgm::Mesh, dgm::Error> dgm::MovingAiLoader::loadMap(
+    std::istream& stream, const sf::Vector2u& voxelSize)
+{
+    auto&& size = sf::Vector2u();
+    auto&& line = std::string();
+
+    // Header is a list of "key value" lines terminated by "map"
+    while (true)
+    {
+        if (!std::getline(stream, line))
+            return std::unexpected(
+                dgm::Error("Map header is not terminated by 'map'"));
+        trimLineEnding(line);
+        if (line == "map") break;
+
+        auto&& lineStream = std::istringstream(line);
+        auto&& key = std::string();
+        lineStream >> key;
+        if (key == "type") continue;
+
+        unsigned value = 0;
+        if (!(lineStream >> value))
+            return std::unexpected(
+                dgm::Error("Invalid map header line '" + line + "'"));
+
+        if (key == "width")
+            size.x = value;
+        else if (key == "height")
+            size.y = value;
+        else
+            return std::unexpected(
+                dgm::Error("Unknown map header key '" + key + "'"));
+    }
+
+    if (size.x == 0 || size.y == 0)
+        return std::unexpected(
+            dgm::Error("Map header must specify nonzero width and height"));
+
+    auto&& data = std::vector<int>();
+    data.reserve(static_cast<std::size_t>(size.x) * size.y);
+    for (unsigned y = 0; y < size.y; ++y)
+    {
+        if (!std::getline(stream, line))
+            return std::unexpected(dgm::Error(
+                "Map has " + std::to_string(y) + " rows, expected "
+                + std::to_string(size.y)));
+        trimLineEnding(line);
+        if (line.size() != size.x)
+            return std::unexpected(dgm::Error(
+                "Row " + std::to_string(y) + " of the map has "
+                + std::to_string(line.size()) + " tiles, expected "
+                + std::to_string(size.x)));
+
+        for (auto&& tile : line)
+            data.push_back(isPassableMovingAiTile(tile) ? 0 : 1);
+    }
+
+    return dgm::Mesh(data, size, voxelSize);
+}
+
+std::expected<std::vector<dgm::MovingAiScenario>, dgm::Error>
+dgm::MovingAiLoader::loadScenarios(const std::filesystem::path& path)
+{
+    auto&& stream = std::ifstream(path);
+    if (!stream)
+        return std::unexpected(dgm::Error(
+            "Could not open file '" + path.string() + "' for reading"));
+    return loadScenarios(stream);
+}
+
+std::expected<std::vector<dgm::MovingAiScenario>, dgm::Error>
+dgm::MovingAiLoader::loadScenarios(std::istream& stream)
+{
+    auto&& line = std::string();
+    if (!std::getline(stream, line))
+        return std::unexpected(dgm::Error("Scenario file is empty"));
+    trimLineEnding(line);
+
+    auto&& versionStream = std::istringstream(line);
+    auto&& keyword = std::string();
+    double version = 0.0;
+    if (!(versionStream >> keyword >> version) || keyword != "version"
+        || version != 1.0)
+        return std::unexpected(dgm::Error(
+            "Unsupported scenario file version line '" + line + "'"));
+
+    auto&& result = std::vector<MovingAiScenario>();
+    for (unsigned lineNumber = 2; std::getline(stream, line); ++lineNumber)
+    {
+        trimLineEnding(line);
+        if (line.empty()) continue;
+
+        // Map path can contain spaces, columns are separated by tabs
+        auto&& lineStream = std::istringstream(line);
+        auto&& scenario = MovingAiScenario();
+        auto&& rest = std::string();
+        const bool valid =
+            lineStream >> scenario.bucket
+            && std::getline(lineStream.ignore(1), scenario.mapPath, '\t')
+            && lineStream >> scenario.mapSize.x >> scenario.mapSize.y
+                   >> scenario.from.x >> scenario.from.y >> scenario.to.x
+                   >> scenario.to.y >> scenario.optimalLength
+            && !(lineStream >> rest);
+        if (!valid)
+            return std::unexpected(dgm::Error(
+                "Invalid scenario on line " + std::to_string(lineNumber)));
+
+        const bool isInsideMap = scenario.from.x < scenario.mapSize.x
+                                 && scenario.from.y < scenario.mapSize.y
+                                 && scenario.to.x < scenario.mapSize.x
+                                 && scenario.to.y < scenario.mapSize.y;
+        if (!isInsideMap)
+            return std::unexpected(dgm::Error(
+                "Scenario on line " + std::to_string(lineNumber)
+                + " lies outside of its map"));
+
+        result.push_back(std::move(scenario));
+    }
+
+    return result;
+}
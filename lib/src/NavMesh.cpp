@@ -1,569 +1,1589 @@
 #include "DGM/classes/NavMesh.hpp"
 #include "DGM/classes/Error.hpp"
+#include <AstarSearch.hpp>
 #include <JumpPointSearchUtilities.hpp>
-#include <array>
+#include <LandmarkSearch.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
 #include <cmath>
+#include <cstring>
 #include <functional>
-#include <map>
-#include <queue>
+#include <memory>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
 
-template<class T>
-concept AstarNode =
-    std::is_class<T>::value
-    && std::is_member_function_pointer_v<decltype(&T::isCloserThan)>
-    && std::is_member_object_pointer_v<decltype(&T::point)>
-    && std::is_member_object_pointer_v<decltype(&T::gcost)>;
-
-template<AstarNode NodeType>
-class NodeSet
+namespace custom
 {
-protected:
-    std::map<sf::Vector2u, NodeType, dgm::Utility::less<sf::Vector2u>> nodes;
-
-public:
-    void insertNode(const NodeType& node)
+    [[nodiscard]] constexpr unsigned max(unsigned a, unsigned b) noexcept
     {
-        if (nodes.find(node.point) != nodes.end()
-            && nodes[node.point].gcost < node.gcost)
-            return;
-        nodes[node.point] = node;
+        return a < b ? b : a;
     }
 
-    [[nodiscard]] bool hasElements() const noexcept
+    [[nodiscard]] constexpr unsigned min(unsigned a, unsigned b) noexcept
     {
-        return !nodes.empty();
+        return a < b ? a : b;
     }
 
-    [[nodiscard]] bool contains(const sf::Vector2u& p) const noexcept
+    [[nodiscard]] constexpr unsigned
+    getScalarDistance(unsigned a, unsigned b) noexcept
     {
-        const auto itr = nodes.find(p);
-        return itr != nodes.end();
+        return max(a, b) - min(a, b);
     }
+} // namespace custom
+
+[[nodiscard]] static unsigned
+getManhattanDistance(const sf::Vector2u& a, const sf::Vector2u& b) noexcept
+{
+    return custom::getScalarDistance(a.x, b.x)
+           + custom::getScalarDistance(a.y, b.y);
+}
+
+[[nodiscard]] static unsigned
+getEuclideanDistance(const sf::Vector2u& a, const sf::Vector2u& b) noexcept
+{
+    const unsigned dx = custom::getScalarDistance(a.x, b.x);
+    const unsigned dy = custom::getScalarDistance(a.y, b.y);
+    return static_cast<unsigned>(
+        std::sqrt(static_cast<float>(dx * dx + dy * dy)));
+}
 
-    [[nodiscard]] NodeType popBestNode()
+namespace graph_format
+{
+    constexpr std::uint32_t MAGIC = 0x4E4D4744; // "DGMN" in little endian
+
+    struct [[nodiscard]] Header final
     {
-        auto minElem = nodes.begin();
-        for (auto itr = (++nodes.begin()); itr != nodes.end(); itr++)
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint64_t meshHash;
+        std::uint32_t width;
+        std::uint32_t height;
+        std::uint32_t jumpPointCount;
+        std::uint32_t connectionCount;
+        std::uint32_t maxAgentRadius;
+        std::uint32_t reserved;
+    };
+
+    static_assert(sizeof(Header) == 40);
+
+    /**
+     *  FNV-1a hash of mesh dimensions, voxel size and tile values.
+     *  Voxel size matters because connection distances are stored
+     *  in world units.
+     */
+    [[nodiscard]] static std::uint64_t getMeshHash(const dgm::Mesh& mesh)
+    {
+        std::uint64_t hash = 14695981039346656037ull;
+        auto&& add = [&](auto value)
         {
-            if (itr->second.isCloserThan(minElem->second))
+            const auto bytes = std::as_bytes(std::span(&value, 1));
+            for (auto&& byte : bytes)
             {
-                minElem = itr;
+                hash ^= static_cast<std::uint64_t>(byte);
+                hash *= 1099511628211ull;
             }
-        }
+        };
 
-        const NodeType copy = minElem->second;
-        nodes.erase(minElem);
-        return copy;
+        const auto& size = mesh.getDataSize();
+        add(size.x);
+        add(size.y);
+        add(mesh.getVoxelSize().x);
+        add(mesh.getVoxelSize().y);
+        for (std::size_t i = 0; i < std::size_t(size.x) * size.y; ++i)
+            add(mesh[i]);
+        return hash;
     }
 
-    [[nodiscard]] const NodeType& getNode(const sf::Vector2u& point) const
+    template<class T>
+    static void write(std::vector<std::byte>& output, std::span<const T> items)
     {
-        return nodes.at(point);
+        static_assert(std::is_trivially_copyable_v<T>);
+        const auto bytes = std::as_bytes(items);
+        output.insert(output.end(), bytes.begin(), bytes.end());
     }
-};
 
-namespace custom
+    /**
+     *  Copy bytes of items from the front of input and advance it.
+     *  Caller validates the size of input beforehand.
+     */
+    template<class T>
+    static void read(std::span<const std::byte>& input, std::span<T> items)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const auto bytes = std::as_writable_bytes(items);
+        assert(input.size() >= bytes.size());
+        if (!bytes.empty())
+            std::memcpy(bytes.data(), input.data(), bytes.size());
+        input = input.subspan(bytes.size());
+    }
+} // namespace graph_format
+
+std::optional<dgm::Path<dgm::TileNavpoint>> dgm::TileNavMesh::computePath(
+    const sf::Vector2u& from, const sf::Vector2u& to, const dgm::Mesh& mesh)
 {
-    [[nodiscard]] constexpr unsigned max(unsigned a, unsigned b) noexcept
+    auto&& context = PathSearchContext();
+    return computePath(from, to, mesh, context);
+}
+
+std::optional<dgm::Path<dgm::TileNavpoint>> dgm::TileNavMesh::computePath(
+    const sf::Vector2u& from,
+    const sf::Vector2u& to,
+    const dgm::Mesh& mesh,
+    PathSearchContext& context)
+{
+    return searchPath(from, to, mesh, SearchOptions {}, context);
+}
+
+std::optional<dgm::Path<dgm::TileNavpoint>> dgm::TileNavMesh::computePath(
+    const sf::Vector2u& from,
+    const sf::Vector2u& to,
+    const dgm::Mesh& mesh,
+    const LandmarkHeuristic& landmarks)
+{
+    auto&& context = PathSearchContext();
+    return computePath(from, to, mesh, landmarks, context);
+}
+
+std::optional<dgm::Path<dgm::TileNavpoint>> dgm::TileNavMesh::computePath(
+    const sf::Vector2u& from,
+    const sf::Vector2u& to,
+    const dgm::Mesh& mesh,
+    const LandmarkHeuristic& landmarks,
+    PathSearchContext& context)
+{
+    assert(landmarks.getDataSize() == mesh.getDataSize());
+    return searchPath(
+        from, to, mesh, SearchOptions { .landmarks = &landmarks }, context);
+}
+
+std::optional<dgm::Path<dgm::TileNavpoint>> dgm::TileNavMesh::computePath(
+    const sf::Vector2u& from,
+    const sf::Vector2u& to,
+    const dgm::Mesh& mesh,
+    const ClearanceMap& clearance,
+    unsigned agentRadius)
+{
+    auto&& context = PathSearchContext();
+    return computePath(from, to, mesh, clearance, agentRadius, context);
+}
+
+std::optional<dgm::Path<dgm::TileNavpoint>> dgm::TileNavMesh::computePath(
+    const sf::Vector2u& from,
+    const sf::Vector2u& to,
+    const dgm::Mesh& mesh,
+    const ClearanceMap& clearance,
+    unsigned agentRadius,
+    PathSearchContext& context)
+{
+    assert(clearance.getDataSize() == mesh.getDataSize());
+    if (!clearance.canFit(from, agentRadius)) return std::nullopt;
+    return searchPath(
+        from,
+        to,
+        mesh,
+        SearchOptions { .clearance = &clearance, .agentRadius = agentRadius },
+        context);
+}
+
+std::optional<dgm::Path<dgm::TileNavpoint>> dgm::TileNavMesh::searchPath(
+    const sf::Vector2u& from,
+    const sf::Vector2u& to,
+    const dgm::Mesh& mesh,
+    const SearchOptions& options,
+    PathSearchContext& context)
+{
+    return context.measureQuery(
+        searchTotals,
+        [&]() -> std::optional<dgm::Path<TileNavpoint>>
+        {
+            if (mesh[from] == 1)
+                return std::nullopt;
+            else if (from == to)
+                return dgm::Path<TileNavpoint>({}, false);
+
+            beginSearch(from, to, mesh, options, context);
+            const auto status = expandSearch(
+                to,
+                mesh,
+                options,
+                context,
+                std::numeric_limits<std::size_t>::max());
+            if (status != PathRequestStatus::Found) return std::nullopt;
+
+            return buildPath(from, to, mesh, context);
+        });
+}
+
+class dgm::TileNavMesh::RequestTask final
+    : public priv::PathSearchTask<TileNavpoint>
+{
+public:
+    /**
+     *  \param result Result of a request resolved without any search
+     */
+    RequestTask(
+        const sf::Vector2u& from,
+        const sf::Vector2u& to,
+        const dgm::Mesh& mesh,
+        std::optional<PathRequestStatus> result)
+        : from(from), to(to), mesh(mesh), result(result)
     {
-        return a < b ? b : a;
     }
 
-    [[nodiscard]] constexpr unsigned min(unsigned a, unsigned b) noexcept
+public:
+    PathRequestStatus expand(std::size_t maxExpansions) override
     {
-        return a < b ? a : b;
+#ifdef PATHFINDING_STATS
+        const auto start = std::chrono::steady_clock::now();
+        const auto status = expandUnmeasured(maxExpansions);
+        duration += std::chrono::steady_clock::now() - start;
+        if (status == PathRequestStatus::NotFound)
+            context.finishStats(duration, 0u, searchTotals);
+        return status;
+#else
+        return expandUnmeasured(maxExpansions);
+#endif
     }
 
-    [[nodiscard]] constexpr unsigned
-    getScalarDistance(unsigned a, unsigned b) noexcept
+    dgm::Path<TileNavpoint> buildPath() override
     {
-        return max(a, b) - min(a, b);
+        auto&& path = TileNavMesh::buildPath(from, to, mesh, context);
+#ifdef PATHFINDING_STATS
+        context.finishStats(duration, path.getLength(), searchTotals);
+#endif
+        return path;
     }
-} // namespace custom
 
-template<AstarNode NodeType>
-// First parameter is open set, second is coordinate to update from and third
-// parameter is closed set
-using UpdateOpenSetWithCoordCallback = std::function<void(
-    NodeSet<NodeType>&, const sf::Vector2u&, const NodeSet<NodeType>&)>;
+private:
+    PathRequestStatus expandUnmeasured(std::size_t maxExpansions)
+    {
+        if (result) return *result;
+
+        if (!started)
+        {
+            beginSearch(from, to, mesh, SearchOptions {}, context);
+            started = true;
+        }
+        return expandSearch(
+            to, mesh, SearchOptions {}, context, maxExpansions);
+    }
 
-/*
- * Returns ClosedSet from which path can be reconstructed or returns empty set
- * if no path was found
- */
-template<AstarNode NodeType>
-static decltype(auto) astarSearch(
-    NodeType startNode,
-    const sf::Vector2u& destinationCoord,
-    UpdateOpenSetWithCoordCallback<NodeType> updateOpenSetWithCoordCallback)
+private:
+    sf::Vector2u from;
+    sf::Vector2u to;
+    const dgm::Mesh& mesh;
+    std::optional<PathRequestStatus> result;
+    PathSearchContext context;
+    bool started = false;
+#ifdef PATHFINDING_STATS
+    std::chrono::nanoseconds duration = {};
+#endif
+};
+
+dgm::PathRequest<dgm::TileNavpoint> dgm::TileNavMesh::requestPath(
+    const sf::Vector2u& from, const sf::Vector2u& to, const dgm::Mesh& mesh)
+{
+    auto&& result = std::optional<PathRequestStatus>();
+    if (mesh[from] == 1)
+        result = PathRequestStatus::NotFound;
+    else if (from == to)
+        result = PathRequestStatus::Found;
+
+    return PathRequest<TileNavpoint>(
+        std::make_unique<RequestTask>(from, to, mesh, result));
+}
+
+dgm::PathRequest<dgm::TileNavpoint> dgm::TileNavMesh::requestPath(
+    const sf::Vector2u& from,
+    const sf::Vector2u& to,
+    const dgm::Mesh& mesh,
+    const ConnectedComponents& components)
 {
-    NodeSet<NodeType> openSet, closedSet;
+    if (from != to && !components.areConnected(from, to))
+        return PathRequest<TileNavpoint>(std::make_unique<RequestTask>(
+            from, to, mesh, PathRequestStatus::NotFound));
+    return requestPath(from, to, mesh);
+}
 
-    closedSet.insertNode(startNode);
-    updateOpenSetWithCoordCallback(openSet, startNode.point, closedSet);
+unsigned dgm::TileNavMesh::SearchOptions::getHeuristic(
+    const sf::Vector2u& point, const sf::Vector2u& to) const noexcept
+{
+    return landmarks ? landmarks->getLowerBound(point, to)
+                     : getManhattanDistance(point, to);
+}
 
-    while (openSet.hasElements())
-    {
-        const NodeType node = openSet.popBestNode();
-        closedSet.insertNode(node);
+bool dgm::TileNavMesh::SearchOptions::isOpen(
+    const dgm::Mesh& mesh, unsigned index) const noexcept
+{
+    return clearance ? clearance->getClearance(index) > agentRadius
+                     : mesh[index] <= 0;
+}
 
-        if (node.point == destinationCoord) return closedSet;
+void dgm::TileNavMesh::beginSearch(
+    const sf::Vector2u& from,
+    const sf::Vector2u& to,
+    const dgm::Mesh& mesh,
+    const SearchOptions& options,
+    PathSearchContext& context)
+{
+    const auto& size = mesh.getDataSize();
+    dgm::priv::astarBegin(
+        context.space,
+        size.x * size.y,
+        from.y * size.x + from.x,
+        [&](unsigned) { return options.getHeuristic(from, to); });
+}
 
-        updateOpenSetWithCoordCallback(openSet, node.point, closedSet);
-    }
+dgm::PathRequestStatus dgm::TileNavMesh::expandSearch(
+    const sf::Vector2u& to,
+    const dgm::Mesh& mesh,
+    const SearchOptions& options,
+    PathSearchContext& context,
+    std::size_t maxExpansions)
+{
+    const auto& size = mesh.getDataSize();
+    auto&& toPoint = [&](unsigned id)
+    { return sf::Vector2u(id % size.x, id / size.x); };
+
+    const auto status = dgm::priv::astarExpand(
+        context.space,
+        to.y * size.x + to.x,
+        [&](unsigned id) { return options.getHeuristic(toPoint(id), to); },
+        [&](unsigned id, auto&& visit)
+        {
+            const auto point = toPoint(id);
+            auto&& visitIfEmpty = [&](unsigned neighbor)
+            {
+                if (options.isOpen(mesh, neighbor)) visit(neighbor, 1u);
+            };
+
+            if (point.y > 0) visitIfEmpty(id - size.x);
+            if (point.y + 1 < size.y) visitIfEmpty(id + size.x);
+            if (point.x > 0) visitIfEmpty(id - 1);
+            if (point.x + 1 < size.x) visitIfEmpty(id + 1);
+        },
+        maxExpansions);
+
+    if (status == priv::AstarStatus::InProgress)
+        return PathRequestStatus::InProgress;
+    return status == priv::AstarStatus::GoalReached
+               ? PathRequestStatus::Found
+               : PathRequestStatus::NotFound;
+}
 
-    return NodeSet<NodeType>();
+dgm::Path<dgm::TileNavpoint> dgm::TileNavMesh::buildPath(
+    const sf::Vector2u& from,
+    const sf::Vector2u& to,
+    const dgm::Mesh& mesh,
+    PathSearchContext& context)
+{
+    const auto& size = mesh.getDataSize();
+    auto&& toId = [&](const sf::Vector2u& point)
+    { return point.y * size.x + point.x; };
+    auto&& toPoint = [&](unsigned id)
+    { return sf::Vector2u(id % size.x, id / size.x); };
+
+    auto& points = context.tilePoints;
+    points.clear();
+    const unsigned fromId = toId(from);
+    for (unsigned id = toId(to); id != fromId; id = context.space.getParent(id))
+        points.push_back(TileNavpoint(toPoint(id), 0u));
+    std::reverse(points.begin(), points.end());
+
+    return dgm::Path(points, false);
 }
 
-enum class Backdir
+std::optional<dgm::Path<dgm::TileNavpoint>> dgm::TileNavMesh::computePath(
+    const sf::Vector2u& from,
+    const sf::Vector2u& to,
+    const dgm::Mesh& mesh,
+    const ConnectedComponents& components)
 {
-    Undefined,
-    Up,
-    Left,
-    Down,
-    Right
-};
+    auto&& context = PathSearchContext();
+    return computePath(from, to, mesh, components, context);
+}
 
-struct TileNode
+std::optional<dgm::Path<dgm::TileNavpoint>> dgm::TileNavMesh::computePath(
+    const sf::Vector2u& from,
+    const sf::Vector2u& to,
+    const dgm::Mesh& mesh,
+    const ConnectedComponents& components,
+    PathSearchContext& context)
 {
-protected:
-    [[nodiscard]] constexpr static unsigned
-    getManhattanDistance(const sf::Vector2u& a, const sf::Vector2u& b) noexcept
-    {
-        return custom::getScalarDistance(a.x, b.x)
-               + custom::getScalarDistance(a.y, b.y);
-    }
+    if (from != to && !components.areConnected(from, to)) return std::nullopt;
+    return computePath(from, to, mesh, context);
+}
 
-public:
-    sf::Vector2u point = {};
-    unsigned gcost = 0;
-    unsigned hcost = 0;
-    unsigned fcost = 0;
-    Backdir backdir = Backdir::Up;
+/**
+ *  Jump rules of Jump Point Search on a 4-connected grid
+ *
+ *  Among equally long paths, the canonical one moves vertically first.
+ *  Thus a horizontal move only turns at forced neighbors (tiles that cannot
+ *  be reached by moving vertically first because the tile behind is
+ *  blocked), while a vertical move can turn anywhere, so it stops wherever
+ *  a horizontal jump to either side would find a jump point.
+ */
+struct TileJumper
+{
+    const dgm::Mesh& mesh;
+    const sf::Vector2u goal;
 
-    TileNode() = default;
+    [[nodiscard]] bool isFree(unsigned x, unsigned y) const
+    {
+        // Unsigned wrap-around makes negative coords fail the check too
+        return x < mesh.getDataSize().x && y < mesh.getDataSize().y
+               && mesh[sf::Vector2u(x, y)] <= 0;
+    }
 
-    TileNode(
-        const sf::Vector2u& point,
-        const sf::Vector2u& end,
-        unsigned gcost,
-        Backdir backdir)
+    [[nodiscard]] bool
+    hasForcedNeighbor(const sf::Vector2u& point, int dx, int dy) const
     {
-        this->point = point;
-        this->backdir = backdir;
-        this->gcost = gcost;
-        hcost = getManhattanDistance(point, end);
-        fcost = gcost + hcost;
+        return isFree(point.x, point.y + dy)
+               && !isFree(point.x - dx, point.y + dy);
     }
 
-    TileNode(const TileNode& other) = default;
-    TileNode& operator=(const TileNode& other) = default;
+    [[nodiscard]] std::optional<sf::Vector2u>
+    jumpHorizontally(sf::Vector2u point, int dx) const
+    {
+        while (true)
+        {
+            point.x += dx;
+            if (!isFree(point.x, point.y)) return std::nullopt;
+            if (point == goal || hasForcedNeighbor(point, dx, -1)
+                || hasForcedNeighbor(point, dx, 1))
+                return point;
+        }
+    }
 
-    [[nodiscard]] constexpr bool
-    isCloserThan(const TileNode& other) const noexcept
+    [[nodiscard]] std::optional<sf::Vector2u>
+    jumpVertically(sf::Vector2u point, int dy) const
     {
-        return fcost < other.fcost
-               || (fcost == other.fcost && hcost < other.hcost);
+        while (true)
+        {
+            point.y += dy;
+            if (!isFree(point.x, point.y)) return std::nullopt;
+            if (point == goal || jumpHorizontally(point, -1)
+                || jumpHorizontally(point, 1))
+                return point;
+        }
     }
 };
 
-std::optional<dgm::Path<dgm::TileNavpoint>> dgm::TileNavMesh::computePath(
-    const sf::Vector2u& from, const sf::Vector2u& to, const dgm::Mesh& mesh)
+std::optional<dgm::Path<dgm::TileNavpoint>>
+dgm::TileNavMesh::computeJumpPointPath(
+    const sf::Vector2u& from,
+    const sf::Vector2u& to,
+    const dgm::Mesh& mesh,
+    bool expandToTiles)
+{
+    auto&& context = PathSearchContext();
+    return computeJumpPointPath(from, to, mesh, context, expandToTiles);
+}
+
+std::optional<dgm::Path<dgm::TileNavpoint>>
+dgm::TileNavMesh::computeJumpPointPath(
+    const sf::Vector2u& from,
+    const sf::Vector2u& to,
+    const dgm::Mesh& mesh,
+    PathSearchContext& context,
+    bool expandToTiles)
+{
+    return context.measureQuery(
+        searchTotals,
+        [&]
+        {
+            return searchJumpPointPath(
+                from, to, mesh, context, expandToTiles);
+        });
+}
+
+std::optional<dgm::Path<dgm::TileNavpoint>>
+dgm::TileNavMesh::searchJumpPointPath(
+    const sf::Vector2u& from,
+    const sf::Vector2u& to,
+    const dgm::Mesh& mesh,
+    PathSearchContext& context,
+    bool expandToTiles)
 {
     if (mesh[from] == 1)
         return std::nullopt;
     else if (from == to)
         return dgm::Path<TileNavpoint>({}, false);
 
-    auto updateOpenSetWithCoord =
-        [&](NodeSet<TileNode>& openSet,
-            const sf::Vector2u& coord,
-            const NodeSet<TileNode>& closedSet) -> void
+    const auto& size = mesh.getDataSize();
+    auto&& toId = [&](const sf::Vector2u& point)
+    { return point.y * size.x + point.x; };
+    auto&& toPoint = [&](unsigned id)
+    { return sf::Vector2u(id % size.x, id / size.x); };
+
+    const auto jumper = TileJumper { .mesh = mesh, .goal = to };
+    auto& space = context.space;
+    const bool found = dgm::priv::astarSearch(
+        space,
+        size.x * size.y,
+        toId(from),
+        toId(to),
+        [&](unsigned id) { return getManhattanDistance(toPoint(id), to); },
+        [&](unsigned id, auto&& visit)
+        {
+            const auto point = toPoint(id);
+            auto&& visitJumpPoint = [&](std::optional<sf::Vector2u> target)
+            {
+                if (target)
+                    visit(toId(*target), getManhattanDistance(point, *target));
+            };
+
+            // Direction of travel is implied by the parent, the start node
+            // is its own parent and explores all directions
+            const auto parent = toPoint(space.getParent(id));
+            const int dx =
+                point.x == parent.x ? 0 : (point.x > parent.x ? 1 : -1);
+            const int dy =
+                point.y == parent.y ? 0 : (point.y > parent.y ? 1 : -1);
+
+            if (dx == 0)
+            {
+                visitJumpPoint(jumper.jumpHorizontally(point, -1));
+                visitJumpPoint(jumper.jumpHorizontally(point, 1));
+                if (dy <= 0) visitJumpPoint(jumper.jumpVertically(point, -1));
+                if (dy >= 0) visitJumpPoint(jumper.jumpVertically(point, 1));
+            }
+            else
+            {
+                visitJumpPoint(jumper.jumpHorizontally(point, dx));
+                if (jumper.hasForcedNeighbor(point, dx, -1))
+                    visitJumpPoint(jumper.jumpVertically(point, -1));
+                if (jumper.hasForcedNeighbor(point, dx, 1))
+                    visitJumpPoint(jumper.jumpVertically(point, 1));
+            }
+        });
+
+    if (!found) return std::nullopt;
+
+    auto& points = context.tilePoints;
+    points.clear();
+    const unsigned fromId = toId(from);
+    for (unsigned id = toId(to); id != fromId; id = space.getParent(id))
     {
-        using NeighborType = std::pair<sf::Vector2u, Backdir>;
+        const auto point = toPoint(id);
+        points.push_back(TileNavpoint(point, 0u));
+        if (!expandToTiles) continue;
 
-        auto canVisit = [&](const sf::Vector2u& point)
+        // Consecutive jump points always lie on a straight line
+        const auto parent = toPoint(space.getParent(id));
+        auto step = point;
+        while (true)
         {
-            const bool notInClosedSet = !closedSet.contains(point);
-            const bool emptyInMesh = mesh[point] <= 0;
-            return notInClosedSet && emptyInMesh;
-        };
+            step.x += step.x == parent.x ? 0 : (step.x > parent.x ? -1 : 1);
+            step.y += step.y == parent.y ? 0 : (step.y > parent.y ? -1 : 1);
+            if (step == parent) break;
+            points.push_back(TileNavpoint(step, 0u));
+        }
+    }
+    std::reverse(points.begin(), points.end());
 
-        const TileNode& node = closedSet.getNode(coord);
-
-        // Direction points from Vector2u to node.point
-        const std::array<NeighborType, 4> neighbors = {
-            NeighborType(
-                sf::Vector2u(node.point.x, node.point.y - 1), Backdir::Down),
-            NeighborType(
-                sf::Vector2u(node.point.x, node.point.y + 1), Backdir::Up),
-            NeighborType(
-                sf::Vector2u(node.point.x - 1, node.point.y), Backdir::Right),
-            NeighborType(
-                sf::Vector2u(node.point.x + 1, node.point.y), Backdir::Left)
-        };
+    return dgm::Path(points, false);
+}
+
+// ========= WORLD NAVMESH ===========
+
+dgm::WorldNavMesh::WorldNavMesh(dgm::Mesh _mesh, unsigned threadCount)
+    : WorldNavMesh(
+          std::move(_mesh), BuildSettings { .threadCount = threadCount })
+{
+}
+
+dgm::WorldNavMesh::WorldNavMesh(dgm::Mesh _mesh, const BuildSettings& settings)
+    : mesh(std::move(_mesh))
+    , components(mesh)
+    , clearance(mesh, settings.maxAgentRadius + 1)
+    , jumpPointIds(mesh.getDataSize().x * mesh.getDataSize().y, NO_JUMP_POINT)
+{
+    // Threads are shared by both phases of this one-off build
+    auto&& pool = dgm::WorkerPool(settings.threadCount);
+
+    // Both phases only read the mesh. Work is split into chunks of rows
+    // and of jump point ids and results of chunks are merged in order, so
+    // the graph is the same no matter how many threads built it.
+    constexpr unsigned ROWS_PER_CHUNK = 16;
+    constexpr unsigned JUMP_POINTS_PER_CHUNK = 256;
+
+    const auto& size = mesh.getDataSize();
+    const unsigned innerRowCount = size.y > 2 ? size.y - 2 : 0;
+    auto&& rowChunks = std::vector<std::vector<sf::Vector2u>>(
+        (innerRowCount + ROWS_PER_CHUNK - 1) / ROWS_PER_CHUNK);
+    pool.forEach(
+        rowChunks.size(),
+        [&](std::size_t chunk)
+        {
+            const unsigned firstRow =
+                1 + static_cast<unsigned>(chunk) * ROWS_PER_CHUNK;
+            const unsigned endRow =
+                std::min(firstRow + ROWS_PER_CHUNK, size.y - 1);
+            for (unsigned y = firstRow; y < endRow; y++)
+            {
+                for (unsigned x = 1; x < size.x - 1; x++)
+                {
+                    const sf::Vector2u point(x, y);
+                    if (shouldBeJumpPoint(point))
+                        rowChunks[chunk].push_back(point);
+                }
+            }
+        });
 
-        for (auto&& [newCoord, backdir] : neighbors)
+    for (auto&& chunk : rowChunks)
+    {
+        for (auto&& point : chunk)
         {
-            if (canVisit(newCoord))
-                openSet.insertNode(
-                    TileNode(newCoord, to, node.gcost + 1, backdir));
+            jumpPointIds[point.y * size.x + point.x] =
+                static_cast<unsigned>(jumpPoints.size());
+            jumpPoints.push_back(point);
         }
+    }
+
+    // Each discovery writes scan bounds of its own jump point only
+    jumpPointScanBounds.resize(jumpPoints.size());
+
+    struct ChunkGraph
+    {
+        std::vector<unsigned> offsets = {};
+        std::vector<Connection> connections = {};
     };
 
-    const NodeSet<TileNode> closedSet = astarSearch<TileNode>(
-        TileNode(from, to, 0, Backdir::Undefined), to, updateOpenSetWithCoord);
+    const auto jumpPointCount = static_cast<unsigned>(jumpPoints.size());
+    auto&& graphChunks = std::vector<ChunkGraph>(
+        (jumpPointCount + JUMP_POINTS_PER_CHUNK - 1) / JUMP_POINTS_PER_CHUNK);
+    pool.forEach(
+        graphChunks.size(),
+        [&](std::size_t chunk)
+        {
+            const unsigned firstId =
+                static_cast<unsigned>(chunk) * JUMP_POINTS_PER_CHUNK;
+            const unsigned endId =
+                std::min(firstId + JUMP_POINTS_PER_CHUNK, jumpPointCount);
+            auto& graph = graphChunks[chunk];
+            graph.offsets.reserve(endId - firstId);
+            for (unsigned id = firstId; id < endId; ++id)
+            {
+                graph.offsets.push_back(
+                    static_cast<unsigned>(graph.connections.size()));
+                discoverConnectionsForJumpPoint(id, graph.connections);
+            }
+        });
 
-    if (!closedSet.hasElements()) return std::nullopt;
+    std::size_t connectionCount = 0;
+    for (auto&& graph : graphChunks)
+        connectionCount += graph.connections.size();
 
-    std::vector<TileNavpoint> points;
-    points.push_back(TileNavpoint(to, 0u));
+    connectionOffsets.reserve(jumpPoints.size() + 1);
+    connections.reserve(connectionCount);
+    for (auto&& graph : graphChunks)
+    {
+        const auto base = static_cast<unsigned>(connections.size());
+        for (auto&& offset : graph.offsets)
+            connectionOffsets.push_back(base + offset);
+        connections.insert(
+            connections.end(),
+            graph.connections.begin(),
+            graph.connections.end());
+    }
+    connectionOffsets.push_back(static_cast<unsigned>(connections.size()));
+}
 
-    sf::Vector2u point = to;
-    do
+dgm::WorldNavMesh::WorldNavMesh(
+    dgm::Mesh _mesh, unsigned maxAgentRadius, PrebuiltGraphTag)
+    : mesh(std::move(_mesh))
+    , components(mesh)
+    , clearance(mesh, maxAgentRadius + 1)
+    , jumpPointIds(mesh.getDataSize().x * mesh.getDataSize().y, NO_JUMP_POINT)
+{
+}
+
+std::vector<std::byte> dgm::WorldNavMesh::saveGraph() const
+{
+    const auto header = graph_format::Header {
+        .magic = graph_format::MAGIC,
+        .version = GRAPH_FORMAT_VERSION,
+        .meshHash = graph_format::getMeshHash(mesh),
+        .width = mesh.getDataSize().x,
+        .height = mesh.getDataSize().y,
+        .jumpPointCount = static_cast<std::uint32_t>(jumpPoints.size()),
+        .connectionCount = static_cast<std::uint32_t>(connections.size()),
+        .maxAgentRadius = getMaxAgentRadius(),
+        .reserved = 0,
+    };
+
+    auto&& result = std::vector<std::byte>();
+    result.reserve(
+        sizeof(header) + jumpPoints.size() * sizeof(sf::Vector2u)
+        + connectionOffsets.size() * sizeof(unsigned)
+        + connections.size() * sizeof(Connection)
+        + jumpPointScanBounds.size() * sizeof(TileBounds));
+    graph_format::write(result, std::span(&header, 1));
+    graph_format::write(result, std::span(jumpPoints));
+    graph_format::write(result, std::span(connectionOffsets));
+    graph_format::write(result, std::span(connections));
+    graph_format::write(result, std::span(jumpPointScanBounds));
+    return result;
+}
+
+std::expected<dgm::WorldNavMesh, dgm::Error>
+dgm::WorldNavMesh::loadGraph(dgm::Mesh mesh, std::span<const std::byte> graph)
+{
+    auto&& header = graph_format::Header {};
+    if (graph.size() < sizeof(header))
+        return std::unexpected(dgm::Error("Navmesh graph is truncated"));
+    graph_format::read(graph, std::span(&header, 1));
+
+    if (header.magic != graph_format::MAGIC)
+        return std::unexpected(dgm::Error(
+            "Data is not a navmesh graph or it was saved on a machine with "
+            "different byte order"));
+    if (header.version != GRAPH_FORMAT_VERSION)
+        return std::unexpected(dgm::Error(
+            "Navmesh graph has format version " + std::to_string(header.version)
+            + ", expected " + std::to_string(GRAPH_FORMAT_VERSION)));
+    if (header.width != mesh.getDataSize().x
+        || header.height != mesh.getDataSize().y
+        || header.meshHash != graph_format::getMeshHash(mesh))
+        return std::unexpected(
+            dgm::Error("Navmesh graph was saved for a different mesh"));
+    if (header.maxAgentRadius >= 255)
+        return std::unexpected(
+            dgm::Error("Navmesh graph has invalid maximum agent radius"));
+
+    const std::uint64_t jumpPointCount = header.jumpPointCount;
+    const std::uint64_t expectedSize =
+        jumpPointCount * sizeof(sf::Vector2u)
+        + (jumpPointCount + 1) * sizeof(unsigned)
+        + std::uint64_t(header.connectionCount) * sizeof(Connection)
+        + jumpPointCount * sizeof(TileBounds);
+    if (graph.size() != expectedSize)
+        return std::unexpected(
+            dgm::Error("Navmesh graph has unexpected size"));
+
+    auto&& result = WorldNavMesh(
+        std::move(mesh), header.maxAgentRadius, PrebuiltGraphTag {});
+    result.jumpPoints.resize(header.jumpPointCount);
+    result.connectionOffsets.resize(header.jumpPointCount + 1);
+    result.connections.resize(header.connectionCount);
+    result.jumpPointScanBounds.resize(header.jumpPointCount);
+    graph_format::read(graph, std::span(result.jumpPoints));
+    graph_format::read(graph, std::span(result.connectionOffsets));
+    graph_format::read(graph, std::span(result.connections));
+    graph_format::read(graph, std::span(result.jumpPointScanBounds));
+
+    // Corrupted arrays would lead to out of bounds access during queries
+    const auto& size = result.mesh.getDataSize();
+    for (unsigned id = 0; id < header.jumpPointCount; ++id)
     {
-        const TileNode& node = closedSet.getNode(point);
-        switch (node.backdir)
-        {
-        case Backdir::Up:
-            --point.y;
-            break;
-        case Backdir::Left:
-            --point.x;
-            break;
-        case Backdir::Down:
-            ++point.y;
-            break;
-        case Backdir::Right:
-            ++point.x;
-            break;
-        case Backdir::Undefined:
-            break;
-        }
+        const auto& point = result.jumpPoints[id];
+        const bool isInside = point.x > 0 && point.y > 0
+                              && point.x + 1 < size.x && point.y + 1 < size.y;
+        const auto& previous = result.jumpPoints[id == 0 ? 0 : id - 1];
+        const bool isOrdered =
+            id == 0
+            || std::tie(previous.y, previous.x) < std::tie(point.y, point.x);
+        if (!isInside || !isOrdered)
+            return std::unexpected(
+                dgm::Error("Navmesh graph contains invalid jump points"));
+
+        result.jumpPointIds[point.y * size.x + point.x] = id;
+    }
 
-        if (point == from) break;
-        points.push_back(TileNavpoint(point, 0u));
-    } while (true);
-    std::reverse(points.begin(), points.end());
+    if (result.connectionOffsets.front() != 0
+        || result.connectionOffsets.back() != header.connectionCount
+        || !std::ranges::is_sorted(result.connectionOffsets)
+        || std::ranges::any_of(
+            result.connections,
+            [&](const Connection& connection)
+            { return connection.destination >= header.jumpPointCount; }))
+        return std::unexpected(
+            dgm::Error("Navmesh graph contains invalid connections"));
+
+    return result;
+}
 
-    return dgm::Path(points, false);
+dgm::Path<dgm::WorldNavpoint> dgm::WorldNavMesh::computePath(
+    const sf::Vector2f& from,
+    const sf::Vector2f& to,
+    unsigned agentRadius) const
+{
+    auto&& context = PathSearchContext();
+    return computePath(from, to, context, agentRadius);
 }
 
-// ========= WORLD NAVMESH ===========
+std::vector<dgm::Path<dgm::WorldNavpoint>> dgm::WorldNavMesh::computePaths(
+    std::span<const PathQuery> queries, dgm::WorkerPool& pool) const
+{
+    auto&& results = std::vector<dgm::Path<WorldNavpoint>>();
+    results.reserve(queries.size());
+    for (std::size_t i = 0; i < queries.size(); ++i)
+        results.emplace_back(std::vector<WorldNavpoint> {}, false);
+
+    // One task per thread, so each thread allocates a single context.
+    // Tasks pick queries one by one, so a few long queries do not stall
+    // a whole statically assigned chunk.
+    auto&& nextQuery = std::atomic_size_t(0);
+    pool.forEach(
+        std::min<std::size_t>(pool.getThreadCount(), queries.size()),
+        [&](std::size_t)
+        {
+            auto&& context = PathSearchContext(jumpPoints.size() + 2);
+            for (std::size_t i = nextQuery++; i < queries.size();
+                 i = nextQuery++)
+            {
+                const auto& query = queries[i];
+                results[i] = computePath(
+                    query.from, query.to, context, query.agentRadius);
+            }
+        });
+    return results;
+}
 
-struct WorldNode
+dgm::Path<dgm::WorldNavpoint> dgm::WorldNavMesh::computePath(
+    const sf::Vector2f& from,
+    const sf::Vector2f& to,
+    PathSearchContext& context,
+    unsigned agentRadius) const
 {
-    sf::Vector2u point = {};
-    sf::Vector2u predecessor = {};
-    unsigned gcost = 0;
-    unsigned hcost = 0;
-    unsigned fcost = 0;
+    return context.measureQuery(
+        searchTotals,
+        [&]
+        {
+            const auto query = makeSearchQuery(from, to, agentRadius);
+            auto&& status = beginSearch(query, context);
+            if (!status)
+                status = expandSearch(
+                    query, context, std::numeric_limits<std::size_t>::max());
+            if (status != PathRequestStatus::Found)
+                return dgm::Path<WorldNavpoint>(
+                    {}, false); // should be nullopt, but only since c++20
+
+            return buildPath(query, context);
+        });
+}
 
-    WorldNode() = default;
+class dgm::WorldNavMesh::RequestTask final
+    : public priv::PathSearchTask<WorldNavpoint>
+{
+public:
+    RequestTask(const WorldNavMesh& navmesh, const SearchQuery& query)
+        : navmesh(navmesh), query(query)
+    {
+    }
 
-    WorldNode(
-        const sf::Vector2u& _point,
-        const sf::Vector2u& pred,
-        const sf::Vector2u& end,
-        unsigned _gcost)
-        : point(_point), predecessor(pred), gcost(_gcost)
+public:
+    PathRequestStatus expand(std::size_t maxExpansions) override
     {
-        const unsigned dx = (point.x - end.x);
-        const unsigned dy = (point.y - end.y);
-        hcost = static_cast<unsigned>(
-            std::sqrt(static_cast<float>(dx * dx + dy * dy)));
-        fcost = gcost + hcost;
+#ifdef PATHFINDING_STATS
+        const auto start = std::chrono::steady_clock::now();
+        const auto status = expandUnmeasured(maxExpansions);
+        duration += std::chrono::steady_clock::now() - start;
+        if (status == PathRequestStatus::NotFound)
+            context.finishStats(duration, 0u, navmesh.searchTotals);
+        return status;
+#else
+        return expandUnmeasured(maxExpansions);
+#endif
     }
 
-    WorldNode(const WorldNode& other) = default;
+    dgm::Path<WorldNavpoint> buildPath() override
+    {
+        auto&& path = navmesh.buildPath(query, context);
+#ifdef PATHFINDING_STATS
+        context.finishStats(duration, path.getLength(), navmesh.searchTotals);
+#endif
+        return path;
+    }
 
-    [[nodiscard]] constexpr bool
-    isCloserThan(const WorldNode& other) const noexcept
+private:
+    PathRequestStatus expandUnmeasured(std::size_t maxExpansions)
     {
-        return fcost < other.fcost
-               || (fcost == other.fcost && hcost < other.hcost);
+        if (!started)
+        {
+            started = true;
+            if (auto&& result = navmesh.beginSearch(query, context))
+                return *result;
+        }
+        return navmesh.expandSearch(query, context, maxExpansions);
     }
+
+private:
+    const WorldNavMesh& navmesh;
+    SearchQuery query;
+    PathSearchContext context;
+    bool started = false;
+#ifdef PATHFINDING_STATS
+    std::chrono::nanoseconds duration = {};
+#endif
 };
 
-dgm::WorldNavMesh::WorldNavMesh(dgm::Mesh _mesh) : mesh(std::move(_mesh))
-{
-    auto shouldRegisterAsJumpPoint = [&](const sf::Vector2u& point)
-    {
-        /**
-         *  Test if this point is at the tip of some impassable tile, eg:
-         *  #   #
-         *  # p     <-- there the p is corner point
-         *  # # #
-         *
-         *
-         *  #   #
-         *  # p #   <-- there p is not a corner point
-         *  #   #
-         *
-         *  #   #
-         *    p     <-- multiple corners
-         *  # # #
-         */
-
-        const bool northOpened = mesh[{ point.x, point.y - 1 }] <= 0;
-        const bool westOpened = mesh[{ point.x - 1, point.y }] <= 0;
-        const bool southOpened = mesh[{ point.x, point.y + 1 }] <= 0;
-        const bool eastOpened = mesh[{ point.x + 1, point.y }] <= 0;
-        const bool northWestCorner =
-            mesh[{ point.x - 1, point.y - 1 }] > 0 && westOpened && northOpened;
-        const bool northEastCorner =
-            mesh[{ point.x + 1, point.y - 1 }] > 0 && eastOpened && northOpened;
-        const bool southWestCorner =
-            mesh[{ point.x - 1, point.y + 1 }] > 0 && westOpened && southOpened;
-        const bool southEastCorner =
-            mesh[{ point.x + 1, point.y + 1 }] > 0 && eastOpened && southOpened;
-
-        return northWestCorner || northEastCorner || southWestCorner
-               || southEastCorner;
+dgm::PathRequest<dgm::WorldNavpoint> dgm::WorldNavMesh::requestPath(
+    const sf::Vector2f& from,
+    const sf::Vector2f& to,
+    unsigned agentRadius) const
+{
+    return PathRequest<WorldNavpoint>(std::make_unique<RequestTask>(
+        *this, makeSearchQuery(from, to, agentRadius)));
+}
+
+dgm::WorldNavMesh::SearchQuery dgm::WorldNavMesh::makeSearchQuery(
+    const sf::Vector2f& from,
+    const sf::Vector2f& to,
+    unsigned agentRadius) const
+{
+    assert(agentRadius <= getMaxAgentRadius());
+    const auto tileFrom = toTileCoord(from);
+    const auto tileTo = toTileCoord(to);
+    const auto jumpPointCount = static_cast<unsigned>(jumpPoints.size());
+    return SearchQuery {
+        .from = tileFrom,
+        .to = tileTo,
+        .fromId = isJumpPoint(tileFrom) ? getJumpPointId(tileFrom)
+                                        : jumpPointCount,
+        .goalId =
+            isJumpPoint(tileTo) ? getJumpPointId(tileTo) : jumpPointCount + 1,
+        .agentRadius = agentRadius,
     };
+}
 
-    auto discoverJumpPoints = [&]
+std::optional<dgm::PathRequestStatus> dgm::WorldNavMesh::beginSearch(
+    const SearchQuery& query, PathSearchContext& context) const
+{
+    // Early search pruning
+    if (query.from == query.to) // Identity
+        return PathRequestStatus::Found;
+    // Destination is a wall or the agent does not fit there
+    else if (!clearance.canFit(query.to, query.agentRadius))
+        return PathRequestStatus::NotFound;
+    // Start can lie in a wall when an agent is pushed into it, the search
+    // then starts from the closest jump points it sees
+    else if (
+        mesh[query.from] <= 0
+        && !components.areConnected(query.from, query.to))
+        return PathRequestStatus::NotFound;
+
+    linkQueryPointsToTheNetwork(
+        query.from, query.to, query.agentRadius, context);
+
+    // Goal that is not a jump point is only reachable through its links
+    auto& goalDistances = context.goalLandmarkDistances;
+    if (query.goalId < jumpPoints.size())
     {
-        for (unsigned y = 1; y < mesh.getDataSize().y - 1; y++)
+        const auto row = landmarks.getDistances(query.goalId);
+        goalDistances.assign(row.begin(), row.end());
+    }
+    else
+    {
+        constexpr unsigned UNREACHABLE = priv::LandmarkDistances::UNREACHABLE;
+        goalDistances.assign(landmarks.getLandmarks().size(), UNREACHABLE);
+        for (auto&& link : context.goalLinks)
         {
-            for (unsigned x = 1; x < mesh.getDataSize().x - 1; x++)
+            const auto row = landmarks.getDistances(link.id);
+            for (std::size_t i = 0; i < row.size(); ++i)
             {
-                // Skip impassable blocks
-                if (mesh[{ x, y }] > 0) continue;
-
-                const sf::Vector2u point(x, y);
-                if (shouldRegisterAsJumpPoint(point))
-                {
-                    jumpPointConnections[point] = {};
-                }
+                if (row[i] == UNREACHABLE) continue;
+                goalDistances[i] =
+                    custom::min(goalDistances[i], row[i] + link.distance);
             }
         }
+    }
+
+    dgm::priv::astarBegin(
+        context.space,
+        jumpPoints.size() + 2,
+        query.fromId,
+        [&](unsigned) { return getEuclideanDistance(query.from, query.to); });
+    return std::nullopt;
+}
+
+dgm::PathRequestStatus dgm::WorldNavMesh::expandSearch(
+    const SearchQuery& query,
+    PathSearchContext& context,
+    std::size_t maxExpansions) const
+{
+    const auto jumpPointCount = static_cast<unsigned>(jumpPoints.size());
+    const bool isStartJumpPoint = query.fromId < jumpPointCount;
+    auto&& toPoint = [&](unsigned id)
+    {
+        if (id < jumpPointCount) return jumpPoints[id];
+        return id == jumpPointCount ? query.from : query.to;
     };
 
-    discoverJumpPoints();
+    // Landmark bound is exact in the units of connection distances,
+    // straight line distance is only kept for graphs without landmarks
+    auto&& heuristic = [&](unsigned id)
+    {
+        const unsigned distance = getEuclideanDistance(toPoint(id), query.to);
+        if (id >= jumpPointCount) return distance;
+        return custom::max(
+            distance,
+            priv::LandmarkDistances::getLowerBound(
+                landmarks.getDistances(id), context.goalLandmarkDistances));
+    };
+
+    const auto status = dgm::priv::astarExpand(
+        context.space,
+        query.goalId,
+        heuristic,
+        [&](unsigned id, auto&& visit)
+        {
+            if (id == query.fromId && !isStartJumpPoint)
+            {
+                for (auto&& link : context.startLinks)
+                    visit(link.id, link.distance);
+                return;
+            }
+
+            for (auto&& conn : getConnections(id))
+            {
+                if (conn.clearance > query.agentRadius)
+                    visit(conn.destination, conn.distance);
+            }
 
-    for (auto&& [point, _] : jumpPointConnections)
-        discoverConnectionsForJumpPoint(point, false);
+            // Only a handful of jump points see the goal, linear scan is
+            // cheaper than any lookup structure
+            for (auto&& link : context.goalLinks)
+            {
+                if (link.id == id) visit(query.goalId, link.distance);
+            }
+        },
+        maxExpansions);
+
+    if (status == priv::AstarStatus::InProgress)
+        return PathRequestStatus::InProgress;
+    return status == priv::AstarStatus::GoalReached
+               ? PathRequestStatus::Found
+               : PathRequestStatus::NotFound;
 }
 
-static dgm::Path<dgm::WorldNavpoint> convertRawPathToWorldPath(
-    const NodeSet<WorldNode>& rawPath,
-    const sf::Vector2u& tileFrom,
-    const sf::Vector2u& tileTo,
-    std::function<dgm::WorldNavpoint(const sf::Vector2u&)> toWorldNavpoint)
+dgm::Path<dgm::WorldNavpoint> dgm::WorldNavMesh::buildPath(
+    const SearchQuery& query, PathSearchContext& context) const
 {
-    if (!rawPath.hasElements())
-        return dgm::Path<dgm::WorldNavpoint>(
-            {}, false); // should be nullopt (c++20)
-
-    std::vector<dgm::WorldNavpoint> points;
-    points.push_back(toWorldNavpoint(tileTo));
+    auto& points = context.worldPoints;
+    points.clear();
+    if (query.from == query.to) return dgm::Path<WorldNavpoint>(points, false);
 
-    sf::Vector2u point = tileTo;
-    do
+    const auto jumpPointCount = static_cast<unsigned>(jumpPoints.size());
+    for (unsigned id = query.goalId; id != query.fromId;
+         id = context.space.getParent(id))
     {
-        const auto node = rawPath.getNode(point);
-        point = node.predecessor;
-        if (point == tileFrom) break;
+        const auto point = id < jumpPointCount ? jumpPoints[id] : query.to;
         points.push_back(toWorldNavpoint(point));
-    } while (true);
+    }
     std::reverse(points.begin(), points.end());
 
-    return dgm::Path<dgm::WorldNavpoint>(points, false);
+    return dgm::Path<WorldNavpoint>(points, false);
 }
 
-dgm::Path<dgm::WorldNavpoint>
-dgm::WorldNavMesh::computePath(const sf::Vector2f& from, const sf::Vector2f& to)
+void dgm::WorldNavMesh::setTile(const sf::Vector2u& tile, int value)
 {
-    const auto&& tileFrom = toTileCoord(from);
-    const auto&& tileTo = toTileCoord(to);
-    const auto&& wasTileFromOriginallyJumpPoint = isJumpPoint(tileFrom);
-    const auto&& wasTileToOriginallyJumpPoint = isJumpPoint(tileTo);
+    auto& current = mesh[tile];
+    const bool passabilityChanged = (current > 0) != (value > 0);
+    current = value;
 
-    // Early search pruning
-    if (tileFrom == tileTo) // Identity
-        return dgm::Path<WorldNavpoint>({}, false);
-    else if (mesh[tileTo] > 0) // Destination is a wall
-        return dgm::Path<WorldNavpoint>(
-            {}, false); // should be nullopt, but only since c++20
-
-    connectToAndFromPointsToTheNetwork(tileFrom, tileTo);
-
-    // A*
-    auto&& insertCoordIntoOpenSetIfNotInClosedSetAlready =
-        [&](NodeSet<WorldNode>& openSet,
-            const sf::Vector2u& coord,
-            const NodeSet<WorldNode>& closedSet) -> void
-    {
-        const auto node = closedSet.getNode(coord);
-        for (auto&& conn : jumpPointConnections[coord])
+    if (!passabilityChanged) return;
+
+    components.updateTile(mesh, tile);
+    clearance.updateTile(mesh, tile);
+    repairGraph(TileBounds { .min = tile, .max = tile });
+}
+
+void dgm::WorldNavMesh::updateRegion(
+    const dgm::Mesh& source, const sf::Rect<unsigned>& region)
+{
+    assert(source.getDataSize() == mesh.getDataSize());
+
+    const auto& size = mesh.getDataSize();
+    const auto end = sf::Vector2u(
+        custom::min(region.position.x + region.size.x, size.x),
+        custom::min(region.position.y + region.size.y, size.y));
+
+    auto&& changed = std::optional<TileBounds>();
+    for (unsigned y = region.position.y; y < end.y; ++y)
+    {
+        for (unsigned x = region.position.x; x < end.x; ++x)
         {
-            if (!closedSet.contains(
-                    conn.destination)) // Do not re-evaluate node which we've
-                                       // already visited on faster route
-                openSet.insertNode(WorldNode(
-                    conn.destination,
-                    coord,
-                    tileTo,
-                    node.gcost + static_cast<unsigned>(conn.distance)));
+            const auto tile = sf::Vector2u(x, y);
+            auto& current = mesh[tile];
+            const int value = source[tile];
+            const bool passabilityChanged = (current > 0) != (value > 0);
+            current = value;
+
+            if (!passabilityChanged) continue;
+
+            components.updateTile(mesh, tile);
+            if (!changed)
+            {
+                changed = TileBounds { .min = tile, .max = tile };
+                continue;
+            }
+
+            changed->min.x = custom::min(changed->min.x, x);
+            changed->min.y = custom::min(changed->min.y, y);
+            changed->max.x = custom::max(changed->max.x, x);
+            changed->max.y = custom::max(changed->max.y, y);
         }
+    }
+
+    if (!changed) return;
+
+    clearance.updateRegion(
+        mesh,
+        sf::Rect<unsigned>(
+            changed->min,
+            changed->max - changed->min + sf::Vector2u(1u, 1u)));
+    repairGraph(*changed);
+}
+
+bool dgm::WorldNavMesh::shouldBeJumpPoint(const sf::Vector2u& point) const
+{
+    /**
+     *  Test if this point is at the tip of some impassable tile, eg:
+     *  #   #
+     *  # p     <-- there the p is corner point
+     *  # # #
+     *
+     *
+     *  #   #
+     *  # p #   <-- there p is not a corner point
+     *  #   #
+     *
+     *  #   #
+     *    p     <-- multiple corners
+     *  # # #
+     *
+     *  An agent with radius r does not fit on tiles with clearance up
+     *  to r, so for it, such tiles are impassable. A corner for any
+     *  radius up to the maximum makes the point a jump point.
+     */
+
+    // Skip impassable blocks
+    if (mesh[point] > 0) return false;
+
+    const unsigned maxAgentRadius = getMaxAgentRadius();
+    const unsigned center = clearance.getClearance(point);
+    const unsigned north = clearance.getClearance({ point.x, point.y - 1 });
+    const unsigned west = clearance.getClearance({ point.x - 1, point.y });
+    const unsigned south = clearance.getClearance({ point.x, point.y + 1 });
+    const unsigned east = clearance.getClearance({ point.x + 1, point.y });
+    auto&& isCorner =
+        [&](const sf::Vector2u& tip, unsigned side1, unsigned side2)
+    {
+        const unsigned tipClearance = clearance.getClearance(tip);
+        return tipClearance <= maxAgentRadius
+               && tipClearance < std::min({ center, side1, side2 });
     };
 
-    auto&& rawPath = astarSearch<WorldNode>(
-        WorldNode(tileFrom, {}, tileTo, 0),
-        tileTo,
-        insertCoordIntoOpenSetIfNotInClosedSetAlready);
+    return isCorner({ point.x - 1, point.y - 1 }, west, north)
+           || isCorner({ point.x + 1, point.y - 1 }, east, north)
+           || isCorner({ point.x - 1, point.y + 1 }, west, south)
+           || isCorner({ point.x + 1, point.y + 1 }, east, south);
+}
 
-    eraseFromAndToPointsFromTheNetwork(
-        tileFrom,
-        wasTileFromOriginallyJumpPoint,
-        tileTo,
-        wasTileToOriginallyJumpPoint);
+void dgm::WorldNavMesh::repairGraph(const TileBounds& changedTiles)
+{
+    const auto& size = mesh.getDataSize();
+    if (size.x < 3 || size.y < 3) return;
+
+    // Clearance, which jump points and connections of larger agents
+    // depend on, changes up to maxAgentRadius tiles from the change
+    const unsigned margin = getMaxAgentRadius();
+    const auto changed = TileBounds {
+        .min = sf::Vector2u(
+            changedTiles.min.x - custom::min(changedTiles.min.x, margin),
+            changedTiles.min.y - custom::min(changedTiles.min.y, margin)),
+        .max = changedTiles.max + sf::Vector2u(margin, margin),
+    };
 
-    return convertRawPathToWorldPath(
-        rawPath,
-        tileFrom,
-        tileTo,
-        [&](const sf::Vector2u& vec) { return toWorldNavpoint(vec); });
+    // Whether a tile is a jump point depends on its 3x3 neighborhood.
+    // Border tiles are never jump points.
+    const auto first = sf::Vector2u(
+        custom::max(changed.min.x, 2u) - 1, custom::max(changed.min.y, 2u) - 1);
+    const auto last = sf::Vector2u(
+        custom::min(changed.max.x + 1, size.x - 2),
+        custom::min(changed.max.y + 1, size.y - 2));
+
+    // Removed jump points only vanish from the lookup grid for now,
+    // the graph arrays are compacted below
+    auto&& added = std::vector<sf::Vector2u>();
+    for (unsigned y = first.y; y <= last.y; ++y)
+    {
+        for (unsigned x = first.x; x <= last.x; ++x)
+        {
+            const sf::Vector2u point(x, y);
+            const bool was = isJumpPoint(point);
+            const bool should = shouldBeJumpPoint(point);
+
+            if (was && !should)
+                jumpPointIds[y * size.x + x] = NO_JUMP_POINT;
+            else if (!was && should)
+                added.push_back(point);
+        }
+    }
+
+    // Discovery stops one step past the last tile it recorded and the stop
+    // condition of diagonal seekers reads neighbors of that tile, so the
+    // connections depend on tiles up to two steps outside of the bounds.
+    // Jump points that appeared or vanished are within the bounds of every
+    // discovery that tested them.
+    auto&& isAffected = [&](const TileBounds& bounds)
+    {
+        return bounds.min.x <= changed.max.x + 2
+               && changed.min.x <= bounds.max.x + 2
+               && bounds.min.y <= changed.max.y + 2
+               && changed.min.y <= bounds.max.y + 2;
+    };
+
+    // Surviving jump points keep their relative order, new ones are
+    // appended. Connections of unaffected jump points are copied over
+    // with renumbered destinations.
+    auto&& oldToNew = std::vector<unsigned>(jumpPoints.size(), NO_JUMP_POINT);
+    auto&& newToOld = std::vector<unsigned>();
+    auto&& newPoints = std::vector<sf::Vector2u>();
+    auto&& newBounds = std::vector<TileBounds>();
+    newToOld.reserve(jumpPoints.size() + added.size());
+    newPoints.reserve(jumpPoints.size() + added.size());
+    newBounds.reserve(jumpPoints.size() + added.size());
+
+    for (unsigned oldId = 0; oldId < jumpPoints.size(); ++oldId)
+    {
+        if (getJumpPointId(jumpPoints[oldId]) != oldId) continue;
+
+        oldToNew[oldId] = static_cast<unsigned>(newPoints.size());
+        newToOld.push_back(
+            isAffected(jumpPointScanBounds[oldId]) ? NO_JUMP_POINT : oldId);
+        newPoints.push_back(jumpPoints[oldId]);
+        newBounds.push_back(jumpPointScanBounds[oldId]);
+    }
+
+    for (auto&& point : added)
+    {
+        newToOld.push_back(NO_JUMP_POINT);
+        newPoints.push_back(point);
+        newBounds.push_back(TileBounds {});
+    }
+
+    for (unsigned id = 0; id < newPoints.size(); ++id)
+        jumpPointIds[newPoints[id].y * size.x + newPoints[id].x] = id;
+
+    auto&& newOffsets = std::vector<unsigned>();
+    auto&& newConnections = std::vector<Connection>();
+    newOffsets.reserve(newPoints.size() + 1);
+    newConnections.reserve(connections.size());
+
+    const auto oldOffsets = std::move(connectionOffsets);
+    const auto oldConnections = std::move(connections);
+    jumpPoints = std::move(newPoints);
+    jumpPointScanBounds = std::move(newBounds);
+
+    for (unsigned id = 0; id < jumpPoints.size(); ++id)
+    {
+        newOffsets.push_back(static_cast<unsigned>(newConnections.size()));
+
+        const unsigned oldId = newToOld[id];
+        if (oldId == NO_JUMP_POINT)
+        {
+            discoverConnectionsForJumpPoint(id, newConnections);
+            continue;
+        }
+
+        for (unsigned i = oldOffsets[oldId]; i < oldOffsets[oldId + 1]; ++i)
+        {
+            const auto& connection = oldConnections[i];
+            assert(oldToNew[connection.destination] != NO_JUMP_POINT);
+            newConnections.push_back(Connection {
+                .destination = oldToNew[connection.destination],
+                .distance = connection.distance,
+                .clearance = connection.clearance });
+        }
+    }
+    newOffsets.push_back(static_cast<unsigned>(newConnections.size()));
+
+    connectionOffsets = std::move(newOffsets);
+    connections = std::move(newConnections);
+
+    if (landmarkCount > 0) computeLandmarks();
+}
+
+void dgm::WorldNavMesh::buildLandmarks(unsigned _landmarkCount)
+{
+    landmarkCount = _landmarkCount;
+    computeLandmarks();
+}
+
+void dgm::WorldNavMesh::computeLandmarks()
+{
+    landmarks = priv::computeLandmarkDistances(
+        jumpPoints.size(),
+        landmarkCount,
+        [](unsigned) { return true; },
+        [&](unsigned id, auto&& visit)
+        {
+            for (auto&& conn : getConnections(id))
+                visit(conn.destination, conn.distance);
+        });
 }
 
 void dgm::WorldNavMesh::discoverConnectionsForJumpPoint(
-    const sf::Vector2u& point, bool symmetricConnection)
+    unsigned id, std::vector<Connection>& output)
+{
+    const auto point = jumpPoints[id];
+    auto& bounds = jumpPointScanBounds[id];
+    bounds = TileBounds { .min = point, .max = point };
+
+    forEachReachableJumpPoint(
+        point,
+        [&](const sf::Vector2u& p)
+        {
+            // Every tile the discovery passes through is tested here
+            bounds.min.x = custom::min(bounds.min.x, p.x);
+            bounds.min.y = custom::min(bounds.min.y, p.y);
+            bounds.max.x = custom::max(bounds.max.x, p.x);
+            bounds.max.y = custom::max(bounds.max.y, p.y);
+            return isJumpPoint(p);
+        },
+        [&](const sf::Vector2u& destination, unsigned pathClearance)
+        {
+            output.push_back(Connection {
+                .destination = getJumpPointId(destination),
+                .distance = getConnectionDistance(point, destination),
+                .clearance = pathClearance });
+        });
+}
+
+template<class IsJumpPointPredicate, class OnFoundCallback>
+void dgm::WorldNavMesh::forEachReachableJumpPoint(
+    const sf::Vector2u& point,
+    IsJumpPointPredicate&& isJumpPoint,
+    OnFoundCallback&& onFound) const
 {
     using namespace dgm::priv;
 
-    auto&& discoverConnectionsInDirection =
-        [&](sf::Vector2u seeker,
-            std::function<sf::Vector2u(const sf::Vector2u&)> advance,
-            std::function<bool(const sf::Vector2u, const dgm::Mesh&)>
-                shouldStopAdvancing)
+    // Agent moving diagonally also sweeps over both tiles next to the step
+    auto&& getStepClearance =
+        [&](const sf::Vector2u& previous, const sf::Vector2u& next)
+    {
+        const unsigned tile = clearance.getClearance(next);
+        if (previous.x == next.x || previous.y == next.y) return tile;
+        return std::min(
+            { tile,
+              clearance.getClearance({ previous.x, next.y }),
+              clearance.getClearance({ next.x, previous.y }) });
+    };
+
+    auto&& discoverConnectionsInDirection = [&](sf::Vector2u previous,
+                                                sf::Vector2u seeker,
+                                                auto advance,
+                                                auto shouldStopAdvancing,
+                                                unsigned pathClearance)
     {
         while (true)
         {
-            if (shouldStopAdvancing(seeker, mesh))
-                return seeker;
-            else if (isJumpPoint(seeker))
+            if (shouldStopAdvancing(seeker, mesh)) return seeker;
+
+            pathClearance = std::min(
+                pathClearance, getStepClearance(previous, seeker));
+            if (isJumpPoint(seeker))
             {
-                connectTwoJumpPoints(point, seeker, symmetricConnection);
+                onFound(seeker, pathClearance);
                 return seeker;
             }
+            previous = seeker;
             seeker = advance(seeker);
         }
     };
 
+    const unsigned maxClearance = clearance.getMaxClearance();
+
     // Discover vertical connections
     auto&& ystop1 = discoverConnectionsInDirection(
-        advanceUp(point), advanceUp, shouldStopStraightDiscovery);
+        point,
+        advanceUp(point),
+        advanceUp,
+        shouldStopStraightDiscovery,
+        maxClearance);
     auto&& ystop2 = discoverConnectionsInDirection(
-        advanceDown(point), advanceDown, shouldStopStraightDiscovery);
+        point,
+        advanceDown(point),
+        advanceDown,
+        shouldStopStraightDiscovery,
+        maxClearance);
 
     // Discover horizontal connections
     auto&& xstop1 = discoverConnectionsInDirection(
-        advanceLeft(point), advanceLeft, shouldStopStraightDiscovery);
+        point,
+        advanceLeft(point),
+        advanceLeft,
+        shouldStopStraightDiscovery,
+        maxClearance);
     auto&& xstop2 = discoverConnectionsInDirection(
-        advanceRight(point), advanceRight, shouldStopStraightDiscovery);
-
+        point,
+        advanceRight(point),
+        advanceRight,
+        shouldStopStraightDiscovery,
+        maxClearance);
+
+    // Diagonal rays branch off a straight ray, so they start with the
+    // clearance of the straight part. The point itself is excluded.
+    unsigned straightClearance = maxClearance;
     for (unsigned y = point.y - 1; y > ystop1.y; --y)
     {
+        const auto branch = sf::Vector2u(point.x, y + 1);
+        if (branch != point)
+            straightClearance = std::min(
+                straightClearance, clearance.getClearance(branch));
         discoverConnectionsInDirection(
-            { point.x - 1, y }, advanceUpLeft, shouldStopUpLeftDiscovery);
+            branch,
+            { point.x - 1, y },
+            advanceUpLeft,
+            shouldStopUpLeftDiscovery,
+            straightClearance);
         discoverConnectionsInDirection(
-            { point.x + 1, y }, advanceUpRight, shouldStopUpRightDiscovery);
+            branch,
+            { point.x + 1, y },
+            advanceUpRight,
+            shouldStopUpRightDiscovery,
+            straightClearance);
     }
 
+    straightClearance = maxClearance;
     for (unsigned y = point.y + 1; y < ystop2.y; ++y)
     {
+        const auto branch = sf::Vector2u(point.x, y - 1);
+        if (branch != point)
+            straightClearance = std::min(
+                straightClearance, clearance.getClearance(branch));
         discoverConnectionsInDirection(
-            { point.x - 1, y }, advanceDownLeft, shouldStopDownLeftDiscovery);
+            branch,
+            { point.x - 1, y },
+            advanceDownLeft,
+            shouldStopDownLeftDiscovery,
+            straightClearance);
         discoverConnectionsInDirection(
-            { point.x + 1, y }, advanceDownRight, shouldStopDownRightDiscovery);
+            branch,
+            { point.x + 1, y },
+            advanceDownRight,
+            shouldStopDownRightDiscovery,
+            straightClearance);
     }
 
     // starting at point.x - 1 would duplicate diagonal ray
+    straightClearance = maxClearance;
     for (unsigned x = point.x - 2; point.x > 1 && x > xstop1.x; --x)
     {
+        const auto branch = sf::Vector2u(x + 1, point.y);
+        straightClearance =
+            std::min(straightClearance, clearance.getClearance(branch));
         discoverConnectionsInDirection(
-            { x, point.y - 1 }, advanceUpLeft, shouldStopUpLeftDiscovery);
+            branch,
+            { x, point.y - 1 },
+            advanceUpLeft,
+            shouldStopUpLeftDiscovery,
+            straightClearance);
         discoverConnectionsInDirection(
-            { x, point.y + 1 }, advanceDownLeft, shouldStopDownLeftDiscovery);
+            branch,
+            { x, point.y + 1 },
+            advanceDownLeft,
+            shouldStopDownLeftDiscovery,
+            straightClearance);
     }
 
     // starting at point.x + 1 would duplicate diagonal ray
+    straightClearance = maxClearance;
     for (unsigned x = point.x + 2;
          point.x < mesh.getDataSize().x - 1 && x < xstop2.x;
          ++x)
     {
+        const auto branch = sf::Vector2u(x - 1, point.y);
+        straightClearance =
+            std::min(straightClearance, clearance.getClearance(branch));
         discoverConnectionsInDirection(
-            { x, point.y - 1 }, advanceUpRight, shouldStopUpRightDiscovery);
+            branch,
+            { x, point.y - 1 },
+            advanceUpRight,
+            shouldStopUpRightDiscovery,
+            straightClearance);
         discoverConnectionsInDirection(
-            { x, point.y + 1 }, advanceDownRight, shouldStopDownRightDiscovery);
+            branch,
+            { x, point.y + 1 },
+            advanceDownRight,
+            shouldStopDownRightDiscovery,
+            straightClearance);
     }
 }
 
-void dgm::WorldNavMesh::connectTwoJumpPoints(
-    const sf::Vector2u& a, const sf::Vector2u& b, bool symmetricConnection)
+unsigned dgm::WorldNavMesh::getConnectionDistance(
+    const sf::Vector2u& a, const sf::Vector2u& b) const
 {
     const float dx = (static_cast<float>(a.x) - b.x) * mesh.getVoxelSize().x;
     const float dy = (static_cast<float>(a.y) - b.y) * mesh.getVoxelSize().y;
-    const unsigned distance =
-        static_cast<unsigned>(std::sqrt(dx * dx + dy * dy));
-
-    if (symmetricConnection)
-        jumpPointConnections[b].push_back(Connection(a, distance));
-    jumpPointConnections[a].push_back(Connection(b, distance));
+    return static_cast<unsigned>(std::sqrt(dx * dx + dy * dy));
 }
 
-void dgm::WorldNavMesh::connectToAndFromPointsToTheNetwork(
-    const sf::Vector2u& tileFrom, const sf::Vector2u& tileTo)
+void dgm::WorldNavMesh::linkQueryPointsToTheNetwork(
+    const sf::Vector2u& tileFrom,
+    const sf::Vector2u& tileTo,
+    unsigned agentRadius,
+    PathSearchContext& context) const
 {
-    // Unless these points are jump points, connect them to the network
+    context.startLinks.clear();
+    context.goalLinks.clear();
+
+    // Unless these points are jump points, connect them to the network.
+    // Connections are symmetric, so every jump point reachable from the
+    // goal is also able to reach the goal.
     if (!isJumpPoint(tileTo))
     {
-        // Destination needs to have connections from neighbors to itself
-        // reverse connections are only made for bookmarking so everything
-        // can be cleaned-up later
-        jumpPointConnections[tileTo] = {};
-        discoverConnectionsForJumpPoint(tileTo, true);
+        forEachReachableJumpPoint(
+            tileTo,
+            [&](const sf::Vector2u& p) { return isJumpPoint(p); },
+            [&](const sf::Vector2u& p, unsigned pathClearance)
+            {
+                if (pathClearance <= agentRadius) return;
+                context.goalLinks.push_back(PathSearchContext::Link {
+                    .id = getJumpPointId(p),
+                    .distance = getConnectionDistance(tileTo, p) });
+            });
     }
 
     if (!isJumpPoint(tileFrom))
     {
-        // At this point, destination is connected to the netwrok
-        // discovery at this point will plug the starting point to
-        // the network and with a little luck, it might find a
-        // direct path to the destination
-        discoverConnectionsForJumpPoint(tileFrom);
-    }
-}
-
-void dgm::WorldNavMesh::eraseFromAndToPointsFromTheNetwork(
-    const sf::Vector2u& tileFrom,
-    bool wasTileFromOriginallyJumpPoint,
-    const sf::Vector2u& tileTo,
-    bool wasTileToOriginallyJumpPoint)
-{
-    // Erase auxiliary connections created earlier, but only if from/to
-    // points weren't jump points to begin with
-    if (not wasTileToOriginallyJumpPoint)
-    {
-        for (auto&& conn : jumpPointConnections[tileTo])
-            jumpPointConnections[conn.destination].pop_back();
-        jumpPointConnections.erase(tileTo);
+        // Goal is treated as a jump point here, so with a little luck,
+        // a direct path to the destination is found. Goal that is not
+        // a jump point has the id right after the start.
+        const unsigned goalId = isJumpPoint(tileTo)
+                                    ? getJumpPointId(tileTo)
+                                    : static_cast<unsigned>(jumpPoints.size())
+                                          + 1;
+        forEachReachableJumpPoint(
+            tileFrom,
+            [&](const sf::Vector2u& p)
+            { return p == tileTo || isJumpPoint(p); },
+            [&](const sf::Vector2u& p, unsigned pathClearance)
+            {
+                if (pathClearance <= agentRadius) return;
+                context.startLinks.push_back(PathSearchContext::Link {
+                    .id = p == tileTo ? goalId : getJumpPointId(p),
+                    .distance = getConnectionDistance(tileFrom, p) });
+            });
     }
-
-    // source is connected in one-way only, sufficient to delete this node
-    if (not wasTileFromOriginallyJumpPoint)
-        jumpPointConnections.erase(tileFrom);
 }
 
-sf::Vector2u dgm::WorldNavMesh::toTileCoord(const sf::Vector2f& coord)
+sf::Vector2u dgm::WorldNavMesh::toTileCoord(const sf::Vector2f& coord) const
 {
     return sf::Vector2u(
         static_cast<unsigned>(coord.x) / mesh.getVoxelSize().x,
         static_cast<unsigned>(coord.y) / mesh.getVoxelSize().y);
 }
 
-dgm::WorldNavpoint dgm::WorldNavMesh::toWorldNavpoint(const sf::Vector2u& coord)
+dgm::WorldNavpoint
+dgm::WorldNavMesh::toWorldNavpoint(const sf::Vector2u& coord) const
 {
     return WorldNavpoint(
         sf::Vector2f(
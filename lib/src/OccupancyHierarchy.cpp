@@ -0,0 +1,64 @@
+#include <DGM/classes/OccupancyHierarchy.hpp>
+#include <algorithm>
+
+dgm::OccupancyHierarchy::OccupancyHierarchy(
+    const dgm::Mesh& mesh, unsigned maxLevels)
+{
+    const auto& dataSize = mesh.getDataSize();
+    const unsigned smallerSide = std::min(dataSize.x, dataSize.y);
+
+    // Blocks bigger than the smaller side of the mesh can never be fully
+    // inside of it, so there is no point in building such levels
+    for (unsigned level = 1;
+         (1u << level) <= smallerSide && (maxLevels == 0 || level <= maxLevels);
+         ++level)
+    {
+        const unsigned blockSize = 1u << level;
+        const auto size = sf::Vector2u(
+            (dataSize.x + blockSize - 1) / blockSize,
+            (dataSize.y + blockSize - 1) / blockSize);
+        levels.push_back(
+            Level { .size = size,
+                    .empty = std::vector<std::uint8_t>(size.x * size.y, 0) });
+
+        for (unsigned y = 0; y < size.y; ++y)
+        {
+            for (unsigned x = 0; x < size.x; ++x)
+                updateBlock(mesh, level, { x, y });
+        }
+    }
+}
+
+void dgm::OccupancyHierarchy::updateTile(
+    const dgm::Mesh& mesh, const sf::Vector2u& tile)
+{
+    for (unsigned level = 1; level <= getLevelCount(); ++level)
+        updateBlock(mesh, level, { tile.x >> level, tile.y >> level });
+}
+
+void dgm::OccupancyHierarchy::updateBlock(
+    const dgm::Mesh& mesh, unsigned level, const sf::Vector2u& block)
+{
+    bool empty = true;
+
+    // Each block is empty when all of its four children are empty, the
+    // children of the first level are the tiles of the mesh
+    for (unsigned y = block.y * 2; empty && y < block.y * 2 + 2; ++y)
+    {
+        for (unsigned x = block.x * 2; empty && x < block.x * 2 + 2; ++x)
+        {
+            if (level == 1)
+            {
+                empty = x < mesh.getDataSize().x && y < mesh.getDataSize().y
+                        && mesh[sf::Vector2u(x, y)] <= 0;
+            }
+            else
+            {
+                empty = isBlockEmpty(level - 1, { x, y });
+            }
+        }
+    }
+
+    auto& grid = levels[level - 1];
+    grid.empty[block.y * grid.size.x + block.x] = empty ? 1 : 0;
+}
@@ -0,0 +1,143 @@
+#include <DGM/classes/ParticleBuffer.hpp>
+#include <DGM/classes/ParticleKernels.hpp>
+#include <algorithm>
+#include <cassert>
+
+dgm::ps::ParticleBuffer::ParticleBuffer(std::size_t capacity)
+    : positionsX(capacity)
+    , positionsY(capacity)
+    , velocitiesX(capacity)
+    , velocitiesY(capacity)
+    , lifespans(capacity)
+    , initialLifespans(capacity)
+    , rotations(capacity)
+    , sizes(capacity)
+    , colors(capacity)
+    , textureRects(capacity)
+{
+}
+
+std::optional<std::size_t> dgm::ps::ParticleBuffer::spawn(
+    const sf::Vector2f& position,
+    float newSize,
+    const sf::Time& lifespan) noexcept
+{
+    if (isFull()) return std::nullopt;
+
+    const auto index = size++;
+    positionsX[index] = position.x;
+    positionsY[index] = position.y;
+    velocitiesX[index] = 0.f;
+    velocitiesY[index] = 0.f;
+    lifespans[index] = lifespan.asSeconds();
+    initialLifespans[index] = lifespan.asSeconds();
+    rotations[index] = 0.f;
+    sizes[index] = newSize;
+    colors[index] = sf::Color::White;
+    textureRects[index] = sf::IntRect();
+    return index;
+}
+
+void dgm::ps::ParticleBuffer::remove(std::size_t index) noexcept
+{
+    assert(index < size);
+    const auto last = --size;
+    positionsX[index] = positionsX[last];
+    positionsY[index] = positionsY[last];
+    velocitiesX[index] = velocitiesX[last];
+    velocitiesY[index] = velocitiesY[last];
+    lifespans[index] = lifespans[last];
+    initialLifespans[index] = initialLifespans[last];
+    rotations[index] = rotations[last];
+    sizes[index] = sizes[last];
+    colors[index] = colors[last];
+    textureRects[index] = textureRects[last];
+}
+
+void dgm::ps::ParticleBuffer::removeDead() noexcept
+{
+    // Particle moved into a freed slot is tested in the next iteration
+    for (std::size_t i = 0; i < size;)
+    {
+        if (lifespans[i] > 0.f)
+            ++i;
+        else
+            remove(i);
+    }
+}
+
+dgm::ps::ParticleColumns dgm::ps::ParticleBuffer::getColumns(
+    std::size_t first, std::size_t count) noexcept
+{
+    assert(first <= size);
+    if (count == std::dynamic_extent) count = size - first;
+    assert(first + count <= size);
+
+    return ParticleColumns {
+        .positionsX = std::span(positionsX).subspan(first, count),
+        .positionsY = std::span(positionsY).subspan(first, count),
+        .velocitiesX = std::span(velocitiesX).subspan(first, count),
+        .velocitiesY = std::span(velocitiesY).subspan(first, count),
+        .lifespans = std::span(lifespans).subspan(first, count),
+        .initialLifespans = std::span(initialLifespans).subspan(first, count),
+        .rotations = std::span(rotations).subspan(first, count),
+        .sizes = std::span(sizes).subspan(first, count),
+        .colors = std::span(colors).subspan(first, count),
+        .textureRects = std::span(textureRects).subspan(first, count),
+    };
+}
+
+void dgm::ps::ParticleBuffer::writeVertices(
+    std::span<sf::Vertex> output,
+    std::size_t first,
+    std::size_t count) const noexcept
+{
+    assert(first + count <= size);
+    assert(output.size() >= (first + count) * VERTICES_PER_PARTICLE);
+
+    // Corner offsets are computed by a vectorized kernel in blocks small
+    // enough to stay on the stack and in cache until vertices are written
+    constexpr std::size_t BLOCK_SIZE = 256;
+    float p[BLOCK_SIZE];
+    float q[BLOCK_SIZE];
+
+    const auto end = first + count;
+    for (std::size_t blockStart = first; blockStart < end;
+         blockStart += BLOCK_SIZE)
+    {
+        const auto blockSize = std::min(BLOCK_SIZE, end - blockStart);
+        ParticleKernels::computeCornerOffsets(
+            std::span(sizes).subspan(blockStart, blockSize),
+            std::span(rotations).subspan(blockStart, blockSize),
+            std::span(p, blockSize),
+            std::span(q, blockSize));
+
+        for (std::size_t j = 0; j < blockSize; ++j)
+        {
+            const auto i = blockStart + j;
+            const auto center = sf::Vector2f(positionsX[i], positionsY[i]);
+            const auto topLeft = center + sf::Vector2f(-q[j], -p[j]);
+            const auto topRight = center + sf::Vector2f(p[j], -q[j]);
+            const auto bottomRight = center + sf::Vector2f(q[j], p[j]);
+            const auto bottomLeft = center + sf::Vector2f(-p[j], q[j]);
+
+            const auto& rect = textureRects[i];
+            const auto texLeft = static_cast<float>(rect.position.x);
+            const auto texTop = static_cast<float>(rect.position.y);
+            const auto texRight =
+                static_cast<float>(rect.position.x + rect.size.x);
+            const auto texBottom =
+                static_cast<float>(rect.position.y + rect.size.y);
+
+            auto* quad = output.data() + i * VERTICES_PER_PARTICLE;
+            quad[0] = sf::Vertex { topLeft, colors[i], { texLeft, texTop } };
+            quad[1] = sf::Vertex { topRight, colors[i], { texRight, texTop } };
+            quad[2] =
+                sf::Vertex { bottomLeft, colors[i], { texLeft, texBottom } };
+            quad[3] = quad[1];
+            quad[4] =
+                sf::Vertex { bottomRight, colors[i], { texRight, texBottom } };
+            quad[5] = quad[2];
+        }
+    }
+}
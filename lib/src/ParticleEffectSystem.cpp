@@ -0,0 +1,214 @@
+#include <DGM/classes/ParticleEffectSystem.hpp>
+#include <DGM/classes/ParticleKernels.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <type_traits>
+
+namespace
+{
+    using namespace dgm::ps;
+
+    /**
+     *  Merge adjacent forces, they would only add up to the same
+     *  velocities in separate passes
+     */
+    std::vector<Affector> compileAffectors(std::span<const Affector> chain)
+    {
+        auto&& result = std::vector<Affector>();
+        for (auto&& affector : chain)
+        {
+            auto* force = std::get_if<ForceAffector>(&affector);
+            auto* previous = result.empty()
+                                 ? nullptr
+                                 : std::get_if<ForceAffector>(&result.back());
+            if (force && previous)
+                previous->acceleration += force->acceleration;
+            else
+                result.push_back(affector);
+        }
+        return result;
+    }
+
+    void apply(
+        const ForceAffector& affector,
+        const ParticleColumns& chunk,
+        float deltaTime) noexcept
+    {
+        ParticleKernels::applyForce(
+            chunk.velocitiesX, affector.acceleration.x, deltaTime);
+        ParticleKernels::applyForce(
+            chunk.velocitiesY, affector.acceleration.y, deltaTime);
+    }
+
+    void apply(
+        const DragAffector& affector,
+        const ParticleColumns& chunk,
+        float deltaTime) noexcept
+    {
+        ParticleKernels::applyDrag(chunk.velocitiesX, affector.drag, deltaTime);
+        ParticleKernels::applyDrag(chunk.velocitiesY, affector.drag, deltaTime);
+    }
+
+    void apply(
+        const SpinAffector& affector,
+        const ParticleColumns& chunk,
+        float deltaTime) noexcept
+    {
+        ParticleKernels::rotate(
+            chunk.rotations, affector.angularVelocity.asRadians(), deltaTime);
+    }
+
+    void apply(
+        const ColorOverLifeAffector& affector,
+        const ParticleColumns& chunk,
+        float) noexcept
+    {
+        auto&& blend = [](std::uint8_t start, std::uint8_t end, float remaining)
+        {
+            const float value = static_cast<float>(end)
+                                + remaining * static_cast<float>(start - end);
+            return static_cast<std::uint8_t>(
+                std::clamp(value, 0.f, 255.f) + 0.5f);
+        };
+
+        for (std::size_t i = 0; i < chunk.getSize(); ++i)
+        {
+            const float remaining =
+                chunk.lifespans[i] / chunk.initialLifespans[i];
+            chunk.colors[i] = sf::Color(
+                blend(affector.start.r, affector.end.r, remaining),
+                blend(affector.start.g, affector.end.g, remaining),
+                blend(affector.start.b, affector.end.b, remaining),
+                blend(affector.start.a, affector.end.a, remaining));
+        }
+    }
+
+    void apply(
+        const SizeOverLifeAffector& affector,
+        const ParticleColumns& chunk,
+        float) noexcept
+    {
+        ParticleKernels::interpolateOverLife(
+            chunk.sizes,
+            chunk.lifespans,
+            chunk.initialLifespans,
+            affector.start,
+            affector.end);
+    }
+} // namespace
+
+dgm::ps::ParticleEffectSystem::ParticleEffectSystem(
+    unsigned particleCount, const ParticleEffect& effect, unsigned seed)
+    : ParticleSystem(particleCount)
+    , emitters(effect.emitters)
+    , affectors(compileAffectors(effect.affectors))
+    , spawnDebts(effect.emitters.size(), 0.f)
+    , randomEngine(seed)
+{
+    for (auto&& emitter : emitters)
+    {
+        assert(emitter.minLifespan > 0.f);
+        assert(emitter.minLifespan <= emitter.maxLifespan);
+    }
+}
+
+void dgm::ps::ParticleEffectSystem::restart() noexcept
+{
+    particles.clear();
+    std::ranges::fill(spawnDebts, 0.f);
+    burstPending = true;
+}
+
+bool dgm::ps::ParticleEffectSystem::isFinished() const noexcept
+{
+    return particles.isEmpty() && !burstPending
+           && std::ranges::all_of(
+               emitters,
+               [](const Emitter& emitter) { return emitter.rate <= 0.f; });
+}
+
+void dgm::ps::ParticleEffectSystem::simulate(const dgm::Time& time)
+{
+    for (std::size_t i = 0; i < emitters.size(); ++i)
+    {
+        spawnDebts[i] += emitters[i].rate * time.getDeltaTime();
+        const auto count = static_cast<unsigned>(spawnDebts[i]);
+        spawnDebts[i] -= static_cast<float>(count);
+        emit(emitters[i], count + (burstPending ? emitters[i].burst : 0u));
+    }
+    burstPending = false;
+}
+
+void dgm::ps::ParticleEffectSystem::simulateChunk(
+    const dgm::Time& time, ParticleColumns chunk) noexcept
+{
+    const float dt = time.getDeltaTime();
+    for (auto&& affector : affectors)
+    {
+        std::visit(
+            [&](const auto& concreteAffector)
+            { apply(concreteAffector, chunk, dt); },
+            affector);
+    }
+
+    ParticleKernels::integrate(chunk.positionsX, chunk.velocitiesX, dt);
+    ParticleKernels::integrate(chunk.positionsY, chunk.velocitiesY, dt);
+    ParticleKernels::decayLifespans(chunk.lifespans, dt);
+}
+
+void dgm::ps::ParticleEffectSystem::emit(
+    const Emitter& emitter, unsigned count)
+{
+    auto&& unit = std::uniform_real_distribution(0.f, 1.f);
+    auto&& random = [&](float min, float max)
+    { return min + (max - min) * unit(randomEngine); };
+
+    for (unsigned i = 0; i < count; ++i)
+    {
+        const auto offset = std::visit(
+            [&]<class Shape>(const Shape& shape) -> sf::Vector2f
+            {
+                if constexpr (std::is_same_v<Shape, Emitter::Circle>)
+                {
+                    // Square root keeps the density uniform
+                    const float distance =
+                        shape.radius * std::sqrt(random(0.f, 1.f));
+                    const float angle =
+                        random(0.f, 2.f * std::numbers::pi_v<float>);
+                    return sf::Vector2f(std::cos(angle), std::sin(angle))
+                           * distance;
+                }
+                else if constexpr (std::is_same_v<Shape, Emitter::Rectangle>)
+                {
+                    return sf::Vector2f(
+                        random(-0.5f, 0.5f) * shape.size.x,
+                        random(-0.5f, 0.5f) * shape.size.y);
+                }
+                else
+                {
+                    return sf::Vector2f();
+                }
+            },
+            emitter.shape);
+
+        const float lifespan =
+            random(emitter.minLifespan, emitter.maxLifespan);
+        const auto index = particles.spawn(
+            emitter.position + offset,
+            random(emitter.minSize, emitter.maxSize),
+            sf::seconds(lifespan));
+        if (!index) return;
+
+        const float angle =
+            emitter.direction.asRadians()
+            + emitter.spread.asRadians() * random(-1.f, 1.f);
+        const float speed = random(emitter.minSpeed, emitter.maxSpeed);
+        particles.getVelocitiesX()[*index] = std::cos(angle) * speed;
+        particles.getVelocitiesY()[*index] = std::sin(angle) * speed;
+        particles.getColors()[*index] = emitter.color;
+        particles.getTextureRects()[*index] = emitter.textureRect;
+    }
+}
@@ -0,0 +1,185 @@
+#include <DGM/classes/ParticleKernels.hpp>
+#include <SimdLanes.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numbers>
+
+using dgm::priv::forEachLanes;
+
+namespace
+{
+    void addToAll(std::span<float> values, float delta) noexcept
+    {
+        forEachLanes(
+            values.size(),
+            [&]<class Lanes>(std::size_t i)
+            {
+                auto* data = values.data() + i;
+                (Lanes::load(data) + Lanes::broadcast(delta)).store(data);
+            });
+    }
+
+    /**
+     *  Taylor series up to x^11, error is below 1e-7 on [-pi/2, pi/2]
+     */
+    template<class Lanes>
+    Lanes sinOnHalfPeriod(Lanes x) noexcept
+    {
+        const auto x2 = x * x;
+        auto result = Lanes::broadcast(-1.f / 39916800.f);
+        result = result * x2 + Lanes::broadcast(1.f / 362880.f);
+        result = result * x2 + Lanes::broadcast(-1.f / 5040.f);
+        result = result * x2 + Lanes::broadcast(1.f / 120.f);
+        result = result * x2 + Lanes::broadcast(-1.f / 6.f);
+        result = result * x2 + Lanes::broadcast(1.f);
+        return result * x;
+    }
+
+    /**
+     *  Mirror angle from [-pi, 3pi/2] into [-pi/2, pi/2] keeping its sine
+     */
+    template<class Lanes>
+    Lanes foldIntoHalfPeriod(Lanes x) noexcept
+    {
+        constexpr float PI = std::numbers::pi_v<float>;
+        const auto halfPi = Lanes::broadcast(PI / 2.f);
+        const auto negHalfPi = Lanes::broadcast(-PI / 2.f);
+        x = select(x > halfPi, Lanes::broadcast(PI) - x, x);
+        return select(x < negHalfPi, Lanes::broadcast(-PI) - x, x);
+    }
+
+    template<class Lanes>
+    void sinCos(Lanes angle, Lanes& sin, Lanes& cos) noexcept
+    {
+        // Reduce to [-pi, pi], full turn is split so that multiples
+        // of its first part are exact for reasonable turn counts and
+        // the second part carries the precision float pi lacks
+        constexpr float TURN_HI = 6.28125f;
+        constexpr auto TURN_LO =
+            static_cast<float>(2.0 * std::numbers::pi - TURN_HI);
+        const auto turns = round(
+            angle * Lanes::broadcast(0.5f * std::numbers::inv_pi_v<float>));
+        const auto x = angle - turns * Lanes::broadcast(TURN_HI)
+                       - turns * Lanes::broadcast(TURN_LO);
+
+        sin = sinOnHalfPeriod(foldIntoHalfPeriod(x));
+        cos = sinOnHalfPeriod(foldIntoHalfPeriod(
+            x + Lanes::broadcast(std::numbers::pi_v<float> / 2.f)));
+    }
+} // namespace
+
+void dgm::ps::ParticleKernels::integrate(
+    std::span<float> positions,
+    std::span<const float> velocities,
+    float deltaTime) noexcept
+{
+    assert(positions.size() == velocities.size());
+    forEachLanes(
+        positions.size(),
+        [&]<class Lanes>(std::size_t i)
+        {
+            auto* position = positions.data() + i;
+            const auto velocity = Lanes::load(velocities.data() + i);
+            (Lanes::load(position) + velocity * Lanes::broadcast(deltaTime))
+                .store(position);
+        });
+}
+
+void dgm::ps::ParticleKernels::applyForce(
+    std::span<float> velocities, float acceleration, float deltaTime) noexcept
+{
+    addToAll(velocities, acceleration * deltaTime);
+}
+
+void dgm::ps::ParticleKernels::applyDrag(
+    std::span<float> velocities, float drag, float deltaTime) noexcept
+{
+    const float factor = std::max(0.f, 1.f - drag * deltaTime);
+    forEachLanes(
+        velocities.size(),
+        [&]<class Lanes>(std::size_t i)
+        {
+            auto* data = velocities.data() + i;
+            (Lanes::load(data) * Lanes::broadcast(factor)).store(data);
+        });
+}
+
+void dgm::ps::ParticleKernels::rotate(
+    std::span<float> rotations,
+    float angularVelocity,
+    float deltaTime) noexcept
+{
+    // Reduce the step in double, so even a huge step keeps the sum within
+    // two turns, which float reduction below handles precisely
+    constexpr double TURN = 2.0 * std::numbers::pi;
+    const auto delta = static_cast<float>(std::remainder(
+        static_cast<double>(angularVelocity) * deltaTime, TURN));
+
+    forEachLanes(
+        rotations.size(),
+        [&]<class Lanes>(std::size_t i)
+        {
+            auto* data = rotations.data() + i;
+            const auto rotation = Lanes::load(data) + Lanes::broadcast(delta);
+            const auto turns = round(
+                rotation * Lanes::broadcast(static_cast<float>(1.0 / TURN)));
+            (rotation - turns * Lanes::broadcast(static_cast<float>(TURN)))
+                .store(data);
+        });
+}
+
+void dgm::ps::ParticleKernels::decayLifespans(
+    std::span<float> lifespans, float deltaTime) noexcept
+{
+    addToAll(lifespans, -deltaTime);
+}
+
+void dgm::ps::ParticleKernels::interpolateOverLife(
+    std::span<float> values,
+    std::span<const float> lifespans,
+    std::span<const float> initialLifespans,
+    float start,
+    float end) noexcept
+{
+    assert(values.size() == lifespans.size());
+    assert(values.size() == initialLifespans.size());
+    forEachLanes(
+        values.size(),
+        [&]<class Lanes>(std::size_t i)
+        {
+            // Remaining fraction of life goes from one to zero
+            const auto remaining = Lanes::load(lifespans.data() + i)
+                                   / Lanes::load(initialLifespans.data() + i);
+            (Lanes::broadcast(end)
+             + remaining * Lanes::broadcast(start - end))
+                .store(values.data() + i);
+        });
+}
+
+void dgm::ps::ParticleKernels::computeCornerOffsets(
+    std::span<const float> sizes,
+    std::span<const float> rotations,
+    std::span<float> p,
+    std::span<float> q) noexcept
+{
+    assert(sizes.size() == rotations.size());
+    assert(sizes.size() == p.size());
+    assert(sizes.size() == q.size());
+    forEachLanes(
+        sizes.size(),
+        [&]<class Lanes>(std::size_t i)
+        {
+            Lanes sin, cos;
+            sinCos(Lanes::load(rotations.data() + i), sin, cos);
+            const auto halfSize =
+                Lanes::load(sizes.data() + i) * Lanes::broadcast(0.5f);
+            (halfSize * (cos + sin)).store(p.data() + i);
+            (halfSize * (cos - sin)).store(q.data() + i);
+        });
+}
+
+const char* dgm::ps::ParticleKernels::getInstructionSet() noexcept
+{
+    return dgm::priv::VectorLanes::INSTRUCTION_SET;
+}
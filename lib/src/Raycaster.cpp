@@ -1,29 +1,89 @@
 #include <DGM/classes/Math.hpp>
 #include <DGM/classes/Raycaster.hpp>
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 bool dgm::Raycaster::hasDirectVisibility(
     const sf::Vector2f& from,
     const sf::Vector2f& to,
     const dgm::Mesh& levelMesh)
+{
+    return traceVisibility(from, to, levelMesh, [](const sf::Vector2u&) {});
+}
+
+bool dgm::Raycaster::hasDirectVisibility(
+    const sf::Vector2f& from,
+    const sf::Vector2f& to,
+    const dgm::Mesh& levelMesh,
+    std::function<void(const sf::Vector2u&)> forEachTileCallback)
+{
+    return traceVisibility(from, to, levelMesh, forEachTileCallback);
+}
+
+bool dgm::Raycaster::hasDirectVisibility(
+    const sf::Vector2f& from,
+    const sf::Vector2f& to,
+    const dgm::Mesh& levelMesh,
+    const dgm::OccupancyHierarchy& hierarchy)
+{
+    const auto normalizedFrom =
+        from.componentWiseDiv(sf::Vector2f(levelMesh.getVoxelSize()));
+    const auto normalizedTo =
+        to.componentWiseDiv(sf::Vector2f(levelMesh.getVoxelSize()));
+    const float distance = (normalizedTo - normalizedFrom).length();
+
+    auto&& state = initializeRaycaster(normalizedFrom, to - from);
+
+    HitDirection advancementDirection {};
+    while (true)
+    {
+        if (levelMesh[state.tile] > 0) break;
+
+        if (distance < getExitDistance(state)) return true;
+
+        if (auto&& leap = leapOverEmptyBlock(state, hierarchy))
+        {
+            if (distance < leap->exitDistance) return true;
+            advancementDirection = leap->direction;
+        }
+        else
+        {
+            advancementDirection = advanceRaycaster(state);
+        }
+    }
+
+    return distance < getInterceptDistance(state, advancementDirection);
+}
+
+template<class TileCallback>
+bool dgm::Raycaster::traceVisibility(
+    const sf::Vector2f& from,
+    const sf::Vector2f& to,
+    const dgm::Mesh& levelMesh,
+    TileCallback&& forEachTileCallback)
 {
     const auto normalizedFrom =
         from.componentWiseDiv(sf::Vector2f(levelMesh.getVoxelSize()));
     const auto normalizedTo =
         to.componentWiseDiv(sf::Vector2f(levelMesh.getVoxelSize()));
+    const float distance = (normalizedTo - normalizedFrom).length();
 
     auto&& state = initializeRaycaster(normalizedFrom, to - from);
 
     HitDirection advancementDirection {};
     while (true)
     {
+        forEachTileCallback(state.tile);
         if (levelMesh[state.tile] > 0) break;
 
+        // Destination lies within current tile, no need to look further
+        if (distance < getExitDistance(state)) return true;
+
         advancementDirection = advanceRaycaster(state);
     }
 
-    return (normalizedTo - normalizedFrom).length()
-           < getInterceptDistance(state, advancementDirection);
+    return distance < getInterceptDistance(state, advancementDirection);
 }
 
 dgm::Raycaster::Result dgm::Raycaster::raycast(
@@ -84,6 +144,38 @@ dgm::Raycaster::Result dgm::Raycaster::raycast(
     };
 }
 
+dgm::Raycaster::Result dgm::Raycaster::raycast(
+    const sf::Vector2f& origin,
+    const sf::Vector2f& direction,
+    const dgm::Mesh& levelMesh,
+    const dgm::OccupancyHierarchy& hierarchy)
+{
+    auto&& normalizedFrom =
+        origin.componentWiseDiv(sf::Vector2f(levelMesh.getVoxelSize()));
+    auto&& state = initializeRaycaster(normalizedFrom, direction);
+
+    HitDirection advancementDirection {};
+    while (true)
+    {
+        if (levelMesh[state.tile] > 0) break;
+
+        if (auto&& leap = leapOverEmptyBlock(state, hierarchy))
+            advancementDirection = leap->direction;
+        else
+            advancementDirection = advanceRaycaster(state);
+    }
+
+    return Result {
+        .tile = state.tile,
+        .hitDirection = advancementDirection,
+        .hitLocation =
+            (normalizedFrom
+             + dgm::Math::toUnit(direction)
+                   * getInterceptDistance(state, advancementDirection))
+                .componentWiseMul(sf::Vector2f(levelMesh.getVoxelSize())),
+    };
+}
+
 dgm::Raycaster::RaycasterState dgm::Raycaster::initializeRaycaster(
     const sf::Vector2f& from, const sf::Vector2f& direction)
 {
@@ -123,6 +215,8 @@ dgm::Raycaster::RaycasterState dgm::Raycaster::initializeRaycaster(
         .tileStep = tileStep,
         .rayStep = rayStep,
         .intercept = intercept,
+        .firstIntercept = intercept,
+        .crossings = sf::Vector2u(0, 0),
     };
 }
 
@@ -132,11 +226,164 @@ dgm::Raycaster::advanceRaycaster(RaycasterState& state)
     if (state.intercept.x < state.intercept.y)
     {
         state.tile.x += state.tileStep.x;
-        state.intercept.x += state.rayStep.x;
+        state.intercept.x = getInterceptAfter(
+            state.firstIntercept.x, ++state.crossings.x, state.rayStep.x);
         return HitDirection::Vertical;
     }
 
     state.tile.y += state.tileStep.y;
-    state.intercept.y += state.rayStep.y;
+    state.intercept.y = getInterceptAfter(
+        state.firstIntercept.y, ++state.crossings.y, state.rayStep.y);
     return HitDirection::Horizontal;
 }
+
+std::optional<dgm::Raycaster::BlockLeap> dgm::Raycaster::leapOverEmptyBlock(
+    RaycasterState& state, const dgm::OccupancyHierarchy& hierarchy)
+{
+    // Zero direction, the ray never leaves its tile
+    if (std::isnan(state.rayStep.x) || std::isnan(state.rayStep.y))
+        return std::nullopt;
+
+    const unsigned level = hierarchy.getEmptyBlockLevel(state.tile);
+    if (level == 0) return std::nullopt;
+
+    const unsigned blockSize = 1u << level;
+    const auto blockStart = sf::Vector2u(
+        (state.tile.x >> level) << level, (state.tile.y >> level) << level);
+
+    // Number of tile boundaries the ray has to cross on each axis to leave
+    // the block through that axis
+    const unsigned stepsX = state.tileStep.x > 0
+                                ? blockStart.x + blockSize - state.tile.x
+                                : state.tile.x - blockStart.x + 1;
+    const unsigned stepsY = state.tileStep.y > 0
+                                ? blockStart.y + blockSize - state.tile.y
+                                : state.tile.y - blockStart.y + 1;
+
+    const float exitX = getInterceptAfter(
+        state.firstIntercept.x,
+        state.crossings.x + stepsX - 1,
+        state.rayStep.x);
+    const float exitY = getInterceptAfter(
+        state.firstIntercept.y,
+        state.crossings.y + stepsY - 1,
+        state.rayStep.y);
+
+    // Ties are resolved the same way as in advanceRaycaster, so the ray
+    // ends up in the same tile as if it was advanced one tile at a time
+    auto crossings = sf::Vector2u(stepsX, stepsY);
+    const auto direction =
+        exitX < exitY ? HitDirection::Vertical : HitDirection::Horizontal;
+    if (direction == HitDirection::Vertical)
+    {
+        crossings.y = countCrossingsBefore(
+            state.firstIntercept.y,
+            state.crossings.y,
+            state.rayStep.y,
+            stepsY - 1,
+            exitX,
+            true);
+    }
+    else
+    {
+        crossings.x = countCrossingsBefore(
+            state.firstIntercept.x,
+            state.crossings.x,
+            state.rayStep.x,
+            stepsX - 1,
+            exitY,
+            false);
+    }
+
+    state.tile.x += state.tileStep.x * static_cast<int>(crossings.x);
+    state.tile.y += state.tileStep.y * static_cast<int>(crossings.y);
+    state.crossings += crossings;
+    state.intercept = sf::Vector2f(
+        getInterceptAfter(
+            state.firstIntercept.x, state.crossings.x, state.rayStep.x),
+        getInterceptAfter(
+            state.firstIntercept.y, state.crossings.y, state.rayStep.y));
+
+    return BlockLeap {
+        .direction = direction,
+        .exitDistance = direction == HitDirection::Vertical ? exitX : exitY,
+    };
+}
+
+unsigned dgm::Raycaster::countCrossingsBefore(
+    float firstIntercept,
+    unsigned crossings,
+    float rayStep,
+    unsigned maxCount,
+    float limit,
+    bool inclusive)
+{
+    auto&& isBefore = [&](unsigned index)
+    {
+        const float distance =
+            getInterceptAfter(firstIntercept, crossings + index, rayStep);
+        return inclusive ? distance <= limit : distance < limit;
+    };
+
+    if (maxCount == 0 || !isBefore(0)) return 0;
+
+    // Estimate the count directly and then fix possible rounding errors
+    // so the result matches the comparisons made in advanceRaycaster
+    const float nextIntercept =
+        getInterceptAfter(firstIntercept, crossings, rayStep);
+    const float estimate = std::min(
+        std::floor((limit - nextIntercept) / rayStep) + 1.f,
+        static_cast<float>(maxCount));
+
+    unsigned count = estimate > 1.f ? static_cast<unsigned>(estimate) : 1u;
+    while (count > 1 && !isBefore(count - 1))
+        --count;
+    while (count < maxCount && isBefore(count))
+        ++count;
+    return count;
+}
+
+std::optional<float> dgm::Raycaster::getRayDistance(
+    const sf::Vector2f& origin,
+    const sf::Vector2f& direction,
+    const dgm::Circle& circle) noexcept
+{
+    const auto toOrigin = origin - circle.getPosition();
+    const float c =
+        toOrigin.lengthSquared() - circle.getRadius() * circle.getRadius();
+    if (c <= 0.f) return 0.f;
+
+    const float b = toOrigin.dot(direction);
+    const float discriminant = b * b - c;
+    if (b > 0.f || discriminant < 0.f) return std::nullopt;
+
+    return -b - std::sqrt(discriminant);
+}
+
+std::optional<float> dgm::Raycaster::getRayDistance(
+    const sf::Vector2f& origin,
+    const sf::Vector2f& direction,
+    const dgm::Rect& rect) noexcept
+{
+    float enter = 0.f;
+    float exit = std::numeric_limits<float>::infinity();
+
+    auto&& clip = [&](float start, float dir, float min, float max)
+    {
+        if (dir == 0.f) return start >= min && start <= max;
+
+        const float t1 = (min - start) / dir;
+        const float t2 = (max - start) / dir;
+        enter = std::max(enter, std::min(t1, t2));
+        exit = std::min(exit, std::max(t1, t2));
+        return enter <= exit;
+    };
+
+    const auto& position = rect.getPosition();
+    const auto& size = rect.getSize();
+    if (!clip(origin.x, direction.x, position.x, position.x + size.x)
+        || !clip(origin.y, direction.y, position.y, position.y + size.y))
+        return std::nullopt;
+
+    return enter;
+}
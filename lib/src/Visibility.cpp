@@ -0,0 +1,313 @@
+#include <DGM/classes/Visibility.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numbers>
+
+namespace
+{
+    // Transformations mapping the canonical octant (rows going up, columns
+    // going left from the center) onto all eight octants
+    constexpr std::array OCTANTS = {
+        std::array { 1, 0, 0, -1 },  std::array { 0, 1, -1, 0 },
+        std::array { 0, -1, -1, 0 }, std::array { -1, 0, 0, -1 },
+        std::array { -1, 0, 0, 1 },  std::array { 0, -1, 1, 0 },
+        std::array { 0, 1, 1, 0 },   std::array { 1, 0, 0, 1 },
+    };
+
+    // Number of rays approximating the view circle in directions that are not
+    // blocked by any wall
+    constexpr unsigned ARC_SEGMENTS = 64;
+
+    // Angular offset used to probe both sides of every polygon vertex
+    constexpr float ANGLE_EPSILON = 1e-4f;
+
+    [[nodiscard]] bool isInMesh(int x, int y, const dgm::Mesh& mesh) noexcept
+    {
+        return x >= 0 && y >= 0
+               && static_cast<unsigned>(x) < mesh.getDataSize().x
+               && static_cast<unsigned>(y) < mesh.getDataSize().y;
+    }
+
+    [[nodiscard]] bool isOpen(int x, int y, const dgm::Mesh& mesh) noexcept
+    {
+        return isInMesh(x, y, mesh)
+               && mesh[sf::Vector2u(
+                      static_cast<unsigned>(x), static_cast<unsigned>(y))]
+                      <= 0;
+    }
+} // namespace
+
+void dgm::Visibility::compute(
+    const sf::Vector2f& origin,
+    float radius,
+    const dgm::Mesh& levelMesh,
+    bool computePolygon)
+{
+    visibleTiles.clear();
+    litWalls.clear();
+    polygon.clear();
+
+    if (dataSize != levelMesh.getDataSize())
+    {
+        dataSize = levelMesh.getDataSize();
+        stamps.assign(dataSize.x * dataSize.y, 0u);
+        currentStamp = 0;
+    }
+
+    if (++currentStamp == 0)
+    {
+        // Stamp counter overflowed, old stamps could produce false positives
+        std::fill(stamps.begin(), stamps.end(), 0u);
+        currentStamp = 1;
+    }
+
+    const auto voxelSize = sf::Vector2f(levelMesh.getVoxelSize());
+    const auto normalizedOrigin = origin.componentWiseDiv(voxelSize);
+    const auto center = sf::Vector2i(
+        static_cast<int>(std::floor(normalizedOrigin.x)),
+        static_cast<int>(std::floor(normalizedOrigin.y)));
+
+    if (!isInMesh(center.x, center.y, levelMesh)) return;
+
+    const auto centerTile = sf::Vector2u(center);
+    const bool isCenterSolid = levelMesh[centerTile] > 0;
+    markVisible(centerTile, isCenterSolid);
+    if (isCenterSolid) return;
+
+    const auto context = CastContext {
+        .mesh = levelMesh,
+        .center = center,
+        .voxelSize = voxelSize,
+        .radiusSquared = radius * radius,
+        .radiusInTiles = static_cast<int>(
+            std::ceil(radius / std::min(voxelSize.x, voxelSize.y))),
+    };
+
+    for (auto&& [xx, xy, yx, yy] : OCTANTS)
+        castLight(context, Octant { xx, xy, yx, yy }, 1, 1.f, 0.f);
+
+    if (computePolygon) buildPolygon(origin, radius, levelMesh);
+}
+
+void dgm::Visibility::castLight(
+    const CastContext& context,
+    const Octant& octant,
+    int row,
+    float startSlope,
+    float endSlope)
+{
+    if (startSlope < endSlope) return;
+
+    float newStart = 0.f;
+    for (; row <= context.radiusInTiles; ++row)
+    {
+        bool blocked = false;
+        const int dy = -row;
+
+        for (int dx = -row; dx <= 0; ++dx)
+        {
+            const float leftSlope = (dx - 0.5f) / (dy + 0.5f);
+            const float rightSlope = (dx + 0.5f) / (dy - 0.5f);
+
+            if (startSlope < rightSlope)
+                continue;
+            else if (endSlope > leftSlope)
+                break;
+
+            const int offsetX = dx * octant.xx + dy * octant.xy;
+            const int offsetY = dx * octant.yx + dy * octant.yy;
+            const int x = context.center.x + offsetX;
+            const int y = context.center.y + offsetY;
+            const bool inMesh = isInMesh(x, y, context.mesh);
+            const bool solid = !inMesh || !isOpen(x, y, context.mesh);
+
+            const float worldDx = offsetX * context.voxelSize.x;
+            const float worldDy = offsetY * context.voxelSize.y;
+            if (inMesh
+                && worldDx * worldDx + worldDy * worldDy
+                       <= context.radiusSquared)
+            {
+                markVisible(
+                    sf::Vector2u(
+                        static_cast<unsigned>(x), static_cast<unsigned>(y)),
+                    solid);
+            }
+
+            if (blocked)
+            {
+                if (solid)
+                {
+                    newStart = rightSlope;
+                    continue;
+                }
+
+                blocked = false;
+                startSlope = newStart;
+            }
+            else if (solid && row < context.radiusInTiles)
+            {
+                // Start of a wall, light everything before it in the next
+                // rows and continue scanning behind it
+                blocked = true;
+                castLight(context, octant, row + 1, startSlope, leftSlope);
+                newStart = rightSlope;
+            }
+        }
+
+        if (blocked) break;
+    }
+}
+
+void dgm::Visibility::markVisible(const sf::Vector2u& tile, bool solid)
+{
+    auto& stamp = stamps[tile.y * dataSize.x + tile.x];
+    if (stamp == currentStamp) return;
+
+    stamp = currentStamp;
+    visibleTiles.push_back(tile);
+    if (solid) litWalls.push_back(tile);
+}
+
+void dgm::Visibility::buildPolygon(
+    const sf::Vector2f& origin, float radius, const dgm::Mesh& levelMesh)
+{
+    const auto voxelSize = sf::Vector2f(levelMesh.getVoxelSize());
+    const auto normalizedOrigin = origin.componentWiseDiv(voxelSize);
+
+    collectFaces(normalizedOrigin, levelMesh);
+
+    // Polygon vertices can only lie at face endpoints (corners of the walls)
+    // or on the view circle
+    angles.clear();
+    for (auto&& face : faces)
+    {
+        const auto a = face.vertical
+                           ? sf::Vector2f(face.position, face.from)
+                           : sf::Vector2f(face.from, face.position);
+        const auto b = face.vertical ? sf::Vector2f(face.position, face.to)
+                                     : sf::Vector2f(face.to, face.position);
+        angles.push_back(std::atan2(
+            a.y - normalizedOrigin.y, a.x - normalizedOrigin.x));
+        angles.push_back(std::atan2(
+            b.y - normalizedOrigin.y, b.x - normalizedOrigin.x));
+    }
+
+    for (unsigned i = 0; i < ARC_SEGMENTS; ++i)
+    {
+        angles.push_back(
+            -std::numbers::pi_v<float>
+            + 2.f * std::numbers::pi_v<float> * i / ARC_SEGMENTS);
+    }
+
+    std::sort(angles.begin(), angles.end());
+    angles.erase(
+        std::unique(
+            angles.begin(),
+            angles.end(),
+            [](float a, float b) { return b - a < ANGLE_EPSILON; }),
+        angles.end());
+
+    auto&& castProbe = [&](float angle)
+    {
+        const auto direction = sf::Vector2f(std::cos(angle), std::sin(angle));
+        const float maxDistance =
+            radius / direction.componentWiseMul(voxelSize).length();
+        return normalizedOrigin
+               + direction
+                     * getHitDistance(normalizedOrigin, direction, maxDistance);
+    };
+
+    // Probe both sides of each candidate angle so the polygon properly
+    // wraps around wall corners
+    for (auto&& angle : angles)
+    {
+        const auto before = castProbe(angle - ANGLE_EPSILON);
+        const auto after = castProbe(angle + ANGLE_EPSILON);
+
+        polygon.push_back(before.componentWiseMul(voxelSize));
+        if ((after - before).lengthSquared() > 1e-6f)
+            polygon.push_back(after.componentWiseMul(voxelSize));
+    }
+}
+
+void dgm::Visibility::collectFaces(
+    const sf::Vector2f& origin, const dgm::Mesh& mesh)
+{
+    faces.clear();
+
+    // Only faces of lit walls that look towards the origin and are not shared
+    // with another wall can bound the visible area
+    for (auto&& wall : litWalls)
+    {
+        const int x = static_cast<int>(wall.x);
+        const int y = static_cast<int>(wall.y);
+        const float fx = static_cast<float>(x);
+        const float fy = static_cast<float>(y);
+
+        if (origin.x < fx && isOpen(x - 1, y, mesh))
+            faces.push_back(Face { true, fx, fy, fy + 1.f });
+        if (origin.x > fx + 1.f && isOpen(x + 1, y, mesh))
+            faces.push_back(Face { true, fx + 1.f, fy, fy + 1.f });
+        if (origin.y < fy && isOpen(x, y - 1, mesh))
+            faces.push_back(Face { false, fy, fx, fx + 1.f });
+        if (origin.y > fy + 1.f && isOpen(x, y + 1, mesh))
+            faces.push_back(Face { false, fy + 1.f, fx, fx + 1.f });
+    }
+
+    // Merge collinear neighboring faces into long segments, this greatly
+    // reduces the number of polygon vertex candidates along straight walls
+    std::sort(
+        faces.begin(),
+        faces.end(),
+        [](const Face& a, const Face& b)
+        {
+            if (a.vertical != b.vertical) return a.vertical;
+            if (a.position != b.position) return a.position < b.position;
+            return a.from < b.from;
+        });
+
+    std::size_t merged = 0;
+    for (std::size_t i = 1; i < faces.size(); ++i)
+    {
+        auto& last = faces[merged];
+        const auto& current = faces[i];
+        if (last.vertical == current.vertical
+            && last.position == current.position && last.to == current.from)
+        {
+            last.to = current.to;
+        }
+        else
+        {
+            faces[++merged] = current;
+        }
+    }
+
+    if (!faces.empty()) faces.resize(merged + 1);
+}
+
+float dgm::Visibility::getHitDistance(
+    const sf::Vector2f& origin,
+    const sf::Vector2f& direction,
+    float maxDistance) const noexcept
+{
+    float best = maxDistance;
+
+    for (auto&& face : faces)
+    {
+        const float originAlong = face.vertical ? origin.x : origin.y;
+        const float originAcross = face.vertical ? origin.y : origin.x;
+        const float dirAlong = face.vertical ? direction.x : direction.y;
+        const float dirAcross = face.vertical ? direction.y : direction.x;
+
+        if (dirAlong == 0.f) continue;
+
+        const float t = (face.position - originAlong) / dirAlong;
+        if (t <= 0.f || t >= best) continue;
+
+        const float hit = originAcross + t * dirAcross;
+        if (hit >= face.from && hit <= face.to) best = t;
+    }
+
+    return best;
+}
@@ -0,0 +1,72 @@
+#include <DGM/classes/WorkerPool.hpp>
+#include <algorithm>
+
+dgm::WorkerPool::WorkerPool(unsigned threadCount)
+{
+    const auto workerCount = std::max(threadCount, 1u) - 1u;
+    workers.reserve(workerCount);
+    for (unsigned i = 0; i < workerCount; ++i)
+        workers.emplace_back([this](std::stop_token stopToken)
+                             { workerLoop(stopToken); });
+}
+
+void dgm::WorkerPool::forEachImpl(
+    std::size_t newTaskCount, TaskInvoker newInvoke, void* newTask) noexcept
+{
+    // Not worth waking anybody up
+    if (workers.empty() || newTaskCount <= 1)
+    {
+        for (std::size_t i = 0; i < newTaskCount; ++i)
+            newInvoke(newTask, i);
+        return;
+    }
+
+    auto&& jobLock = std::scoped_lock(jobMutex);
+    auto&& lock = std::unique_lock(stateMutex);
+
+    // Workers that woke up after the previous job finished have found no
+    // tasks left, but they must leave before the job is replaced
+    jobFinished.wait(lock, [&] { return activeWorkers == 0; });
+    taskCount = newTaskCount;
+    invoke = newInvoke;
+    task = newTask;
+    nextTask = 0;
+    ++jobId;
+    lock.unlock();
+    jobStarted.notify_all();
+
+    runTasks();
+
+    // Workers that joined the job might still be running their last task
+    lock.lock();
+    jobFinished.wait(lock, [&] { return activeWorkers == 0; });
+}
+
+void dgm::WorkerPool::workerLoop(std::stop_token stopToken) noexcept
+{
+    std::size_t lastJobId = 0;
+    while (true)
+    {
+        auto&& lock = std::unique_lock(stateMutex);
+        if (!jobStarted.wait(
+                lock, stopToken, [&] { return jobId != lastJobId; }))
+            return;
+
+        lastJobId = jobId;
+        ++activeWorkers;
+        lock.unlock();
+
+        runTasks();
+
+        lock.lock();
+        if (--activeWorkers == 0) jobFinished.notify_one();
+    }
+}
+
+void dgm::WorkerPool::runTasks() noexcept
+{
+    // Job cannot change while this thread is counted as active
+    // or while the calling thread is running it
+    for (std::size_t i = nextTask++; i < taskCount; i = nextTask++)
+        invoke(task, i);
+}
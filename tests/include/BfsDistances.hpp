@@ -0,0 +1,38 @@
+#pragma once
+
+#include <DGM/classes/Objects.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+/**
+ *  Reference 4-connected distances from plain breadth-first search,
+ *  indexed like the tiles of the mesh. Unreachable tiles have -1.
+ */
+[[nodiscard]] static inline std::vector<int>
+computeBfsDistances(const dgm::Mesh& mesh, const sf::Vector2u& from)
+{
+    const auto size = mesh.getDataSize();
+    auto distances = std::vector<int>(size.x * size.y, -1);
+    auto queue = std::vector<sf::Vector2u> { from };
+    distances[from.y * size.x + from.x] = 0;
+
+    for (std::size_t i = 0; i < queue.size(); ++i)
+    {
+        const auto point = queue[i];
+        const int distance = distances[point.y * size.x + point.x];
+        for (auto&& next :
+             { sf::Vector2u(point.x - 1, point.y),
+               sf::Vector2u(point.x + 1, point.y),
+               sf::Vector2u(point.x, point.y - 1),
+               sf::Vector2u(point.x, point.y + 1) })
+        {
+            if (next.x >= size.x || next.y >= size.y) continue;
+            auto& nextDistance = distances[next.y * size.x + next.x];
+            if (mesh[next] > 0 || nextDistance != -1) continue;
+            nextDistance = distance + 1;
+            queue.push_back(next);
+        }
+    }
+
+    return distances;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <DGM/classes/Objects.hpp>
+#include <random>
+#include <vector>
+
+enum class MeshBorder
+{
+    None,
+    Solid,
+};
+
+/**
+ *  Mesh with roughly one in `sparsity` tiles solid, the same for the same
+ *  seed. With MeshBorder::Solid, all tiles on the edge of the mesh are
+ *  solid as well.
+ */
+[[nodiscard]] static inline dgm::Mesh buildRandomMesh(
+    unsigned width,
+    unsigned height,
+    unsigned seed,
+    unsigned sparsity,
+    MeshBorder border = MeshBorder::Solid)
+{
+    auto rng = std::mt19937(seed);
+    auto map = std::vector<int>(width * height, 0);
+    for (unsigned y = 0; y < height; ++y)
+    {
+        for (unsigned x = 0; x < width; ++x)
+        {
+            const bool isEdge =
+                x == 0 || y == 0 || x == width - 1 || y == height - 1;
+            const bool isBorder = border == MeshBorder::Solid && isEdge;
+            map[y * width + x] = isBorder || rng() % sparsity == 0 ? 1 : 0;
+        }
+    }
+
+    return dgm::Mesh(map, { width, height }, { 32u, 32u });
+}
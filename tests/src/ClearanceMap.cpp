@@ -0,0 +1,154 @@
+#include <DGM/classes/ClearanceMap.hpp>
+#include <DGM/classes/NavMesh.hpp>
+#include <RandomMesh.hpp>
+#include <catch2/catch_all.hpp>
+#include <random>
+
+/**
+ *  Chessboard distance to the closest wall or to the outside of the mesh
+ */
+[[nodiscard]] static unsigned computeClearance(
+    const dgm::Mesh& mesh, const sf::Vector2u& tile, unsigned maxClearance)
+{
+    const auto size = mesh.getDataSize();
+    unsigned result = std::min(
+        { tile.x + 1, tile.y + 1, size.x - tile.x, size.y - tile.y });
+    for (unsigned y = 0; y < size.y; ++y)
+    {
+        for (unsigned x = 0; x < size.x; ++x)
+        {
+            if (mesh[sf::Vector2u(x, y)] <= 0) continue;
+            const unsigned dx = std::max(x, tile.x) - std::min(x, tile.x);
+            const unsigned dy = std::max(y, tile.y) - std::min(y, tile.y);
+            result = std::min(result, std::max(dx, dy));
+        }
+    }
+    return std::min(result, maxClearance);
+}
+
+static void requireSameClearance(
+    const dgm::ClearanceMap& clearance, const dgm::Mesh& mesh)
+{
+    const auto size = mesh.getDataSize();
+    for (unsigned y = 0; y < size.y; ++y)
+    {
+        for (unsigned x = 0; x < size.x; ++x)
+        {
+            INFO("Tile " << x << ", " << y);
+            REQUIRE(
+                clearance.getClearance({ x, y })
+                == computeClearance(
+                    mesh, { x, y }, clearance.getMaxClearance()));
+        }
+    }
+}
+
+TEST_CASE("Computing ClearanceMap", "[ClearanceMap]")
+{
+    SECTION("Values match brute force")
+    {
+        const auto mesh = buildRandomMesh(37u, 23u, 4u, 12u, MeshBorder::None);
+        for (unsigned maxClearance : { 1u, 3u, 255u })
+        {
+            INFO("Max clearance " << maxClearance);
+            requireSameClearance(dgm::ClearanceMap(mesh, maxClearance), mesh);
+        }
+    }
+
+    SECTION("Agent fits if clearance is greater than its radius")
+    {
+        // clang-format off
+        const auto mesh = dgm::Mesh({
+            0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0,
+            0, 0, 0, 0, 1,
+        }, { 5u, 4u }, { 1u, 1u });
+        // clang-format on
+        const auto clearance = dgm::ClearanceMap(mesh);
+
+        REQUIRE(clearance.getClearance({ 4u, 3u }) == 0u);
+        REQUIRE(clearance.getClearance({ 0u, 0u }) == 1u);
+        REQUIRE(clearance.getClearance({ 2u, 1u }) == 2u);
+        REQUIRE(clearance.getClearance(std::size_t(7)) == 2u);
+        REQUIRE(clearance.canFit({ 2u, 1u }, 1u));
+        REQUIRE_FALSE(clearance.canFit({ 2u, 1u }, 2u));
+        REQUIRE_FALSE(clearance.canFit({ 4u, 3u }, 0u));
+    }
+
+    SECTION("Updates match a rebuilt map")
+    {
+        auto mesh = buildRandomMesh(40u, 30u, 8u, 12u, MeshBorder::None);
+        auto clearance = dgm::ClearanceMap(mesh, 4u);
+        auto rng = std::mt19937(3u);
+
+        for (unsigned i = 0; i < 30; ++i)
+        {
+            INFO("Iteration " << i);
+            if (i % 2 == 0)
+            {
+                const auto tile = sf::Vector2u(rng() % 40, rng() % 30);
+                mesh[tile] = mesh[tile] > 0 ? 0 : 1;
+                clearance.updateTile(mesh, tile);
+            }
+            else
+            {
+                const auto region = sf::Rect<unsigned>(
+                    sf::Vector2u(rng() % 40, rng() % 30),
+                    sf::Vector2u(1 + rng() % 8, 1 + rng() % 8));
+                for (unsigned y = region.position.y;
+                     y < region.position.y + region.size.y && y < 30u;
+                     ++y)
+                {
+                    for (unsigned x = region.position.x;
+                         x < region.position.x + region.size.x && x < 40u;
+                         ++x)
+                        mesh[sf::Vector2u(x, y)] = rng() % 4 == 0 ? 1 : 0;
+                }
+                clearance.updateRegion(mesh, region);
+            }
+
+            requireSameClearance(clearance, mesh);
+        }
+    }
+}
+
+TEST_CASE("Tile path for large agents", "[ClearanceMap]")
+{
+    const auto mesh = buildRandomMesh(40u, 30u, 15u, 12u, MeshBorder::None);
+    const auto clearance = dgm::ClearanceMap(mesh);
+    auto&& context = dgm::PathSearchContext();
+    auto rng = std::mt19937(6u);
+
+    for (unsigned agentRadius : { 0u, 1u, 2u })
+    {
+        // Agent is a single tile on a mesh with walls grown by its radius
+        std::vector<int> grown(40u * 30u, 0);
+        for (unsigned i = 0; i < grown.size(); ++i)
+            grown[i] = clearance.getClearance(std::size_t(i)) > agentRadius
+                           ? 0
+                           : 1;
+        const auto grownMesh = dgm::Mesh(grown, { 40u, 30u }, { 32u, 32u });
+
+        for (unsigned i = 0; i < 100; ++i)
+        {
+            const auto from = sf::Vector2u(rng() % 40, rng() % 30);
+            const auto to = sf::Vector2u(rng() % 40, rng() % 30);
+
+            INFO(
+                "Radius " << agentRadius << " from " << from.x << ", "
+                          << from.y << " to " << to.x << ", " << to.y);
+            const auto expected =
+                dgm::TileNavMesh::computePath(from, to, grownMesh);
+            auto path = dgm::TileNavMesh::computePath(
+                from, to, mesh, clearance, agentRadius, context);
+            REQUIRE(path.has_value() == expected.has_value());
+            if (!path) continue;
+
+            REQUIRE(path->getLength() == expected->getLength());
+            for (; !path->isTraversed(); path->advance())
+                REQUIRE(clearance.canFit(
+                    path->getCurrentPoint().coord, agentRadius));
+        }
+    }
+}
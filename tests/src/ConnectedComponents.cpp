@@ -0,0 +1,107 @@
+#include <DGM/dgm.hpp>
+#include <RandomMesh.hpp>
+#include <catch2/catch_all.hpp>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    /**
+     *  Test that two labellings describe the same partition of tiles,
+     *  labels themselves can differ
+     */
+    [[nodiscard]] bool haveSamePartition(
+        const dgm::ConnectedComponents& a,
+        const dgm::ConnectedComponents& b,
+        const sf::Vector2u& size)
+    {
+        std::unordered_map<unsigned, unsigned> aToB, bToA;
+        for (unsigned y = 0; y < size.y; ++y)
+        {
+            for (unsigned x = 0; x < size.x; ++x)
+            {
+                const unsigned la = a.getComponent({ x, y });
+                const unsigned lb = b.getComponent({ x, y });
+                if (aToB.try_emplace(la, lb).first->second != lb) return false;
+                if (bToA.try_emplace(lb, la).first->second != la) return false;
+            }
+        }
+        return a.getComponentCount() == b.getComponentCount();
+    }
+} // namespace
+
+TEST_CASE("[ConnectedComponents]")
+{
+    // clang-format off
+    const std::vector<int> map = {
+        0, 0, 1, 0, 0,
+        0, 0, 1, 0, 0,
+        1, 1, 1, 1, 1,
+        0, 1, 0, 0, 0,
+    };
+    // clang-format on
+    auto mesh = dgm::Mesh(map, { 5u, 4u }, { 32u, 32u });
+    auto components = dgm::ConnectedComponents(mesh);
+
+    SECTION("Labels areas separated by walls")
+    {
+        REQUIRE(components.getComponentCount() == 4u);
+        REQUIRE(components.areConnected({ 0u, 0u }, { 1u, 1u }));
+        REQUIRE_FALSE(components.areConnected({ 0u, 0u }, { 3u, 0u }));
+        REQUIRE_FALSE(components.areConnected({ 0u, 3u }, { 2u, 3u }));
+        REQUIRE(
+            components.getComponent({ 2u, 0u })
+            == dgm::ConnectedComponents::NO_COMPONENT);
+        REQUIRE_FALSE(components.areConnected({ 2u, 0u }, { 2u, 0u }));
+        REQUIRE_FALSE(components.areConnected({ 0u, 0u }, { 10u, 0u }));
+    }
+
+    SECTION("Diagonal neighbors are not connected")
+    {
+        mesh[sf::Vector2u(1u, 2u)] = 0;
+        components.updateTile(mesh, { 1u, 2u });
+        REQUIRE(components.areConnected({ 0u, 0u }, { 1u, 2u }));
+        REQUIRE_FALSE(components.areConnected({ 1u, 2u }, { 0u, 3u }));
+        REQUIRE_FALSE(components.areConnected({ 1u, 2u }, { 2u, 3u }));
+    }
+
+    SECTION("Opening a tile merges components")
+    {
+        mesh[sf::Vector2u(2u, 1u)] = 0;
+        components.updateTile(mesh, { 2u, 1u });
+        REQUIRE(components.getComponentCount() == 3u);
+        REQUIRE(components.areConnected({ 0u, 0u }, { 4u, 1u }));
+    }
+
+    SECTION("Closing a tile splits components")
+    {
+        mesh[sf::Vector2u(3u, 3u)] = 1;
+        components.updateTile(mesh, { 3u, 3u });
+        REQUIRE(components.getComponentCount() == 5u);
+        REQUIRE_FALSE(components.areConnected({ 2u, 3u }, { 4u, 3u }));
+
+        mesh[sf::Vector2u(2u, 3u)] = 1;
+        components.updateTile(mesh, { 2u, 3u });
+        REQUIRE(components.getComponentCount() == 4u);
+    }
+}
+
+TEST_CASE("[ConnectedComponents] - incremental updates match a rebuild")
+{
+    const auto size = sf::Vector2u(24u, 18u);
+    auto mesh = buildRandomMesh(size.x, size.y, 2024u, 3u, MeshBorder::None);
+    auto rng = std::mt19937(2024u);
+    auto components = dgm::ConnectedComponents(mesh);
+
+    for (unsigned i = 0; i < 400; ++i)
+    {
+        const auto tile = sf::Vector2u(rng() % size.x, rng() % size.y);
+        mesh[tile] = mesh[tile] > 0 ? 0 : 1;
+        components.updateTile(mesh, tile);
+
+        INFO("Iteration " << i);
+        REQUIRE(haveSamePartition(
+            components, dgm::ConnectedComponents(mesh), size));
+    }
+}
@@ -0,0 +1,137 @@
+#include <DGM/dgm.hpp>
+#include <RandomMesh.hpp>
+#include <catch2/catch_all.hpp>
+#include <cmath>
+#include <vector>
+
+TEST_CASE("[FlowField]")
+{
+    // clang-format off
+    const std::vector<int> map = {
+        1, 1, 1, 1, 1, 1, 1, 1,
+        1, 0, 0, 0, 0, 0, 0, 1,
+        1, 0, 0, 1, 0, 0, 0, 1,
+        1, 0, 0, 1, 0, 1, 1, 1,
+        1, 0, 0, 1, 0, 1, 0, 1,
+        1, 1, 1, 1, 1, 1, 1, 1,
+    };
+    // clang-format on
+    const auto mesh = dgm::Mesh(map, { 8u, 6u }, { 32u, 32u });
+    auto field = dgm::FlowField();
+
+    SECTION("Goal has zero distance and no direction")
+    {
+        field.compute({ 1u, 4u }, mesh);
+        REQUIRE(field.getDistance({ 1u, 4u }) == 0.f);
+        REQUIRE(field.getDirection({ 1u, 4u }) == sf::Vector2i(0, 0));
+        REQUIRE(field.getNextTile({ 1u, 4u }) == sf::Vector2u(1u, 4u));
+    }
+
+    SECTION("Straight and diagonal steps")
+    {
+        field.compute({ 1u, 4u }, mesh);
+        REQUIRE(field.getDistance({ 1u, 3u }) == 1.f);
+        REQUIRE(field.getDirection({ 1u, 3u }) == sf::Vector2i(0, 1));
+        REQUIRE(field.getDistance({ 2u, 3u }) == Catch::Approx(std::sqrt(2.f)));
+        REQUIRE(field.getDirection({ 2u, 3u }) == sf::Vector2i(-1, 1));
+    }
+
+    SECTION("Does not cut corners")
+    {
+        field.compute({ 2u, 1u }, mesh);
+
+        // Diagonal step from (4, 2) to (3, 1) would scrape the wall at (3, 2)
+        REQUIRE(field.getDirection({ 4u, 2u }) == sf::Vector2i(0, -1));
+        REQUIRE(field.getDistance({ 4u, 2u }) == 3.f);
+    }
+
+    SECTION("Unreachable tiles")
+    {
+        field.compute({ 1u, 1u }, mesh);
+        REQUIRE_FALSE(field.isReachable({ 6u, 4u }));
+        REQUIRE_FALSE(field.isReachable({ 0u, 0u }));
+        REQUIRE_FALSE(field.isReachable({ 20u, 20u }));
+        REQUIRE(
+            field.getDistance({ 6u, 4u })
+            == dgm::FlowField::UNREACHABLE_DISTANCE);
+        REQUIRE(field.getDirection({ 6u, 4u }) == sf::Vector2i(0, 0));
+    }
+
+    SECTION("Invalid goals are ignored")
+    {
+        const auto goals = std::vector<sf::Vector2u> {
+            { 0u, 0u }, { 30u, 1u }, { 1u, 1u }
+        };
+        field.compute(goals, mesh);
+        REQUIRE(field.getDistance({ 1u, 1u }) == 0.f);
+        REQUIRE(field.getDistance({ 2u, 1u }) == 1.f);
+    }
+
+    SECTION("Multiple goals lead to the nearest one")
+    {
+        const auto goals = std::vector<sf::Vector2u> { { 1u, 4u }, { 6u, 1u } };
+        field.compute(goals, mesh);
+        REQUIRE(field.getDistance({ 6u, 1u }) == 0.f);
+        REQUIRE(field.getDistance({ 5u, 1u }) == 1.f);
+        REQUIRE(field.getDistance({ 1u, 3u }) == 1.f);
+        REQUIRE(field.getDirection({ 5u, 1u }) == sf::Vector2i(1, 0));
+    }
+
+    SECTION("Flow vector points to the center of the next tile")
+    {
+        field.compute({ 1u, 4u }, mesh);
+        const auto flow = field.getFlowVector({ 48.f, 100.f });
+        REQUIRE(flow.x == Catch::Approx(0.f).margin(1e-5f));
+        REQUIRE(flow.y == Catch::Approx(1.f));
+
+        REQUIRE(field.getFlowVector({ 48.f, 144.f }) == sf::Vector2f(0.f, 0.f));
+        REQUIRE(field.getFlowVector({ -5.f, 144.f }) == sf::Vector2f(0.f, 0.f));
+    }
+}
+
+TEST_CASE("[FlowField] - following directions reaches the goal")
+{
+    auto field = dgm::FlowField();
+
+    for (unsigned seed = 0; seed < 4; ++seed)
+    {
+        const auto mesh = buildRandomMesh(40u, 30u, seed, 3u + seed);
+        const auto goals =
+            std::vector<sf::Vector2u> { { 5u, 5u }, { 30u, 20u } };
+        field.compute(goals, mesh);
+
+        for (unsigned y = 0; y < 30u; ++y)
+        {
+            for (unsigned x = 0; x < 40u; ++x)
+            {
+                auto tile = sf::Vector2u(x, y);
+                if (!field.isReachable(tile)) continue;
+
+                INFO("Seed " << seed << ", tile " << x << ", " << y);
+
+                // Each step decreases the distance by the cost of the step
+                // and the walk ends in a goal
+                unsigned steps = 0;
+                while (field.getDistance(tile) > 0.f)
+                {
+                    const auto next = field.getNextTile(tile);
+                    REQUIRE(mesh[next] <= 0);
+
+                    const auto dir = field.getDirection(tile);
+                    const float cost =
+                        dir.x != 0 && dir.y != 0 ? std::sqrt(2.f) : 1.f;
+                    REQUIRE(
+                        field.getDistance(next) + cost
+                        == Catch::Approx(field.getDistance(tile)));
+
+                    tile = next;
+                    REQUIRE(++steps < 40u * 30u);
+                }
+
+                REQUIRE(
+                    (tile == sf::Vector2u(5u, 5u)
+                     || tile == sf::Vector2u(30u, 20u)));
+            }
+        }
+    }
+}
@@ -0,0 +1,134 @@
+#include <DGM/dgm.hpp>
+#include <RandomMesh.hpp>
+#include <catch2/catch_all.hpp>
+#include <random>
+#include <vector>
+
+namespace
+{
+    [[nodiscard]] std::vector<sf::Vector2u>
+    toTiles(std::optional<dgm::Path<dgm::TileNavpoint>>&& path)
+    {
+        std::vector<sf::Vector2u> tiles;
+        for (; !path->isTraversed(); path->advance())
+            tiles.push_back(path->getCurrentPoint().coord);
+        return tiles;
+    }
+} // namespace
+
+TEST_CASE("[HierarchicalNavMesh]")
+{
+    // clang-format off
+    const std::vector<int> map = {
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        1, 0, 0, 0, 1, 0, 0, 0, 0, 1,
+        1, 0, 1, 0, 1, 0, 1, 1, 0, 1,
+        1, 0, 1, 0, 0, 0, 1, 0, 0, 1,
+        1, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+        1, 0, 0, 0, 0, 0, 1, 0, 0, 1,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    };
+    // clang-format on
+    const auto navmesh = dgm::HierarchicalNavMesh(
+        dgm::Mesh(map, { 10u, 7u }, { 32u, 32u }), 4u);
+
+    SECTION("Builds entrances on open cluster borders")
+    {
+        REQUIRE(navmesh.getClusterSize() == 4u);
+        REQUIRE(navmesh.getEntranceCount() > 0u);
+    }
+
+    SECTION("Edge cases behave like TileNavMesh")
+    {
+        REQUIRE(navmesh.computeTilePath({ 1u, 1u }, { 1u, 1u })->isTraversed());
+        REQUIRE_FALSE(navmesh.computeTilePath({ 0u, 0u }, { 1u, 1u }));
+        REQUIRE_FALSE(navmesh.computeTilePath({ 1u, 1u }, { 2u, 2u }));
+        REQUIRE_FALSE(navmesh.computeTilePath({ 1u, 1u }, { 7u, 5u }));
+        REQUIRE_FALSE(navmesh.computeTilePath({ 1u, 1u }, { 40u, 1u }));
+    }
+
+    SECTION("Path crossing several clusters")
+    {
+        const auto tiles =
+            toTiles(navmesh.computeTilePath({ 1u, 5u }, { 8u, 1u }));
+        REQUIRE(tiles.size() == 15u);
+        REQUIRE(tiles.back() == sf::Vector2u(8u, 1u));
+    }
+
+    SECTION("World path only contains turns")
+    {
+        auto path = navmesh.computePath(
+            sf::Vector2f(1.5f, 5.5f) * 32.f, sf::Vector2f(3.5f, 1.5f) * 32.f);
+
+        const std::vector<sf::Vector2f> expected = {
+            sf::Vector2f(1.5f, 1.5f) * 32.f,
+            sf::Vector2f(3.5f, 1.5f) * 32.f,
+        };
+        for (auto&& point : expected)
+        {
+            REQUIRE_FALSE(path.isTraversed());
+            REQUIRE(path.getCurrentPoint().coord == point);
+            path.advance();
+        }
+        REQUIRE(path.isTraversed());
+    }
+
+    SECTION("No world path into a wall")
+    {
+        REQUIRE(navmesh
+                    .computePath(
+                        sf::Vector2f(1.5f, 1.5f) * 32.f,
+                        sf::Vector2f(2.5f, 2.5f) * 32.f)
+                    .isTraversed());
+    }
+}
+
+TEST_CASE("[HierarchicalNavMesh] - agrees with TileNavMesh")
+{
+    auto rng = std::mt19937(1234u);
+    auto context = dgm::PathSearchContext();
+    std::size_t hierarchicalLength = 0, optimalLength = 0;
+
+    for (unsigned seed = 0; seed < 4; ++seed)
+    {
+        const auto navmesh = dgm::HierarchicalNavMesh(
+            buildRandomMesh(70u, 50u, seed, 3u + seed), 4u + seed * 3u);
+        const auto& mesh = navmesh.getMesh();
+
+        for (unsigned i = 0; i < 150; ++i)
+        {
+            const auto from = sf::Vector2u(rng() % 70u, rng() % 50u);
+            const auto to = sf::Vector2u(rng() % 70u, rng() % 50u);
+            INFO(
+                "Seed " << seed << ", from " << from.x << ", " << from.y
+                        << " to " << to.x << ", " << to.y);
+
+            auto expected =
+                dgm::TileNavMesh::computePath(from, to, mesh, context);
+            auto result = navmesh.computeTilePath(from, to, context);
+            REQUIRE(expected.has_value() == result.has_value());
+            if (!result) continue;
+
+            const auto tiles = toTiles(std::move(result));
+            REQUIRE(tiles.size() >= expected->getLength());
+            hierarchicalLength += tiles.size();
+            optimalLength += expected->getLength();
+
+            auto previous = from;
+            for (auto&& tile : tiles)
+            {
+                const unsigned dx = std::max(tile.x, previous.x)
+                                    - std::min(tile.x, previous.x);
+                const unsigned dy = std::max(tile.y, previous.y)
+                                    - std::min(tile.y, previous.y);
+                REQUIRE(dx + dy == 1u);
+                REQUIRE(mesh[tile] <= 0);
+                previous = tile;
+            }
+            REQUIRE(previous == to);
+        }
+    }
+
+    // Paths are near-optimal, not optimal
+    REQUIRE(hierarchicalLength < optimalLength * 1.1);
+}
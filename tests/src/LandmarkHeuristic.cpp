@@ -0,0 +1,172 @@
+#include <BfsDistances.hpp>
+#include <DGM/classes/LandmarkHeuristic.hpp>
+#include <DGM/classes/NavMesh.hpp>
+#include <RandomMesh.hpp>
+#include <catch2/catch_all.hpp>
+#include <random>
+
+#define NUMBER_DISTANCE(a, b) (std::max(a, b) - std::min(a, b))
+
+/**
+ *  Corridors with gaps at alternating ends, so every path between rows
+ *  is a long detour
+ */
+[[nodiscard]] static dgm::Mesh
+buildSerpentineMesh(unsigned width, unsigned height)
+{
+    std::vector<int> map(width * height, 0);
+    for (unsigned y = 1; y < height; y += 2)
+    {
+        for (unsigned x = 0; x < width; ++x)
+            map[y * width + x] = 1;
+        map[y * width + ((y / 2) % 2 == 0 ? width - 1 : 0)] = 0;
+    }
+    return dgm::Mesh(map, { width, height }, { 32u, 32u });
+}
+
+TEST_CASE("Constructing LandmarkHeuristic", "[LandmarkHeuristic]")
+{
+    SECTION("Landmarks are distinct passable tiles")
+    {
+        const auto mesh = buildRandomMesh(30u, 20u, 3u, 3u, MeshBorder::None);
+        const auto heuristic = dgm::LandmarkHeuristic(mesh, 6u);
+
+        auto&& landmarks = heuristic.getLandmarks();
+        REQUIRE(landmarks.size() == 6u);
+        for (auto&& landmark : landmarks)
+        {
+            REQUIRE(mesh[landmark] <= 0);
+            REQUIRE(std::ranges::count(landmarks, landmark) == 1);
+        }
+    }
+
+    SECTION("Fewer landmarks are picked if there are not enough tiles")
+    {
+        const auto mesh = dgm::Mesh({ 0, 0, 1, 1 }, { 2u, 2u }, { 1u, 1u });
+        const auto heuristic = dgm::LandmarkHeuristic(mesh, 8u);
+        REQUIRE(heuristic.getLandmarks().size() == 2u);
+    }
+
+    SECTION("Mesh without passable tiles has no landmarks")
+    {
+        const auto mesh = dgm::Mesh({ 1, 1, 1, 1 }, { 2u, 2u }, { 1u, 1u });
+        const auto heuristic = dgm::LandmarkHeuristic(mesh);
+        REQUIRE(heuristic.getLandmarks().empty());
+        REQUIRE(heuristic.getLowerBound({ 0u, 0u }, { 1u, 1u }) == 2u);
+    }
+
+    SECTION("Landmarks lie in the largest area")
+    {
+        // clang-format off
+        const auto mesh = dgm::Mesh({
+            0, 1, 0, 0, 0,
+            1, 1, 0, 0, 0,
+        }, { 5u, 2u }, { 1u, 1u });
+        // clang-format on
+        const auto heuristic = dgm::LandmarkHeuristic(mesh, 3u);
+
+        auto&& landmarks = heuristic.getLandmarks();
+        REQUIRE(landmarks.size() == 3u);
+        for (auto&& landmark : landmarks)
+            REQUIRE(landmark.x >= 2u);
+        REQUIRE(heuristic.getLowerBound({ 0u, 0u }, { 2u, 0u }) == 2u);
+    }
+}
+
+TEST_CASE("Landmark bound is admissible", "[LandmarkHeuristic]")
+{
+    for (auto&& mesh : { buildRandomMesh(40u, 30u, 21u, 3u, MeshBorder::None),
+                         buildSerpentineMesh(25u, 21u) })
+    {
+        const auto heuristic = dgm::LandmarkHeuristic(mesh, 4u);
+        const auto size = mesh.getDataSize();
+
+        for (auto&& from : { sf::Vector2u(0u, 0u),
+                             sf::Vector2u(size.x / 2, size.y / 2),
+                             sf::Vector2u(size.x - 1, size.y - 1) })
+        {
+            if (mesh[from] > 0) continue;
+            const auto distances = computeBfsDistances(mesh, from);
+
+            for (unsigned y = 0; y < size.y; ++y)
+            {
+                for (unsigned x = 0; x < size.x; ++x)
+                {
+                    const int distance = distances[y * size.x + x];
+                    if (distance == -1) continue;
+
+                    INFO("From " << from.x << ", " << from.y << " to " << x
+                                 << ", " << y);
+                    const unsigned bound =
+                        heuristic.getLowerBound(from, { x, y });
+                    REQUIRE(bound <= static_cast<unsigned>(distance));
+                    REQUIRE(
+                        bound >= NUMBER_DISTANCE(from.x, x)
+                                     + NUMBER_DISTANCE(from.y, y));
+                }
+            }
+        }
+    }
+
+    SECTION("Bound is exact along a serpentine")
+    {
+        const auto mesh = buildSerpentineMesh(25u, 21u);
+        const auto heuristic = dgm::LandmarkHeuristic(mesh, 2u);
+        const auto distances = computeBfsDistances(mesh, { 0u, 0u });
+        REQUIRE(
+            heuristic.getLowerBound({ 0u, 0u }, { 0u, 20u })
+            == static_cast<unsigned>(distances[20u * 25u]));
+    }
+}
+
+TEST_CASE("Tile path with landmarks", "[LandmarkHeuristic]")
+{
+    for (auto&& mesh : { buildRandomMesh(40u, 30u, 5u, 3u, MeshBorder::None),
+                         buildSerpentineMesh(25u, 21u) })
+    {
+        const auto heuristic = dgm::LandmarkHeuristic(mesh);
+        const auto size = mesh.getDataSize();
+        auto&& context = dgm::PathSearchContext();
+        auto rng = std::mt19937(9u);
+
+        for (unsigned i = 0; i < 200; ++i)
+        {
+            const auto from = sf::Vector2u(rng() % size.x, rng() % size.y);
+            const auto to = sf::Vector2u(rng() % size.x, rng() % size.y);
+
+            INFO("From " << from.x << ", " << from.y << " to " << to.x << ", "
+                         << to.y);
+            const auto expected =
+                dgm::TileNavMesh::computePath(from, to, mesh);
+            const auto path = dgm::TileNavMesh::computePath(
+                from, to, mesh, heuristic, context);
+            REQUIRE(path.has_value() == expected.has_value());
+            if (path) REQUIRE(path->getLength() == expected->getLength());
+        }
+    }
+
+#ifdef PATHFINDING_STATS
+    SECTION("Landmarks reduce explored tiles behind a wall")
+    {
+        // Wall across the map with a gap on the left, manhattan distance
+        // leads the search into the whole area above the wall
+        const unsigned width = 41u;
+        std::vector<int> map(width * width, 0);
+        for (unsigned x = 2; x < width; ++x)
+            map[20u * width + x] = 1;
+        const auto mesh = dgm::Mesh(map, { width, width }, { 32u, 32u });
+        const auto heuristic = dgm::LandmarkHeuristic(mesh);
+        auto&& context = dgm::PathSearchContext();
+
+        std::ignore = dgm::TileNavMesh::computePath(
+            { 30u, 10u }, { 30u, 30u }, mesh, context);
+        const auto withoutLandmarks = context.getLastStats().expandedNodeCount;
+
+        std::ignore = dgm::TileNavMesh::computePath(
+            { 30u, 10u }, { 30u, 30u }, mesh, heuristic, context);
+        const auto withLandmarks = context.getLastStats().expandedNodeCount;
+
+        REQUIRE(withLandmarks * 2 < withoutLandmarks);
+    }
+#endif
+}
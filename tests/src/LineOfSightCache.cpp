@@ -0,0 +1,146 @@
+#include <DGM/dgm.hpp>
+#include <catch2/catch_all.hpp>
+#include <vector>
+
+namespace
+{
+    // 20x10 grid with border walls and a wall segment at x=10, y=2..6
+    [[nodiscard]] dgm::Mesh buildTestMesh()
+    {
+        auto mesh = dgm::Mesh({ 20u, 10u }, { 16u, 16u });
+        for (unsigned x = 0; x < 20; ++x)
+        {
+            mesh[sf::Vector2u(x, 0u)] = 1;
+            mesh[sf::Vector2u(x, 9u)] = 1;
+        }
+
+        for (unsigned y = 0; y < 10; ++y)
+        {
+            mesh[sf::Vector2u(0u, y)] = 1;
+            mesh[sf::Vector2u(19u, y)] = 1;
+        }
+
+        for (unsigned y = 2; y < 7; ++y)
+            mesh[sf::Vector2u(10u, y)] = 1;
+
+        return mesh;
+    }
+
+    [[nodiscard]] sf::Vector2f tileCenter(const sf::Vector2u& tile)
+    {
+        return { (tile.x + 0.5f) * 16.f, (tile.y + 0.5f) * 16.f };
+    }
+} // namespace
+
+TEST_CASE("[LineOfSightCache]")
+{
+    auto reference = buildTestMesh();
+    auto cache = dgm::LineOfSightCache(buildTestMesh(), 4u);
+
+    SECTION("Results match Raycaster")
+    {
+        const auto from = sf::Vector2u(3u, 4u);
+        for (unsigned y = 1; y < 9; ++y)
+        {
+            for (unsigned x = 1; x < 19; ++x)
+            {
+                const auto to = sf::Vector2u(x, y);
+                INFO("Tile " << x << ", " << y);
+                REQUIRE(
+                    cache.hasDirectVisibility(from, to)
+                    == dgm::Raycaster::hasDirectVisibility(
+                        tileCenter(from), tileCenter(to), reference));
+            }
+        }
+    }
+
+    SECTION("Repeated queries are served from cache")
+    {
+        std::ignore = cache.hasDirectVisibility({ 2u, 2u }, { 15u, 7u });
+        std::ignore = cache.hasDirectVisibility({ 2u, 2u }, { 15u, 7u });
+        REQUIRE(cache.getCachedPairCount() == 1u);
+
+        std::ignore = cache.hasDirectVisibility({ 15u, 7u }, { 2u, 2u });
+        REQUIRE(cache.getCachedPairCount() == 2u);
+    }
+
+    SECTION("Opening a wall invalidates dependent results")
+    {
+        REQUIRE_FALSE(cache.hasDirectVisibility({ 5u, 4u }, { 15u, 4u }));
+
+        cache.setTile({ 10u, 4u }, 0);
+        REQUIRE(cache.getCachedPairCount() == 0u);
+        REQUIRE(cache.hasDirectVisibility({ 5u, 4u }, { 15u, 4u }));
+    }
+
+    SECTION("Building a wall invalidates dependent results")
+    {
+        REQUIRE(cache.hasDirectVisibility({ 2u, 8u }, { 17u, 8u }));
+
+        cache.setTile({ 12u, 8u }, 1);
+        REQUIRE_FALSE(cache.hasDirectVisibility({ 2u, 8u }, { 17u, 8u }));
+    }
+
+    SECTION("Changes in unrelated regions keep cached results")
+    {
+        REQUIRE(cache.hasDirectVisibility({ 1u, 1u }, { 3u, 1u }));
+        REQUIRE(cache.getCachedPairCount() == 1u);
+
+        cache.setTile({ 16u, 7u }, 1);
+        REQUIRE(cache.getCachedPairCount() == 1u);
+        REQUIRE(cache.getMesh()[sf::Vector2u(16u, 7u)] == 1);
+    }
+
+    SECTION("Changing value without changing solidity keeps cached results")
+    {
+        REQUIRE(cache.hasDirectVisibility({ 1u, 1u }, { 3u, 1u }));
+
+        cache.setTile({ 2u, 1u }, -5);
+        REQUIRE(cache.getCachedPairCount() == 1u);
+    }
+
+    SECTION("Discarded results are unregistered from all regions")
+    {
+        // Rays cross several regions, but only one of them changes
+        auto&& queryAll = [&]
+        {
+            for (unsigned y = 1; y < 9; ++y)
+            {
+                std::ignore = cache.hasDirectVisibility({ 1u, y }, { 18u, y });
+                std::ignore = cache.hasDirectVisibility({ 18u, y }, { 1u, y });
+            }
+        };
+
+        queryAll();
+        const auto pairCount = cache.getCachedPairCount();
+        const auto dependencyCount = cache.getDependencyCount();
+        REQUIRE(dependencyCount > pairCount);
+
+        // Rays through the opened wall cross more regions
+        cache.setTile({ 10u, 4u }, 0);
+        queryAll();
+        const auto openedDependencyCount = cache.getDependencyCount();
+        REQUIRE(openedDependencyCount > dependencyCount);
+
+        for (unsigned i = 0; i < 100; ++i)
+        {
+            const bool isOpen = i % 2 == 1;
+            cache.setTile({ 10u, 4u }, isOpen ? 0 : 1);
+            REQUIRE(cache.getCachedPairCount() < pairCount);
+
+            queryAll();
+            REQUIRE(cache.getCachedPairCount() == pairCount);
+            REQUIRE(
+                cache.getDependencyCount()
+                == (isOpen ? openedDependencyCount : dependencyCount));
+        }
+    }
+
+    SECTION("Clear drops everything")
+    {
+        std::ignore = cache.hasDirectVisibility({ 1u, 1u }, { 3u, 1u });
+        cache.clear();
+        REQUIRE(cache.getCachedPairCount() == 0u);
+        REQUIRE(cache.getDependencyCount() == 0u);
+    }
+}
@@ -0,0 +1,131 @@
+#include "TestDataDir.hpp"
+#include <DGM/classes/MovingAiLoader.hpp>
+#include <DGM/classes/NavMesh.hpp>
+#include <catch2/catch_all.hpp>
+#include <sstream>
+
+TEST_CASE("Loading MovingAI map", "[MovingAiLoader]")
+{
+    SECTION("load from disc")
+    {
+        auto result = dgm::MovingAiLoader::loadMap(
+            TEST_DATA_DIR + "/movingai/tiny.map", { 32u, 32u });
+        REQUIRE(result.has_value());
+
+        const auto& mesh = result.value();
+        REQUIRE(mesh.getDataSize() == sf::Vector2u(7u, 5u));
+        REQUIRE(mesh.getVoxelSize() == sf::Vector2u(32u, 32u));
+        REQUIRE(mesh[sf::Vector2u(0u, 0u)] == 1);
+        REQUIRE(mesh[sf::Vector2u(1u, 1u)] == 0);
+        REQUIRE(mesh[sf::Vector2u(3u, 1u)] == 1); // Tree
+        REQUIRE(mesh[sf::Vector2u(1u, 3u)] == 0); // Ground
+        REQUIRE(mesh[sf::Vector2u(5u, 3u)] == 0); // Swamp
+    }
+
+    SECTION("Windows line endings are accepted")
+    {
+        auto stream = std::stringstream(
+            "type octile\r\nheight 1\r\nwidth 2\r\nmap\r\n.W\r\n");
+        auto result = dgm::MovingAiLoader::loadMap(stream, { 1u, 1u });
+        REQUIRE(result.has_value());
+        REQUIRE(result->getDataSize() == sf::Vector2u(2u, 1u));
+        REQUIRE(result.value()[sf::Vector2u(1u, 0u)] == 1);
+    }
+
+    SECTION("Malformed maps are rejected")
+    {
+        const auto invalidMaps = std::vector<std::string> {
+            "",
+            "type octile\nheight 2\nwidth 2\n..\n..\n",
+            "type octile\nheight 2\nwidth 2\nmap\n..\n",
+            "type octile\nheight 2\nwidth 2\nmap\n..\n...\n",
+            "type octile\nheight x\nwidth 2\nmap\n..\n..\n",
+            "type octile\nwidth 2\nmap\n..\n..\n",
+        };
+
+        for (auto&& map : invalidMaps)
+        {
+            INFO(map);
+            auto stream = std::stringstream(map);
+            REQUIRE_FALSE(
+                dgm::MovingAiLoader::loadMap(stream, { 1u, 1u }).has_value());
+        }
+    }
+
+    SECTION("Missing file is reported")
+    {
+        REQUIRE_FALSE(dgm::MovingAiLoader::loadMap(
+                          TEST_DATA_DIR + "/movingai/missing.map", { 1u, 1u })
+                          .has_value());
+    }
+}
+
+TEST_CASE("Loading MovingAI scenarios", "[MovingAiLoader]")
+{
+    SECTION("load from disc")
+    {
+        auto result = dgm::MovingAiLoader::loadScenarios(
+            TEST_DATA_DIR + "/movingai/tiny.map.scen");
+        REQUIRE(result.has_value());
+        REQUIRE(result->size() == 3u);
+
+        const auto& scenario = result->at(2);
+        REQUIRE(scenario.bucket == 1u);
+        REQUIRE(scenario.mapPath == "tiny.map");
+        REQUIRE(scenario.mapSize == sf::Vector2u(7u, 5u));
+        REQUIRE(scenario.from == sf::Vector2u(2u, 1u));
+        REQUIRE(scenario.to == sf::Vector2u(1u, 3u));
+        REQUIRE(scenario.optimalLength == 3.0);
+    }
+
+    SECTION("Map paths can contain spaces")
+    {
+        auto stream = std::stringstream(
+            "version 1.0\n"
+            "3\tmaps/my map.map\t4\t4\t0\t1\t2\t3\t2.82842712\n");
+        auto result = dgm::MovingAiLoader::loadScenarios(stream);
+        REQUIRE(result.has_value());
+        REQUIRE(result->front().mapPath == "maps/my map.map");
+        REQUIRE(
+            result->front().optimalLength == Catch::Approx(2.82842712));
+    }
+
+    SECTION("Malformed scenarios are rejected")
+    {
+        const auto invalidScenarios = std::vector<std::string> {
+            "",
+            "version 2\n",
+            "0\ttiny.map\t7\t5\t1\t1\t5\t1\t8\n",
+            "version 1\n0\ttiny.map\t7\t5\t1\t1\t5\t1\n",
+            "version 1\n0\ttiny.map\t7\t5\t1\t1\t5\t1\t8\t9\n",
+            "version 1\n0\ttiny.map\t7\t5\t7\t1\t5\t1\t8\n",
+        };
+
+        for (auto&& scenarios : invalidScenarios)
+        {
+            INFO(scenarios);
+            auto stream = std::stringstream(scenarios);
+            REQUIRE_FALSE(
+                dgm::MovingAiLoader::loadScenarios(stream).has_value());
+        }
+    }
+}
+
+TEST_CASE("Solving MovingAI scenarios", "[MovingAiLoader]")
+{
+    const auto mesh = dgm::MovingAiLoader::loadMap(
+        TEST_DATA_DIR + "/movingai/tiny.map", { 32u, 32u });
+    const auto scenarios = dgm::MovingAiLoader::loadScenarios(
+        TEST_DATA_DIR + "/movingai/tiny.map.scen");
+    REQUIRE(mesh.has_value());
+    REQUIRE(scenarios.has_value());
+
+    // No scenario of the map benefits from diagonal steps
+    for (auto&& scenario : scenarios.value())
+    {
+        const auto path = dgm::TileNavMesh::computePath(
+            scenario.from, scenario.to, mesh.value());
+        REQUIRE(path.has_value());
+        REQUIRE(path->getLength() == scenario.optimalLength);
+    }
+}
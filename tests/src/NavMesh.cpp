@@ -1,10 +1,17 @@
 #include "TestDataDir.hpp"
+#include <BfsDistances.hpp>
 #include <DGM/classes/Error.hpp>
 #include <DGM/classes/NavMesh.hpp>
 #include <DGM/classes/Utility.hpp>
+#include <RandomMesh.hpp>
 #include <algorithm>
+#include <array>
 #include <catch2/catch_all.hpp>
+#include <cmath>
 #include <iostream>
+#include <random>
+#include <thread>
+#include <tuple>
 
 #define NUMBER_DISTANCE(a, b) (std::max(a, b) - std::min(a, b))
 
@@ -31,36 +38,86 @@
 class TestableNavMesh : public dgm::WorldNavMesh
 {
 public:
-    [[nodiscard]] decltype(auto) getJumpPoints() const
+    struct TileConnection
     {
-        std::vector<sf::Vector2u> result;
-
-        std::transform(
-            jumpPointConnections.begin(),
-            jumpPointConnections.end(),
-            std::back_inserter(result),
-            [](const auto& itr) -> sf::Vector2u { return itr.first; });
+        sf::Vector2u destination;
+        unsigned distance;
+        unsigned clearance;
+    };
 
-        return result;
+public:
+    [[nodiscard]] decltype(auto) getJumpPoints() const
+    {
+        return jumpPoints;
     }
 
-    [[nodiscard]] auto&& getConnections() const noexcept
+    [[nodiscard]] auto getConnections() const
     {
-        return jumpPointConnections;
+        std::unordered_map<sf::Vector2u, std::vector<TileConnection>> result;
+        for (unsigned id = 0; id < jumpPoints.size(); ++id)
+        {
+            auto& list = result[jumpPoints[id]];
+            for (auto&& connection : WorldNavMesh::getConnections(id))
+            {
+                list.push_back(TileConnection {
+                    .destination = jumpPoints[connection.destination],
+                    .distance = connection.distance,
+                    .clearance = connection.clearance });
+            }
+        }
+        return result;
     }
 
     [[nodiscard]] bool
     arePointsConnected(const sf::Vector2u& a, const sf::Vector2u& b) const
     {
-        auto& connections = jumpPointConnections.at(a);
-        for (auto&& p : connections)
+        const unsigned id = getJumpPointId(a);
+        for (auto&& connection : WorldNavMesh::getConnections(id))
         {
-            if (b == p.destination) return true;
+            if (b == jumpPoints[connection.destination]) return true;
         }
         return false;
     }
 
-    TestableNavMesh(dgm::Mesh mesh) : dgm::WorldNavMesh(std::move(mesh)) {}
+    /**
+     *  Compare everything the constructor computes, including the order
+     *  of jump points and connections
+     */
+    [[nodiscard]] bool hasSameGraph(const TestableNavMesh& other) const
+    {
+        auto&& sameBounds = [](const TileBounds& a, const TileBounds& b)
+        { return a.min == b.min && a.max == b.max; };
+        auto&& sameConnection = [](const Connection& a, const Connection& b)
+        {
+            return a.destination == b.destination && a.distance == b.distance
+                   && a.clearance == b.clearance;
+        };
+
+        return jumpPoints == other.jumpPoints
+               && jumpPointIds == other.jumpPointIds
+               && connectionOffsets == other.connectionOffsets
+               && std::ranges::equal(
+                   connections, other.connections, sameConnection)
+               && std::ranges::equal(
+                   jumpPointScanBounds, other.jumpPointScanBounds, sameBounds);
+    }
+
+    explicit TestableNavMesh(dgm::WorldNavMesh&& navmesh)
+        : dgm::WorldNavMesh(std::move(navmesh))
+    {
+    }
+
+    TestableNavMesh(
+        dgm::Mesh mesh,
+        unsigned threadCount = std::thread::hardware_concurrency())
+        : dgm::WorldNavMesh(std::move(mesh), threadCount)
+    {
+    }
+
+    TestableNavMesh(dgm::Mesh mesh, const BuildSettings& settings)
+        : dgm::WorldNavMesh(std::move(mesh), settings)
+    {
+    }
 };
 
 TEST_CASE("Constructing WorldNavMesh", "[WorldNavMesh]")
@@ -149,8 +206,8 @@ TEST_CASE("Constructing WorldNavMesh", "[WorldNavMesh]")
             REQUIRE(path.isTraversed());
 
             // Verify that the temporary points were cleaned up
-            auto&& connections =
-                navmesh.getConnections().at(sf::Vector2u(3u, 2u));
+            const auto graph = navmesh.getConnections();
+            auto&& connections = graph.at(sf::Vector2u(3u, 2u));
             REQUIRE(
                 std::find_if(
                     connections.begin(),
@@ -161,10 +218,8 @@ TEST_CASE("Constructing WorldNavMesh", "[WorldNavMesh]")
                                && conn.destination.y == 1u;
                     })
                 == connections.end());
-            REQUIRE_FALSE(
-                navmesh.getConnections().contains(sf::Vector2u(1u, 1u)));
-            REQUIRE_FALSE(
-                navmesh.getConnections().contains(sf::Vector2u(2u, 1u)));
+            REQUIRE_FALSE(graph.contains(sf::Vector2u(1u, 1u)));
+            REQUIRE_FALSE(graph.contains(sf::Vector2u(2u, 1u)));
         }
 
         SECTION("Normal path")
@@ -405,6 +460,780 @@ TEST_CASE("Computing Tile path", "[TileNavMesh]")
         REQUIRE_FALSE(
             dgm::TileNavMesh::computePath({ 1u, 1u }, { 6u, 1u }, mesh));
     }
+
+    SECTION("Using connected components")
+    {
+        const auto components = dgm::ConnectedComponents(mesh);
+        auto&& context = dgm::PathSearchContext();
+
+        REQUIRE_FALSE(dgm::TileNavMesh::computePath(
+            { 1u, 1u }, { 8u, 1u }, mesh, components, context));
+        REQUIRE(dgm::TileNavMesh::computePath(
+                    { 1u, 1u }, { 1u, 1u }, mesh, components, context)
+                    ->isTraversed());
+
+        auto path = dgm::TileNavMesh::computePath(
+            { 1u, 1u }, { 5u, 1u }, mesh, components);
+        REQUIRE(path);
+        REQUIRE(path->getLength() == 4u);
+    }
+}
+
+TEST_CASE("Tile path is optimal", "[TileNavMesh]")
+{
+    const unsigned width = 48u, height = 40u;
+    auto mesh = buildRandomMesh(width, height, 12345u, 4u, MeshBorder::None);
+    mesh[sf::Vector2u(0u, 0u)] = 0;
+    mesh[sf::Vector2u(1u, 0u)] = 0;
+    mesh[sf::Vector2u(0u, 1u)] = 0;
+    const auto distances = computeBfsDistances(mesh, { 0u, 0u });
+
+    unsigned reachable = 0;
+    for (unsigned y = 0; y < height; ++y)
+    {
+        for (unsigned x = 0; x < width; ++x)
+        {
+            if ((x + y) % 3 != 0 || mesh[sf::Vector2u(x, y)] > 0) continue;
+
+            INFO("Destination " << x << ", " << y);
+            const int expected = distances[y * width + x];
+            auto path =
+                dgm::TileNavMesh::computePath({ 0u, 0u }, { x, y }, mesh);
+            REQUIRE(path.has_value() == (expected != -1));
+            if (!path) continue;
+
+            ++reachable;
+            REQUIRE(path->getLength() == static_cast<std::size_t>(expected));
+
+            // Every step of the path moves to an adjacent open tile
+            auto previous = sf::Vector2u(0u, 0u);
+            while (!path->isTraversed())
+            {
+                const auto current = path->getCurrentPoint().coord;
+                REQUIRE(mesh[current] <= 0);
+                REQUIRE(
+                    NUMBER_DISTANCE(previous.x, current.x)
+                        + NUMBER_DISTANCE(previous.y, current.y)
+                    == 1u);
+                previous = current;
+                path->advance();
+            }
+        }
+    }
+
+    REQUIRE(reachable > 100u);
+}
+
+TEST_CASE("Computing Jump Point Search tile path", "[TileNavMesh]")
+{
+    SECTION("Edge cases behave like computePath")
+    {
+        const auto mesh = buildMeshForTesting();
+        using dgm::TileNavMesh;
+        REQUIRE(TileNavMesh::computeJumpPointPath({ 1u, 1u }, { 1u, 1u }, mesh)
+                    ->isTraversed());
+        REQUIRE_FALSE(
+            TileNavMesh::computeJumpPointPath({ 1u, 1u }, { 8u, 1u }, mesh));
+        REQUIRE_FALSE(
+            TileNavMesh::computeJumpPointPath({ 6u, 1u }, { 1u, 1u }, mesh));
+        REQUIRE_FALSE(
+            TileNavMesh::computeJumpPointPath({ 1u, 1u }, { 6u, 1u }, mesh));
+    }
+
+    SECTION("Unexpanded path only contains jump points")
+    {
+        const auto mesh = buildMeshForTesting();
+        auto path = dgm::TileNavMesh::computeJumpPointPath(
+                        { 1u, 4u }, { 5u, 1u }, mesh, false)
+                        .value();
+
+        const std::vector<sf::Vector2u> refpoints = {
+            { 1u, 2u },
+            { 1u, 1u },
+            { 5u, 1u },
+        };
+
+        REQUIRE(path.getLength() == refpoints.size());
+        for (auto&& point : refpoints)
+        {
+            REQUIRE_SAME_VECTORS(point, path.getCurrentPoint().coord);
+            path.advance();
+        }
+    }
+
+    SECTION("Path lengths match A* on random maps")
+    {
+        auto rng = std::mt19937(7u);
+        auto context = dgm::PathSearchContext();
+
+        for (unsigned density : { 3u, 5u, 10u, 100u })
+        {
+            const unsigned width = 30u, height = 25u;
+            const auto mesh = buildRandomMesh(
+                width, height, density, density, MeshBorder::None);
+
+            for (unsigned i = 0; i < 300; ++i)
+            {
+                const auto from = sf::Vector2u(rng() % width, rng() % height);
+                const auto to = sf::Vector2u(rng() % width, rng() % height);
+                INFO(
+                    "Density " << density << ", from " << from.x << ", "
+                               << from.y << " to " << to.x << ", " << to.y);
+
+                auto expected =
+                    dgm::TileNavMesh::computePath(from, to, mesh, context);
+                auto path = dgm::TileNavMesh::computeJumpPointPath(
+                    from, to, mesh, context);
+                REQUIRE(path.has_value() == expected.has_value());
+                if (!path) continue;
+                REQUIRE(path->getLength() == expected->getLength());
+
+                auto previous = from;
+                while (!path->isTraversed())
+                {
+                    const auto current = path->getCurrentPoint().coord;
+                    REQUIRE(mesh[current] <= 0);
+                    REQUIRE(
+                        NUMBER_DISTANCE(previous.x, current.x)
+                            + NUMBER_DISTANCE(previous.y, current.y)
+                        == 1u);
+                    previous = current;
+                    path->advance();
+                }
+                REQUIRE_SAME_VECTORS(previous, to);
+            }
+        }
+    }
+}
+
+TEST_CASE("Reusing PathSearchContext", "[PathSearchContext]")
+{
+    auto&& requireSamePaths = [](auto&& path1, auto&& path2)
+    {
+        REQUIRE(path1.getLength() == path2.getLength());
+        while (!path1.isTraversed())
+        {
+            REQUIRE_SAME_VECTORS(
+                path1.getCurrentPoint().coord, path2.getCurrentPoint().coord);
+            path1.advance();
+            path2.advance();
+        }
+    };
+
+    const auto smallMesh = buildMeshForTesting();
+    auto navmesh = dgm::WorldNavMesh(buildMeshForTesting());
+    auto context = dgm::PathSearchContext();
+
+    const std::vector<int> largeMap(64u * 48u, 0);
+    const auto largeMesh = dgm::Mesh(largeMap, { 64u, 48u }, { 32u, 32u });
+
+    for (unsigned repeat = 0; repeat < 3; ++repeat)
+    {
+        for (unsigned y1 = 1; y1 < 5; ++y1)
+        {
+            for (unsigned x1 = 1; x1 < 9; ++x1)
+            {
+                const auto from = sf::Vector2u(x1, y1);
+                const auto to = sf::Vector2u(9u - x1, 5u - y1);
+                INFO("From " << x1 << ", " << y1);
+
+                auto tilePath1 =
+                    dgm::TileNavMesh::computePath(from, to, smallMesh);
+                auto tilePath2 =
+                    dgm::TileNavMesh::computePath(from, to, smallMesh, context);
+                REQUIRE(tilePath1.has_value() == tilePath2.has_value());
+                if (tilePath1) requireSamePaths(*tilePath1, *tilePath2);
+
+                const auto worldFrom =
+                    (sf::Vector2f(from) + sf::Vector2f(0.5f, 0.5f)) * 32.f;
+                const auto worldTo =
+                    (sf::Vector2f(to) + sf::Vector2f(0.5f, 0.5f)) * 32.f;
+                requireSamePaths(
+                    navmesh.computePath(worldFrom, worldTo),
+                    navmesh.computePath(worldFrom, worldTo, context));
+            }
+        }
+
+        // Context grows when used with a bigger mesh and keeps working with
+        // the smaller one afterwards
+        auto&& longPath = dgm::TileNavMesh::computePath(
+            { 0u, 0u }, { 63u, 47u }, largeMesh, context);
+        REQUIRE(longPath.has_value());
+        REQUIRE(longPath->getLength() == 63u + 47u);
+    }
+}
+
+#ifdef PATHFINDING_STATS
+TEST_CASE("Collecting path search stats", "[PathSearchContext]")
+{
+    const unsigned width = 20u, height = 12u;
+    std::vector<int> map(width * height, 0);
+    for (unsigned y = 0; y < height; ++y)
+    {
+        for (unsigned x = 0; x < width; ++x)
+        {
+            const bool border =
+                x == 0 || y == 0 || x == width - 1 || y == height - 1;
+            map[y * width + x] = border || (x == 8 && y < 9) ? 1 : 0;
+        }
+    }
+    const auto mesh = dgm::Mesh(map, { width, height }, { 32u, 32u });
+    auto context = dgm::PathSearchContext();
+
+    SECTION("Tile queries")
+    {
+        dgm::TileNavMesh::resetSearchTotals();
+
+        const auto path = dgm::TileNavMesh::computePath(
+            { 1u, 1u }, { 18u, 1u }, mesh, context);
+        REQUIRE(path.has_value());
+
+        const auto stats = context.getLastStats();
+        REQUIRE(stats.pathLength == path->getLength());
+        REQUIRE(stats.expandedNodeCount > path->getLength());
+        REQUIRE(stats.generatedNodeCount >= stats.expandedNodeCount);
+        REQUIRE(stats.peakOpenSetSize > 0u);
+        REQUIRE(stats.peakOpenSetSize <= stats.generatedNodeCount);
+
+        // Queries resolved without a search are counted too
+        REQUIRE_FALSE(
+            dgm::TileNavMesh::computePath({ 0u, 0u }, { 1u, 1u }, mesh, context)
+                .has_value());
+        REQUIRE(context.getLastStats().expandedNodeCount == 0u);
+        REQUIRE(context.getLastStats().pathLength == 0u);
+
+        const auto totals = dgm::TileNavMesh::getSearchTotals();
+        REQUIRE(totals.queryCount == 2u);
+        REQUIRE(totals.expandedNodeCount == stats.expandedNodeCount);
+        REQUIRE(totals.generatedNodeCount == stats.generatedNodeCount);
+        REQUIRE(totals.peakOpenSetSize == stats.peakOpenSetSize);
+        REQUIRE(totals.pathLength == stats.pathLength);
+        REQUIRE(totals.longestDuration >= stats.duration);
+        REQUIRE(totals.duration >= totals.longestDuration);
+    }
+
+    SECTION("World queries and requests")
+    {
+        auto navmesh = dgm::WorldNavMesh(
+            dgm::Mesh(map, { width, height }, { 32u, 32u }));
+        const auto from = sf::Vector2f(48.f, 48.f);
+        const auto to = sf::Vector2f(592.f, 48.f);
+
+        const auto path = navmesh.computePath(from, to, context);
+        const auto stats = context.getLastStats();
+        REQUIRE(path.getLength() > 0u);
+        REQUIRE(stats.pathLength == path.getLength());
+        REQUIRE(stats.expandedNodeCount > 0u);
+
+        // Splitting the search into steps does not change the counts
+        auto request = navmesh.requestPath(from, to);
+        while (request.step(1) == dgm::PathRequestStatus::InProgress)
+            ;
+        REQUIRE(request.getStatus() == dgm::PathRequestStatus::Found);
+
+        auto totals = navmesh.getSearchTotals();
+        REQUIRE(totals.queryCount == 2u);
+        REQUIRE(totals.expandedNodeCount == 2u * stats.expandedNodeCount);
+        REQUIRE(totals.generatedNodeCount == 2u * stats.generatedNodeCount);
+        REQUIRE(totals.pathLength == 2u * stats.pathLength);
+
+        navmesh.resetSearchTotals();
+        totals = navmesh.getSearchTotals();
+        REQUIRE(totals.queryCount == 0u);
+        REQUIRE(totals.duration == std::chrono::nanoseconds::zero());
+    }
+}
+#endif
+
+TEST_CASE("Concurrent queries", "[WorldNavMesh]")
+{
+    const unsigned width = 40u, height = 30u;
+    const auto navmesh =
+        dgm::WorldNavMesh(buildRandomMesh(width, height, 42u, 5u));
+
+    auto rng = std::mt19937(42u);
+    auto&& queries = std::vector<dgm::WorldNavMesh::PathQuery>();
+    for (unsigned i = 0; i < 200; ++i)
+    {
+        auto&& randomPoint = [&]
+        {
+            return sf::Vector2f(
+                (1 + rng() % (width - 2)) * 32.f + 16.f,
+                (1 + rng() % (height - 2)) * 32.f + 16.f);
+        };
+        queries.push_back({ .from = randomPoint(), .to = randomPoint() });
+    }
+
+    auto&& expected = std::vector<std::vector<sf::Vector2f>>();
+    auto&& toPoints = [](dgm::Path<dgm::WorldNavpoint>&& path)
+    {
+        std::vector<sf::Vector2f> points;
+        for (; !path.isTraversed(); path.advance())
+            points.push_back(path.getCurrentPoint().coord);
+        return points;
+    };
+    for (auto&& query : queries)
+        expected.push_back(toPoints(navmesh.computePath(query.from, query.to)));
+
+    SECTION("Batch matches sequential queries")
+    {
+        for (unsigned threadCount : { 1u, 4u, 16u })
+        {
+            INFO("Thread count " << threadCount);
+            auto&& pool = dgm::WorkerPool(threadCount);
+
+            // Threads of the pool are reused by subsequent batches
+            for (unsigned batch = 0; batch < 3; ++batch)
+            {
+                auto&& paths = navmesh.computePaths(queries, pool);
+                REQUIRE(paths.size() == queries.size());
+                for (std::size_t i = 0; i < paths.size(); ++i)
+                    REQUIRE(toPoints(std::move(paths[i])) == expected[i]);
+            }
+        }
+    }
+
+    SECTION("Many threads can query one navmesh")
+    {
+        auto&& mismatches = std::array<unsigned, 4> {};
+        {
+            auto&& threads = std::vector<std::jthread>();
+            for (unsigned t = 0; t < mismatches.size(); ++t)
+            {
+                threads.emplace_back(
+                    [&, t]
+                    {
+                        auto&& context = dgm::PathSearchContext();
+                        for (std::size_t i = t; i < queries.size(); ++i)
+                        {
+                            auto&& points = toPoints(navmesh.computePath(
+                                queries[i].from, queries[i].to, context));
+                            if (points != expected[i]) ++mismatches[t];
+                        }
+                    });
+            }
+        }
+
+        for (auto&& count : mismatches)
+            REQUIRE(count == 0u);
+    }
+}
+
+TEST_CASE("Repairing WorldNavMesh after mesh changes", "[WorldNavMesh]")
+{
+    auto&& toWorldCoord = [](unsigned x, unsigned y)
+    { return sf::Vector2f(x * 32.f + 16.f, y * 32.f + 16.f); };
+
+    SECTION("Opening a wall creates a path")
+    {
+        auto navmesh = TestableNavMesh(buildMeshForTesting());
+        REQUIRE(navmesh.computePath(toWorldCoord(1, 1), toWorldCoord(8, 1))
+                    .isTraversed());
+
+        navmesh.setTile({ 7u, 2u }, 0);
+        REQUIRE_FALSE(
+            navmesh.computePath(toWorldCoord(1, 1), toWorldCoord(8, 1))
+                .isTraversed());
+
+        navmesh.setTile({ 7u, 2u }, 1);
+        REQUIRE(navmesh.computePath(toWorldCoord(1, 1), toWorldCoord(8, 1))
+                    .isTraversed());
+    }
+
+    SECTION("Repaired graph matches a rebuilt one")
+    {
+        // Destination y, x, distance and clearance of each connection
+        using ConnectionList = std::vector<
+            std::tuple<unsigned, unsigned, unsigned, unsigned>>;
+        auto&& getSortedGraph = [](const TestableNavMesh& navmesh)
+        {
+            std::vector<std::pair<sf::Vector2u, ConnectionList>> result;
+            for (auto&& [point, connections] : navmesh.getConnections())
+            {
+                ConnectionList list;
+                for (auto&& connection : connections)
+                    list.emplace_back(
+                        connection.destination.y,
+                        connection.destination.x,
+                        connection.distance,
+                        connection.clearance);
+                std::sort(list.begin(), list.end());
+                result.emplace_back(point, list);
+            }
+            std::sort(
+                result.begin(),
+                result.end(),
+                [](const auto& a, const auto& b)
+                {
+                    return std::tie(a.first.y, a.first.x)
+                           < std::tie(b.first.y, b.first.x);
+                });
+            return result;
+        };
+
+        // Larger agents make changes reach farther
+        for (unsigned maxAgentRadius : { 0u, 2u })
+        {
+            const unsigned width = 32u, height = 24u;
+            auto navmesh = TestableNavMesh(
+                buildRandomMesh(width, height, 7u, 4u),
+                { .maxAgentRadius = maxAgentRadius });
+            auto rng = std::mt19937(7u);
+
+            for (unsigned i = 0; i < 60; ++i)
+            {
+                if (i % 3 == 0)
+                {
+                    // Batch change through a copy of the mesh
+                    auto source = navmesh.getMesh().clone();
+                    const auto region = sf::Rect<unsigned>(
+                        sf::Vector2u(
+                            1 + rng() % (width - 2), 1 + rng() % (height - 2)),
+                        sf::Vector2u(1 + rng() % 6, 1 + rng() % 6));
+                    const auto end = region.position + region.size;
+                    for (unsigned y = region.position.y;
+                         y < end.y && y < height - 1;
+                         ++y)
+                    {
+                        for (unsigned x = region.position.x;
+                             x < end.x && x < width - 1;
+                             ++x)
+                            source[sf::Vector2u(x, y)] = rng() % 3 == 0 ? 1 : 0;
+                    }
+                    navmesh.updateRegion(source, region);
+                }
+                else
+                {
+                    const auto tile = sf::Vector2u(
+                        1 + rng() % (width - 2), 1 + rng() % (height - 2));
+                    navmesh.setTile(tile, navmesh.getMesh()[tile] > 0 ? 0 : 1);
+                }
+
+                INFO(
+                    "Iteration " << i << ", max agent radius "
+                                 << maxAgentRadius);
+                const auto rebuilt = TestableNavMesh(
+                    navmesh.getMesh().clone(),
+                    { .maxAgentRadius = maxAgentRadius });
+                REQUIRE(getSortedGraph(navmesh) == getSortedGraph(rebuilt));
+            }
+        }
+    }
+}
+
+TEST_CASE("Parallel construction", "[WorldNavMesh]")
+{
+    const auto serial =
+        TestableNavMesh(buildRandomMesh(120u, 90u, 11u, 5u), 1u);
+
+    // Enough jump points for several chunks of work
+    REQUIRE(serial.getJumpPoints().size() > 1000u);
+
+    for (unsigned threadCount : { 0u, 2u, 3u, 8u })
+    {
+        INFO("Thread count " << threadCount);
+        const auto parallel =
+            TestableNavMesh(buildRandomMesh(120u, 90u, 11u, 5u), threadCount);
+        REQUIRE(parallel.hasSameGraph(serial));
+    }
+}
+
+TEST_CASE("Saving and loading WorldNavMesh graph", "[WorldNavMesh]")
+{
+    const auto mesh = buildRandomMesh(40u, 30u, 3u, 5u);
+    const auto original = TestableNavMesh(mesh.clone());
+    const auto graph = original.saveGraph();
+
+    SECTION("Loaded graph is identical")
+    {
+        auto&& loaded = dgm::WorldNavMesh::loadGraph(mesh.clone(), graph);
+        REQUIRE(loaded.has_value());
+
+        const auto navmesh = TestableNavMesh(std::move(loaded.value()));
+        REQUIRE(navmesh.hasSameGraph(original));
+
+        auto path = navmesh.computePath({ 48.f, 48.f }, { 1232.f, 912.f });
+        auto expected =
+            original.computePath({ 48.f, 48.f }, { 1232.f, 912.f });
+        for (; !expected.isTraversed(); expected.advance(), path.advance())
+        {
+            REQUIRE_FALSE(path.isTraversed());
+            REQUIRE(
+                path.getCurrentPoint().coord
+                == expected.getCurrentPoint().coord);
+        }
+        REQUIRE(path.isTraversed());
+    }
+
+    SECTION("Graph of a different mesh is rejected")
+    {
+        auto otherMesh = mesh.clone();
+        const auto tile = sf::Vector2u(1u, 1u);
+        otherMesh[tile] = otherMesh[tile] > 0 ? 0 : 1;
+        REQUIRE_FALSE(dgm::WorldNavMesh::loadGraph(std::move(otherMesh), graph)
+                          .has_value());
+    }
+
+    SECTION("Graph of a mesh with different voxel size is rejected")
+    {
+        // Connection distances are stored in world units
+        auto otherMesh = dgm::Mesh(mesh.getDataSize(), { 16u, 16u });
+        for (std::size_t i = 0; i < 40u * 30u; ++i)
+            otherMesh[i] = mesh[i];
+        REQUIRE_FALSE(dgm::WorldNavMesh::loadGraph(std::move(otherMesh), graph)
+                          .has_value());
+    }
+
+    SECTION("Different version is rejected")
+    {
+        auto modified = graph;
+        modified[4] = std::byte { 0xFF };
+        REQUIRE_FALSE(
+            dgm::WorldNavMesh::loadGraph(mesh.clone(), modified).has_value());
+    }
+
+    SECTION("Truncated graph is rejected")
+    {
+        for (std::size_t size : { 0uz, 16uz, graph.size() - 1 })
+        {
+            INFO("Size " << size);
+            REQUIRE_FALSE(dgm::WorldNavMesh::loadGraph(
+                              mesh.clone(), std::span(graph).first(size))
+                              .has_value());
+        }
+    }
+
+    SECTION("Corrupted connection is rejected")
+    {
+        // Last connection is stored right before scan bounds
+        auto modified = graph;
+        const auto boundsSize = original.getJumpPoints().size() * 16;
+        for (std::size_t i = 1; i <= 12; ++i)
+            modified[graph.size() - boundsSize - i] = std::byte { 0xFF };
+        REQUIRE_FALSE(
+            dgm::WorldNavMesh::loadGraph(mesh.clone(), modified).has_value());
+    }
+}
+
+TEST_CASE("Landmark heuristic of WorldNavMesh", "[WorldNavMesh]")
+{
+    // Rooms separated by walls with a few doors, so paths make detours
+    const unsigned width = 46u, height = 36u;
+    std::vector<int> map(width * height, 0);
+    auto rng = std::mt19937(17u);
+    for (unsigned y = 0; y < height; ++y)
+    {
+        for (unsigned x = 0; x < width; ++x)
+        {
+            const bool border =
+                x == 0 || y == 0 || x == width - 1 || y == height - 1;
+            const bool wall = (x % 9 == 0 || y % 7 == 0) && rng() % 6 != 0;
+            map[y * width + x] = border || wall || rng() % 10 == 0 ? 1 : 0;
+        }
+    }
+    auto&& buildMesh = [&]
+    { return dgm::Mesh(map, { width, height }, { 32u, 32u }); };
+
+    // Same units the search works with, connection distances are truncated
+    auto&& getCost = [](const sf::Vector2f& from,
+                        dgm::Path<dgm::WorldNavpoint>&& path)
+    {
+        unsigned cost = 0;
+        for (auto previous = from; !path.isTraversed(); path.advance())
+        {
+            const auto current = path.getCurrentPoint().coord;
+            const float dx = current.x - previous.x;
+            const float dy = current.y - previous.y;
+            cost += static_cast<unsigned>(std::sqrt(dx * dx + dy * dy));
+            previous = current;
+        }
+        return cost;
+    };
+
+    auto&& randomPoint = [&]
+    {
+        return sf::Vector2f(
+            (1 + rng() % (width - 2)) * 32.f + 16.f,
+            (1 + rng() % (height - 2)) * 32.f + 16.f);
+    };
+
+    auto navmesh = TestableNavMesh(buildMesh());
+    navmesh.buildLandmarks(4u);
+
+    auto&& requireSameCosts = [&](const dgm::WorldNavMesh& reference)
+    {
+        auto&& context = dgm::PathSearchContext();
+        for (unsigned i = 0; i < 150; ++i)
+        {
+            const auto from = randomPoint();
+            const auto to = randomPoint();
+
+            INFO("From " << from.x << ", " << from.y << " to " << to.x << ", "
+                         << to.y);
+            auto&& expected = reference.computePath(from, to, context);
+            auto&& path = navmesh.computePath(from, to, context);
+            REQUIRE(path.isTraversed() == expected.isTraversed());
+            REQUIRE(
+                getCost(from, std::move(path))
+                == getCost(from, std::move(expected)));
+        }
+    };
+
+    SECTION("Paths are as short as without landmarks")
+    {
+        requireSameCosts(TestableNavMesh(buildMesh()));
+    }
+
+    SECTION("Landmarks follow changes of the graph")
+    {
+        for (unsigned i = 0; i < 20; ++i)
+        {
+            const auto tile = sf::Vector2u(
+                1 + rng() % (width - 2), 1 + rng() % (height - 2));
+            navmesh.setTile(tile, navmesh.getMesh()[tile] > 0 ? 0 : 1);
+        }
+
+        requireSameCosts(TestableNavMesh(navmesh.getMesh().clone()));
+    }
+
+    SECTION("Landmarks can be turned off")
+    {
+        navmesh.buildLandmarks(0u);
+        requireSameCosts(TestableNavMesh(buildMesh()));
+    }
+}
+
+TEST_CASE("Agents of different sizes in WorldNavMesh", "[WorldNavMesh]")
+{
+    auto&& toWorldCoord = [](unsigned x, unsigned y)
+    { return sf::Vector2f(x * 32.f + 16.f, y * 32.f + 16.f); };
+
+    SECTION("Narrow gap only lets small agents through")
+    {
+        // clang-format off
+        const auto mesh = dgm::Mesh({
+            1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+            1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1,
+            1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1,
+            1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1,
+            1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1,
+            1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1,
+            1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        }, { 11u, 7u }, { 32u, 32u });
+        // clang-format on
+        const auto navmesh =
+            dgm::WorldNavMesh(mesh.clone(), { .maxAgentRadius = 1u });
+        REQUIRE(navmesh.getMaxAgentRadius() == 1u);
+
+        const auto left = toWorldCoord(2, 3), right = toWorldCoord(7, 3);
+        REQUIRE_FALSE(navmesh.computePath(left, right).isTraversed());
+        REQUIRE(navmesh.computePath(left, right, 1u).isTraversed());
+        REQUIRE_FALSE(
+            navmesh.computePath(toWorldCoord(7, 2), toWorldCoord(7, 4), 1u)
+                .isTraversed());
+
+        // Agent does not fit into the corner of the room
+        REQUIRE(navmesh.computePath(toWorldCoord(7, 3), toWorldCoord(9, 1), 1u)
+                    .isTraversed());
+    }
+
+    const unsigned width = 48u, height = 36u;
+    const auto mesh = buildRandomMesh(width, height, 23u, 14u);
+    auto rng = std::mt19937(23u);
+
+    SECTION("Graph for single tile agents is unchanged")
+    {
+        const auto navmesh =
+            TestableNavMesh(mesh.clone(), { .maxAgentRadius = 0u });
+        REQUIRE(navmesh.hasSameGraph(TestableNavMesh(mesh.clone())));
+    }
+
+    SECTION("Paths keep agents clear of walls")
+    {
+        const auto navmesh =
+            TestableNavMesh(mesh.clone(), { .maxAgentRadius = 2u });
+        const auto& clearance = navmesh.getClearanceMap();
+        auto&& context = dgm::PathSearchContext();
+
+        for (unsigned agentRadius : { 0u, 1u, 2u })
+        {
+            for (unsigned i = 0; i < 150; ++i)
+            {
+                const auto from = sf::Vector2u(
+                    1 + rng() % (width - 2), 1 + rng() % (height - 2));
+                const auto to = sf::Vector2u(
+                    1 + rng() % (width - 2), 1 + rng() % (height - 2));
+                if (from == to || !clearance.canFit(from, agentRadius))
+                    continue;
+
+                INFO(
+                    "Radius " << agentRadius << " from " << from.x << ", "
+                              << from.y << " to " << to.x << ", " << to.y);
+                auto path = navmesh.computePath(
+                    toWorldCoord(from.x, from.y),
+                    toWorldCoord(to.x, to.y),
+                    context,
+                    agentRadius);
+                const auto tilePath = dgm::TileNavMesh::computePath(
+                    from, to, navmesh.getMesh(), clearance, agentRadius);
+                REQUIRE(path.isTraversed() != tilePath.has_value());
+
+                for (; !path.isTraversed(); path.advance())
+                {
+                    const auto coord = path.getCurrentPoint().coord;
+                    REQUIRE(clearance.canFit(
+                        sf::Vector2u(
+                            unsigned(coord.x) / 32u, unsigned(coord.y) / 32u),
+                        agentRadius));
+                }
+            }
+        }
+    }
+
+    SECTION("Batches and requests respect agent radius")
+    {
+        const auto navmesh =
+            dgm::WorldNavMesh(mesh.clone(), { .maxAgentRadius = 2u });
+
+        auto&& queries = std::vector<dgm::WorldNavMesh::PathQuery>();
+        for (unsigned i = 0; i < 60; ++i)
+        {
+            queries.push_back(dgm::WorldNavMesh::PathQuery {
+                .from = toWorldCoord(
+                    1 + rng() % (width - 2), 1 + rng() % (height - 2)),
+                .to = toWorldCoord(
+                    1 + rng() % (width - 2), 1 + rng() % (height - 2)),
+                .agentRadius = i % 3 });
+        }
+
+        auto&& pool = dgm::WorkerPool(4u);
+        auto&& paths = navmesh.computePaths(queries, pool);
+        for (std::size_t i = 0; i < queries.size(); ++i)
+        {
+            const auto& query = queries[i];
+            INFO("Query " << i);
+            auto expected =
+                navmesh.computePath(query.from, query.to, query.agentRadius);
+            auto request =
+                navmesh.requestPath(query.from, query.to, query.agentRadius);
+            while (request.step(4u) == dgm::PathRequestStatus::InProgress)
+                ;
+            const auto requested = request.takePath();
+            REQUIRE(
+                (requested ? requested->getLength() : 0u)
+                == expected.getLength());
+
+            for (; !expected.isTraversed();
+                 expected.advance(), paths[i].advance())
+            {
+                REQUIRE_FALSE(paths[i].isTraversed());
+                REQUIRE(
+                    paths[i].getCurrentPoint().coord
+                    == expected.getCurrentPoint().coord);
+            }
+            REQUIRE(paths[i].isTraversed());
+        }
+    }
 }
 
 TEST_CASE("BUGS", "[WorldNavMesh]")
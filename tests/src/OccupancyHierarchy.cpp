@@ -0,0 +1,152 @@
+#include <DGM/dgm.hpp>
+#include <RandomMesh.hpp>
+#include <catch2/catch_all.hpp>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr float VOXEL = 32.f;
+
+    [[nodiscard]] sf::Vector2f randomPoint(
+        const dgm::Mesh& mesh, std::mt19937& rng, bool onlyTileCenters)
+    {
+        const auto& size = mesh.getDataSize();
+        auto distX = std::uniform_int_distribution<unsigned>(1, size.x - 2);
+        auto distY = std::uniform_int_distribution<unsigned>(1, size.y - 2);
+        auto offset = std::uniform_real_distribution<float>(0.05f, 0.95f);
+
+        const auto tile = sf::Vector2u(distX(rng), distY(rng));
+        const auto fraction = onlyTileCenters
+                                  ? sf::Vector2f(0.5f, 0.5f)
+                                  : sf::Vector2f(offset(rng), offset(rng));
+        return (sf::Vector2f(tile) + fraction) * VOXEL;
+    }
+} // namespace
+
+TEST_CASE("[OccupancyHierarchy]")
+{
+    // clang-format off
+    const std::vector<int> map = {
+        0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 1, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0,
+    };
+    // clang-format on
+    auto mesh = dgm::Mesh(map, { 8u, 7u }, { 32u, 32u });
+    auto hierarchy = dgm::OccupancyHierarchy(mesh);
+
+    SECTION("Builds levels while blocks fit within the mesh")
+    {
+        REQUIRE(hierarchy.getLevelCount() == 2u);
+        REQUIRE(dgm::OccupancyHierarchy(mesh, 1u).getLevelCount() == 1u);
+    }
+
+    SECTION("Marks empty blocks")
+    {
+        CHECK(hierarchy.isBlockEmpty(1u, { 0u, 0u }));
+        CHECK(hierarchy.isBlockEmpty(1u, { 3u, 1u }));
+        CHECK_FALSE(hierarchy.isBlockEmpty(1u, { 2u, 2u }));
+        CHECK(hierarchy.isBlockEmpty(2u, { 0u, 0u }));
+        CHECK(hierarchy.isBlockEmpty(2u, { 1u, 0u }));
+        CHECK_FALSE(hierarchy.isBlockEmpty(2u, { 1u, 1u }));
+    }
+
+    SECTION("Blocks overlapping the mesh boundary are never empty")
+    {
+        CHECK_FALSE(hierarchy.isBlockEmpty(1u, { 0u, 3u }));
+        CHECK_FALSE(hierarchy.isBlockEmpty(2u, { 0u, 1u }));
+        CHECK_FALSE(hierarchy.isBlockEmpty(1u, { 10u, 10u }));
+    }
+
+    SECTION("Reports the highest empty level of a tile")
+    {
+        CHECK(hierarchy.getEmptyBlockLevel({ 1u, 1u }) == 2u);
+        CHECK(hierarchy.getEmptyBlockLevel({ 6u, 6u }) == 0u);
+        CHECK(hierarchy.getEmptyBlockLevel({ 5u, 4u }) == 0u);
+        CHECK(hierarchy.getEmptyBlockLevel({ 1u, 4u }) == 1u);
+        CHECK(hierarchy.getEmptyBlockLevel({ 6u, 4u }) == 1u);
+    }
+
+    SECTION("Updating a tile propagates through all levels")
+    {
+        mesh[sf::Vector2u(1u, 1u)] = 1;
+        hierarchy.updateTile(mesh, { 1u, 1u });
+        CHECK_FALSE(hierarchy.isBlockEmpty(1u, { 0u, 0u }));
+        CHECK_FALSE(hierarchy.isBlockEmpty(2u, { 0u, 0u }));
+
+        mesh[sf::Vector2u(1u, 1u)] = 0;
+        mesh[sf::Vector2u(5u, 5u)] = 0;
+        hierarchy.updateTile(mesh, { 1u, 1u });
+        hierarchy.updateTile(mesh, { 5u, 5u });
+        CHECK(hierarchy.isBlockEmpty(2u, { 0u, 0u }));
+        CHECK(hierarchy.isBlockEmpty(1u, { 2u, 2u }));
+    }
+}
+
+TEST_CASE("[OccupancyHierarchy] - agrees with plain Raycaster")
+{
+    auto rng = std::mt19937(1337u);
+
+    for (unsigned seed = 0; seed < 8; ++seed)
+    {
+        const auto mesh =
+            buildRandomMesh(37u + seed * 5u, 29u + seed * 3u, seed, 4u << seed);
+        const auto hierarchy = dgm::OccupancyHierarchy(mesh);
+
+        for (unsigned i = 0; i < 250; ++i)
+        {
+            // Tile centers produce axis-aligned and diagonal rays that
+            // exercise tie breaking between the axes
+            const bool centers = i % 2 == 0;
+            const auto from = randomPoint(mesh, rng, centers);
+            const auto to = randomPoint(mesh, rng, centers);
+            if (from == to) continue;
+
+            // Hit location is undefined when the ray starts inside a wall
+            if (mesh[sf::Vector2u(from / VOXEL)] > 0) continue;
+
+            INFO(
+                "Seed " << seed << ", from " << from.x << ", " << from.y
+                        << " to " << to.x << ", " << to.y);
+
+            CHECK(
+                dgm::Raycaster::hasDirectVisibility(from, to, mesh, hierarchy)
+                == dgm::Raycaster::hasDirectVisibility(from, to, mesh));
+
+            const auto expected =
+                dgm::Raycaster::raycast(from, to - from, mesh);
+            const auto result =
+                dgm::Raycaster::raycast(from, to - from, mesh, hierarchy);
+            CHECK(result.tile == expected.tile);
+            CHECK(result.hitDirection == expected.hitDirection);
+            CHECK(
+                (result.hitLocation - expected.hitLocation).length()
+                < VOXEL * 1e-3f);
+        }
+    }
+}
+
+TEST_CASE("[OccupancyHierarchy] - raycast after mesh update")
+{
+    auto mesh = buildRandomMesh(40u, 40u, 99u, 20u);
+    auto hierarchy = dgm::OccupancyHierarchy(mesh);
+
+    // Clear the row and then block it far away from the origin
+    for (unsigned x = 1; x < 39; ++x)
+    {
+        mesh[sf::Vector2u(x, 20u)] = 0;
+        hierarchy.updateTile(mesh, { x, 20u });
+    }
+    mesh[sf::Vector2u(30u, 20u)] = 1;
+    hierarchy.updateTile(mesh, { 30u, 20u });
+
+    const auto result = dgm::Raycaster::raycast(
+        { 1.5f * VOXEL, 20.5f * VOXEL }, { 1.f, 0.f }, mesh, hierarchy);
+    REQUIRE(result.tile == sf::Vector2u(30u, 20u));
+    REQUIRE(result.hitDirection == dgm::Raycaster::HitDirection::Vertical);
+}
@@ -0,0 +1,262 @@
+#include <DGM/classes/ParticleBuffer.hpp>
+#include <DGM/classes/ParticleKernels.hpp>
+#include <DGM/classes/ParticleSystem.hpp>
+#include <catch2/catch_all.hpp>
+#include <numbers>
+
+using Catch::Approx;
+
+class TestableTime_Particles : public dgm::Time
+{
+public:
+    TestableTime_Particles(float dt)
+    {
+        deltaTime = dt;
+        elapsed = sf::seconds(dt);
+    }
+};
+
+/**
+ *  Particles fly right at 10 px/s and live for given time
+ */
+class TestableParticleSystem : public dgm::ps::ParticleSystem
+{
+public:
+    using ParticleSystem::ParticleSystem;
+
+    void spawn(const sf::Vector2f& position, float lifespan)
+    {
+        const auto index =
+            particles.spawn(position, 2.f, sf::seconds(lifespan));
+        REQUIRE(index.has_value());
+        particles.getVelocitiesX()[*index] = 10.f;
+    }
+
+    [[nodiscard]] std::span<sf::Vertex> getVertices()
+    {
+        return renderer.getVertices();
+    }
+
+    [[nodiscard]] std::size_t getSubmittedVertexCount() const
+    {
+        return renderer.getSubmittedVertexCount();
+    }
+
+protected:
+    void simulate(const dgm::Time& time) override
+    {
+        auto&& positionsX = particles.getPositionsX();
+        auto&& velocitiesX = particles.getVelocitiesX();
+        auto&& lifespans = particles.getLifespans();
+        for (std::size_t i = 0; i < particles.getSize(); ++i)
+        {
+            positionsX[i] += velocitiesX[i] * time.getDeltaTime();
+            lifespans[i] -= time.getDeltaTime();
+        }
+        particles.removeDead();
+    }
+};
+
+/**
+ *  Spawns particles in simulate and moves them in chunks
+ */
+class ChunkedParticleSystem : public dgm::ps::ParticleSystem
+{
+public:
+    using ParticleSystem::ParticleSystem;
+
+    [[nodiscard]] std::span<sf::Vertex> getVertices()
+    {
+        return renderer.getVertices();
+    }
+
+protected:
+    void simulate(const dgm::Time&) override
+    {
+        while (!particles.isFull())
+        {
+            const auto i = particles.getSize();
+            const auto index = particles.spawn(
+                { static_cast<float>(i), 0.f },
+                1.f,
+                sf::seconds(static_cast<float>(i % 7)));
+            particles.getVelocitiesY()[*index] = static_cast<float>(i % 5);
+        }
+    }
+
+    void simulateChunk(
+        const dgm::Time& time, dgm::ps::ParticleColumns chunk) noexcept override
+    {
+        using dgm::ps::ParticleKernels;
+        const float dt = time.getDeltaTime();
+        ParticleKernels::integrate(chunk.positionsY, chunk.velocitiesY, dt);
+        ParticleKernels::rotate(chunk.rotations, 1.f, dt);
+        ParticleKernels::decayLifespans(chunk.lifespans, dt);
+    }
+};
+
+TEST_CASE("[ParticleBuffer]")
+{
+    SECTION("Spawning until full")
+    {
+        auto&& buffer = dgm::ps::ParticleBuffer(2);
+        REQUIRE(buffer.isEmpty());
+        REQUIRE(buffer.getCapacity() == 2u);
+
+        REQUIRE(buffer.spawn({ 1.f, 2.f }, 4.f, sf::seconds(1.f)) == 0u);
+        REQUIRE(buffer.spawn({ 3.f, 4.f }, 4.f, sf::seconds(2.f)) == 1u);
+        REQUIRE(buffer.isFull());
+        REQUIRE_FALSE(buffer.spawn({ 5.f, 6.f }, 4.f, sf::seconds(3.f)));
+
+        REQUIRE(buffer.getSize() == 2u);
+        REQUIRE(buffer.getPositionsX()[1] == 3.f);
+        REQUIRE(buffer.getPositionsY()[1] == 4.f);
+        REQUIRE(buffer.getLifespans()[1] == 2.f);
+        REQUIRE(buffer.getInitialLifespans()[1] == 2.f);
+        REQUIRE(buffer.getVelocitiesX()[1] == 0.f);
+        REQUIRE(buffer.getColors()[1] == sf::Color::White);
+
+        buffer.clear();
+        REQUIRE(buffer.isEmpty());
+        REQUIRE(buffer.getPositionsX().empty());
+    }
+
+    SECTION("Removing moves last particle into the slot")
+    {
+        auto&& buffer = dgm::ps::ParticleBuffer(3);
+        for (float x : { 0.f, 1.f, 2.f })
+        {
+            auto&& index = buffer.spawn({ x, 0.f }, 1.f, sf::seconds(1.f));
+            buffer.getColors()[*index] =
+                sf::Color(0, 0, 0, static_cast<std::uint8_t>(10 * x));
+        }
+
+        buffer.remove(0);
+        REQUIRE(buffer.getSize() == 2u);
+        REQUIRE(buffer.getPositionsX()[0] == 2.f);
+        REQUIRE(buffer.getColors()[0].a == 20);
+        REQUIRE(buffer.getPositionsX()[1] == 1.f);
+    }
+
+    SECTION("Removing dead particles")
+    {
+        auto&& buffer = dgm::ps::ParticleBuffer(6);
+        for (float lifespan : { 0.f, 1.f, -1.f, 2.f, 0.f, 0.f })
+            std::ignore =
+                buffer.spawn({ lifespan, 0.f }, 1.f, sf::seconds(lifespan));
+
+        buffer.removeDead();
+        REQUIRE(buffer.getSize() == 2u);
+        for (auto&& lifespan : buffer.getLifespans())
+            REQUIRE(lifespan > 0.f);
+        REQUIRE(
+            buffer.getPositionsX()[0] + buffer.getPositionsX()[1] == 3.f);
+    }
+
+    SECTION("Getting columns of a range")
+    {
+        auto&& buffer = dgm::ps::ParticleBuffer(4);
+        for (float x : { 0.f, 1.f, 2.f })
+            std::ignore = buffer.spawn({ x, 0.f }, 1.f, sf::seconds(1.f));
+
+        auto&& all = buffer.getColumns();
+        REQUIRE(all.getSize() == 3u);
+        REQUIRE(all.textureRects.size() == 3u);
+
+        auto&& range = buffer.getColumns(1, 2);
+        REQUIRE(range.getSize() == 2u);
+        REQUIRE(range.positionsX[0] == 1.f);
+        range.colors[1] = sf::Color::Blue;
+        REQUIRE(buffer.getColors()[2] == sf::Color::Blue);
+    }
+
+    SECTION("Writing vertices")
+    {
+        auto&& buffer = dgm::ps::ParticleBuffer(2);
+        std::ignore = buffer.spawn({ 10.f, 20.f }, 4.f, sf::seconds(1.f));
+        auto&& index = buffer.spawn({ 0.f, 0.f }, 2.f, sf::seconds(1.f));
+        buffer.getRotations()[*index] = std::numbers::pi_v<float> / 2.f;
+        buffer.getColors()[*index] = sf::Color::Red;
+        buffer.getTextureRects()[*index] = sf::IntRect({ 8, 16 }, { 4, 2 });
+
+        auto&& vertices = std::vector<sf::Vertex>(
+            2 * dgm::ps::ParticleBuffer::VERTICES_PER_PARTICLE);
+        buffer.writeVertices(vertices);
+
+        // Same layout as dgm::ps::Particle::spawn
+        const sf::Vector2f expected[] = {
+            { 8.f, 18.f },  { 12.f, 18.f }, { 8.f, 22.f },
+            { 12.f, 18.f }, { 12.f, 22.f }, { 8.f, 22.f },
+        };
+        for (unsigned i = 0; i < 6; ++i)
+        {
+            REQUIRE(vertices[i].position.x == Approx(expected[i].x));
+            REQUIRE(vertices[i].position.y == Approx(expected[i].y));
+        }
+
+        // Rotation by 90 degrees moves top left corner to top right
+        REQUIRE(vertices[6].position.x == Approx(1.f));
+        REQUIRE(vertices[6].position.y == Approx(-1.f));
+        REQUIRE(vertices[10].position.x == Approx(-1.f));
+        REQUIRE(vertices[10].position.y == Approx(1.f));
+        REQUIRE(vertices[6].color == sf::Color::Red);
+        REQUIRE(vertices[6].texCoords == sf::Vector2f(8.f, 16.f));
+        REQUIRE(vertices[10].texCoords == sf::Vector2f(12.f, 18.f));
+    }
+}
+
+TEST_CASE("[ParticleSystem]")
+{
+    auto&& system = TestableParticleSystem(4);
+    system.spawn({ 0.f, 0.f }, 0.5f);
+    system.spawn({ 100.f, 0.f }, 1.5f);
+
+    system.update(TestableTime_Particles(1.f));
+    REQUIRE(system.getParticles().getSize() == 1u);
+    REQUIRE(system.getParticles().getPositionsX()[0] == 110.f);
+
+    auto&& vertices = system.getVertices();
+    REQUIRE(vertices[0].position.x == Approx(109.f));
+
+    // Only the quad of the live particle is drawn
+    auto&& window = dgm::Window({ 1u, 1u }, "", false);
+    system.draw(window);
+    REQUIRE(system.getSubmittedVertexCount() == 6u);
+
+    system.update(TestableTime_Particles(1.f));
+    system.draw(window);
+    REQUIRE(system.getSubmittedVertexCount() == 0u);
+}
+
+TEST_CASE("[ParticleSystem] Parallel update")
+{
+    // Several chunks with the last one partially filled
+    const unsigned particleCount =
+        2 * dgm::ps::ParticleSystem::CHUNK_SIZE + 100;
+    auto&& serial = ChunkedParticleSystem(particleCount);
+    auto&& parallel = ChunkedParticleSystem(particleCount);
+    auto&& pool = dgm::WorkerPool(4);
+
+    for (unsigned step = 0; step < 3; ++step)
+    {
+        serial.update(TestableTime_Particles(1.f));
+        parallel.update(TestableTime_Particles(1.f), pool);
+    }
+
+    // Dead particles are removed the same way, so the order matches
+    auto&& expected = serial.getParticles();
+    auto&& actual = parallel.getParticles();
+    REQUIRE(expected.getSize() < particleCount);
+    REQUIRE(actual.getSize() == expected.getSize());
+    REQUIRE(std::ranges::equal(
+        actual.getPositionsX(), expected.getPositionsX()));
+    REQUIRE(std::ranges::equal(
+        actual.getPositionsY(), expected.getPositionsY()));
+    REQUIRE(
+        std::ranges::equal(actual.getLifespans(), expected.getLifespans()));
+
+    auto&& expectedVertices = serial.getVertices();
+    auto&& actualVertices = parallel.getVertices();
+    for (std::size_t i = 0; i < expectedVertices.size(); ++i)
+        REQUIRE(actualVertices[i].position == expectedVertices[i].position);
+}
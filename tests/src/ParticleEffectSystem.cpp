@@ -0,0 +1,209 @@
+#include <DGM/classes/ParticleEffectSystem.hpp>
+#include <catch2/catch_all.hpp>
+
+using Catch::Approx;
+
+class TestableTime_Effects : public dgm::Time
+{
+public:
+    TestableTime_Effects(float dt)
+    {
+        deltaTime = dt;
+        elapsed = sf::seconds(dt);
+    }
+};
+
+TEST_CASE("[ParticleEffectSystem]")
+{
+    SECTION("Burst is spawned at once and again after restart")
+    {
+        auto&& system = dgm::ps::ParticleEffectSystem(
+            16,
+            dgm::ps::ParticleEffect {
+                .emitters = { { .burst = 10,
+                                .minLifespan = 1.5f,
+                                .maxLifespan = 1.5f } } });
+        REQUIRE_FALSE(system.isFinished());
+
+        system.update(TestableTime_Effects(1.f));
+        REQUIRE(system.getParticles().getSize() == 10u);
+
+        system.update(TestableTime_Effects(1.f));
+        REQUIRE(system.getParticles().getSize() == 0u);
+        REQUIRE(system.isFinished());
+
+        system.restart();
+        REQUIRE_FALSE(system.isFinished());
+        system.update(TestableTime_Effects(1.f));
+        REQUIRE(system.getParticles().getSize() == 10u);
+    }
+
+    SECTION("Rate carries fractions of particles over updates")
+    {
+        auto&& system = dgm::ps::ParticleEffectSystem(
+            64,
+            dgm::ps::ParticleEffect {
+                .emitters = { { .rate = 10.f,
+                                .minLifespan = 100.f,
+                                .maxLifespan = 100.f } } });
+        for (unsigned i = 0; i < 4; ++i)
+            system.update(TestableTime_Effects(0.25f));
+        REQUIRE(system.getParticles().getSize() == 10u);
+        REQUIRE_FALSE(system.isFinished());
+    }
+
+    SECTION("Spawning stops when buffer is full")
+    {
+        auto&& system = dgm::ps::ParticleEffectSystem(
+            4, dgm::ps::ParticleEffect { .emitters = { { .burst = 10 } } });
+        system.update(TestableTime_Effects(0.1f));
+        REQUIRE(system.getParticles().getSize() == 4u);
+    }
+
+    SECTION("Particles spawn within emitter shape")
+    {
+        auto&& emitter = dgm::ps::Emitter {
+            .position = { 100.f, 50.f },
+            .shape = dgm::ps::Emitter::Circle { .radius = 5.f },
+            .burst = 100,
+        };
+        auto&& circle = dgm::ps::ParticleEffectSystem(
+            100, dgm::ps::ParticleEffect { .emitters = { emitter } });
+        emitter.shape = dgm::ps::Emitter::Rectangle { .size = { 10.f, 4.f } };
+        auto&& rectangle = dgm::ps::ParticleEffectSystem(
+            100, dgm::ps::ParticleEffect { .emitters = { emitter } });
+
+        circle.update(TestableTime_Effects(0.1f));
+        rectangle.update(TestableTime_Effects(0.1f));
+
+        auto&& particles = circle.getParticles();
+        for (std::size_t i = 0; i < particles.getSize(); ++i)
+        {
+            const auto offset =
+                sf::Vector2f(
+                    particles.getPositionsX()[i], particles.getPositionsY()[i])
+                - emitter.position;
+            REQUIRE(offset.length() <= 5.f + 1e-4f);
+        }
+
+        auto&& rectParticles = rectangle.getParticles();
+        for (std::size_t i = 0; i < rectParticles.getSize(); ++i)
+        {
+            REQUIRE(
+                std::abs(rectParticles.getPositionsX()[i] - 100.f) <= 5.f);
+            REQUIRE(std::abs(rectParticles.getPositionsY()[i] - 50.f) <= 2.f);
+        }
+    }
+
+    SECTION("Particles are launched in given direction")
+    {
+        auto&& system = dgm::ps::ParticleEffectSystem(
+            1,
+            dgm::ps::ParticleEffect {
+                .emitters = { { .burst = 1,
+                                .direction = sf::degrees(0.f),
+                                .minSpeed = 10.f,
+                                .maxSpeed = 10.f } } });
+        system.update(TestableTime_Effects(0.5f));
+        REQUIRE(system.getParticles().getVelocitiesX()[0] == Approx(10.f));
+        REQUIRE(
+            system.getParticles().getVelocitiesY()[0]
+            == Approx(0.f).margin(1e-5f));
+        REQUIRE(system.getParticles().getPositionsX()[0] == Approx(5.f));
+    }
+}
+
+TEST_CASE("[ParticleEffectSystem] Affectors")
+{
+    auto&& emitter = dgm::ps::Emitter {
+        .burst = 1,
+        .direction = sf::degrees(90.f),
+        .minSpeed = 10.f,
+        .maxSpeed = 10.f,
+        .minLifespan = 4.f,
+        .maxLifespan = 4.f,
+    };
+
+    SECTION("Forces and drag are applied in order")
+    {
+        auto&& system = dgm::ps::ParticleEffectSystem(
+            1,
+            dgm::ps::ParticleEffect {
+                .emitters = { emitter },
+                .affectors = {
+                    dgm::ps::ForceAffector { .acceleration = { 1.f, 5.f } },
+                    dgm::ps::ForceAffector { .acceleration = { 1.f, 5.f } },
+                    dgm::ps::DragAffector { .drag = 0.5f },
+                    dgm::ps::SpinAffector { .angularVelocity =
+                                                sf::radians(2.f) },
+                } });
+        system.update(TestableTime_Effects(1.f));
+
+        auto&& particles = system.getParticles();
+        REQUIRE(particles.getVelocitiesX()[0] == Approx(1.f));
+        REQUIRE(particles.getVelocitiesY()[0] == Approx(10.f));
+        REQUIRE(particles.getPositionsY()[0] == Approx(10.f));
+        REQUIRE(particles.getRotations()[0] == Approx(2.f));
+    }
+
+    SECTION("Size and color change over life")
+    {
+        auto&& system = dgm::ps::ParticleEffectSystem(
+            1,
+            dgm::ps::ParticleEffect {
+                .emitters = { emitter },
+                .affectors = {
+                    dgm::ps::SizeOverLifeAffector { .start = 2.f,
+                                                    .end = 10.f },
+                    dgm::ps::ColorOverLifeAffector {
+                        .start = sf::Color(0, 0, 200, 255),
+                        .end = sf::Color(100, 0, 0, 55) },
+                } });
+
+        // Affectors see the age before this update
+        system.update(TestableTime_Effects(1.f));
+        auto&& particles = system.getParticles();
+        REQUIRE(particles.getSizes()[0] == Approx(2.f));
+        REQUIRE(particles.getColors()[0] == sf::Color(0, 0, 200, 255));
+
+        system.update(TestableTime_Effects(2.f));
+        REQUIRE(particles.getSizes()[0] == Approx(4.f));
+        REQUIRE(particles.getColors()[0] == sf::Color(25, 0, 150, 205));
+
+        system.update(TestableTime_Effects(1.f));
+        REQUIRE(particles.getSizes()[0] == Approx(8.f));
+        REQUIRE(particles.getColors()[0] == sf::Color(75, 0, 50, 105));
+    }
+}
+
+TEST_CASE("[ParticleEffectSystem] Parallel update")
+{
+    const auto effect = dgm::ps::ParticleEffect {
+        .emitters = { { .shape = dgm::ps::Emitter::Circle { .radius = 20.f },
+                        .rate = 2000.f,
+                        .burst = 3000,
+                        .spread = sf::degrees(30.f),
+                        .minSpeed = 10.f,
+                        .maxSpeed = 100.f,
+                        .minLifespan = 0.5f,
+                        .maxLifespan = 2.f } },
+        .affectors = { dgm::ps::ForceAffector { .acceleration = { 0.f, 9.f } },
+                       dgm::ps::SizeOverLifeAffector {} },
+    };
+    auto&& serial = dgm::ps::ParticleEffectSystem(4096, effect, 42);
+    auto&& parallel = dgm::ps::ParticleEffectSystem(4096, effect, 42);
+    auto&& pool = dgm::WorkerPool(3);
+
+    for (unsigned i = 0; i < 10; ++i)
+    {
+        serial.update(TestableTime_Effects(0.1f));
+        parallel.update(TestableTime_Effects(0.1f), pool);
+    }
+
+    auto&& expected = serial.getParticles();
+    auto&& actual = parallel.getParticles();
+    REQUIRE(actual.getSize() == expected.getSize());
+    REQUIRE(std::ranges::equal(
+        actual.getPositionsX(), expected.getPositionsX()));
+    REQUIRE(std::ranges::equal(actual.getSizes(), expected.getSizes()));
+}
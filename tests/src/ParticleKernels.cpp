@@ -0,0 +1,161 @@
+#include <DGM/classes/ParticleKernels.hpp>
+#include <catch2/catch_all.hpp>
+#include <cmath>
+#include <numbers>
+#include <numeric>
+#include <span>
+#include <vector>
+
+using Catch::Approx;
+using dgm::ps::ParticleKernels;
+
+TEST_CASE("[ParticleKernels]")
+{
+    // Lengths that do not fill whole lanes exercise the scalar tail
+    const std::size_t count = GENERATE(0u, 1u, 3u, 4u, 7u, 8u, 13u, 33u);
+
+    auto&& values = std::vector<float>(count);
+    std::iota(values.begin(), values.end(), 0.f);
+
+    SECTION("Integrating positions")
+    {
+        auto&& positions = std::vector<float>(count, 1.f);
+        ParticleKernels::integrate(positions, values, 0.5f);
+        for (std::size_t i = 0; i < count; ++i)
+            REQUIRE(positions[i] == 1.f + values[i] * 0.5f);
+    }
+
+    SECTION("Applying force")
+    {
+        ParticleKernels::applyForce(values, 10.f, 0.25f);
+        for (std::size_t i = 0; i < count; ++i)
+            REQUIRE(values[i] == static_cast<float>(i) + 2.5f);
+    }
+
+    SECTION("Applying drag")
+    {
+        ParticleKernels::applyDrag(values, 0.5f, 1.f);
+        for (std::size_t i = 0; i < count; ++i)
+            REQUIRE(values[i] == static_cast<float>(i) * 0.5f);
+
+        // Drag never reverses the direction
+        ParticleKernels::applyDrag(values, 4.f, 1.f);
+        for (std::size_t i = 0; i < count; ++i)
+            REQUIRE(values[i] == 0.f);
+    }
+
+    SECTION("Interpolating over life")
+    {
+        auto&& initialLifespans = std::vector<float>(count, 4.f);
+        auto&& lifespans = std::vector<float>(count);
+        for (std::size_t i = 0; i < count; ++i)
+            lifespans[i] = static_cast<float>(i % 5);
+
+        ParticleKernels::interpolateOverLife(
+            values, lifespans, initialLifespans, 10.f, 2.f);
+        for (std::size_t i = 0; i < count; ++i)
+            REQUIRE(values[i] == Approx(2.f + 2.f * lifespans[i]));
+    }
+
+    SECTION("Rotating")
+    {
+        constexpr float PI = std::numbers::pi_v<float>;
+        for (std::size_t i = 0; i < count; ++i)
+            values[i] = static_cast<float>(i % 7) - 3.f;
+
+        // Results are wrapped into [-pi, pi]
+        ParticleKernels::rotate(values, -2.f, 0.5f);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const float expected = static_cast<float>(i % 7) - 4.f;
+            REQUIRE(values[i] >= -PI);
+            REQUIRE(values[i] <= PI);
+            REQUIRE(std::cos(values[i]) == Approx(std::cos(expected)));
+            REQUIRE(std::sin(values[i]) == Approx(std::sin(expected)));
+        }
+    }
+
+    SECTION("Decaying lifespans")
+    {
+        ParticleKernels::decayLifespans(values, 0.5f);
+        for (std::size_t i = 0; i < count; ++i)
+            REQUIRE(values[i] == static_cast<float>(i) - 0.5f);
+    }
+}
+
+/**
+ *  Compare corner offsets of unit squares with double precision
+ */
+static void requireCornerOffsets(
+    std::span<const float> rotations, std::span<const double> expectedAngles)
+{
+    const auto sizes = std::vector<float>(rotations.size(), 2.f);
+    auto&& p = std::vector<float>(rotations.size());
+    auto&& q = std::vector<float>(rotations.size());
+    ParticleKernels::computeCornerOffsets(sizes, rotations, p, q);
+
+    for (std::size_t i = 0; i < rotations.size(); ++i)
+    {
+        const double cos = std::cos(expectedAngles[i]);
+        const double sin = std::sin(expectedAngles[i]);
+        REQUIRE(p[i] == Approx(cos + sin).margin(2e-6));
+        REQUIRE(q[i] == Approx(cos - sin).margin(2e-6));
+    }
+}
+
+TEST_CASE("[ParticleKernels] Corner offsets")
+{
+    REQUIRE(ParticleKernels::getInstructionSet() != nullptr);
+
+    SECTION("Many turns in both directions")
+    {
+        // Including values close to quadrant boundaries
+        auto&& rotations = std::vector<float>();
+        for (int i = -2000; i <= 2000; ++i)
+            rotations.push_back(static_cast<float>(i) * 0.0523f);
+        rotations.push_back(std::numbers::pi_v<float>);
+        rotations.push_back(-std::numbers::pi_v<float> / 2.f);
+
+        auto&& sizes = std::vector<float>(rotations.size());
+        for (std::size_t i = 0; i < sizes.size(); ++i)
+            sizes[i] = 2.f + static_cast<float>(i % 5);
+
+        auto&& p = std::vector<float>(rotations.size());
+        auto&& q = std::vector<float>(rotations.size());
+        ParticleKernels::computeCornerOffsets(sizes, rotations, p, q);
+
+        for (std::size_t i = 0; i < rotations.size(); ++i)
+        {
+            const double halfSize = sizes[i] / 2.0;
+            const double cos = std::cos(static_cast<double>(rotations[i]));
+            const double sin = std::sin(static_cast<double>(rotations[i]));
+            REQUIRE(
+                p[i]
+                == Approx(halfSize * (cos + sin)).margin(halfSize * 2e-6));
+            REQUIRE(
+                q[i]
+                == Approx(halfSize * (cos - sin)).margin(halfSize * 2e-6));
+        }
+    }
+
+    SECTION("Limits of the documented range")
+    {
+        const auto rotations =
+            std::vector<float> { -1e4f, -7777.7f, 9999.9f, 1e4f };
+        auto&& angles = std::vector<double>();
+        for (float rotation : rotations)
+            angles.push_back(rotation);
+        requireCornerOffsets(rotations, angles);
+    }
+
+    SECTION("Rotations accumulated far beyond the range are wrapped")
+    {
+        // 3e9 radians in total, angles are exact in double
+        auto&& rotations = std::vector<float>(5, 0.5f);
+        for (unsigned i = 0; i < 3; ++i)
+            ParticleKernels::rotate(rotations, 1e7f, 100.f);
+
+        const auto angles = std::vector<double>(5, 0.5 + 3e9);
+        requireCornerOffsets(rotations, angles);
+    }
+}
@@ -0,0 +1,85 @@
+#include <DGM/classes/ParticleSystemInterface.hpp>
+#include <DGM/classes/Window.hpp>
+#include <catch2/catch_all.hpp>
+
+/**
+ *  Spawns particles and removes them directly from the buffer,
+ *  like the effects in examples do
+ */
+class TestableParticleSystemInterface
+    : public dgm::ps::ParticleSystemInterface
+{
+public:
+    using ParticleSystemInterface::ParticleSystemInterface;
+
+    void update(const dgm::Time&) override {}
+
+    void spawn(float x)
+    {
+        REQUIRE(particles.grow());
+        particles.getLast()->spawn(
+            { x, 0.f }, { 2.f, 2.f }, sf::seconds(1.f));
+    }
+
+    void remove(std::size_t index)
+    {
+        particles[index]->despawn();
+        particles.remove(index);
+    }
+
+    [[nodiscard]] const auto& getParticles() const
+    {
+        return particles;
+    }
+
+    [[nodiscard]] std::span<sf::Vertex> getVertices()
+    {
+        return renderer.getVertices();
+    }
+
+    [[nodiscard]] std::size_t getSubmittedVertexCount() const
+    {
+        return renderer.getSubmittedVertexCount();
+    }
+};
+
+TEST_CASE("[ParticleSystemInterface]")
+{
+    auto&& window = dgm::Window({ 1u, 1u }, "", false);
+    auto&& system = TestableParticleSystemInterface(5);
+
+    SECTION("Nothing is drawn without live particles")
+    {
+        system.draw(window);
+        REQUIRE(system.getSubmittedVertexCount() == 0u);
+    }
+
+    SECTION("Live particles are moved to the beginning of vertex array")
+    {
+        for (float x : { 0.f, 10.f, 20.f, 30.f, 40.f })
+            system.spawn(x);
+        system.remove(0);
+        system.remove(2);
+        system.spawn(50.f);
+        system.remove(1);
+
+        system.draw(window);
+        REQUIRE(system.getSubmittedVertexCount() == 18u);
+
+        auto&& particles = system.getParticles();
+        auto&& vertices = system.getVertices();
+        auto&& drawnPositions = std::vector<float>();
+        for (std::size_t i = 0; i < particles.getSize(); ++i)
+        {
+            REQUIRE(particles[i]->getVertices().data() == &vertices[i * 6]);
+            drawnPositions.push_back(particles[i]->getPosition().x);
+        }
+        std::ranges::sort(drawnPositions);
+        REQUIRE(drawnPositions == std::vector { 30.f, 40.f, 50.f });
+
+        // Quads of live particles keep their content
+        REQUIRE(
+            (vertices[0].position + vertices[4].position) / 2.f
+            == particles[0]->getPosition());
+    }
+}
@@ -0,0 +1,167 @@
+#include <DGM/dgm.hpp>
+#include <RandomMesh.hpp>
+#include <catch2/catch_all.hpp>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    template<class NavpointType>
+    [[nodiscard]] auto toCoords(dgm::Path<NavpointType>&& path)
+    {
+        auto&& result = std::vector<decltype(NavpointType::coord)>();
+        for (; !path.isTraversed(); path.advance())
+            result.push_back(path.getCurrentPoint().coord);
+        return result;
+    }
+} // namespace
+
+TEST_CASE("[PathRequest]")
+{
+    const unsigned width = 40u, height = 30u;
+    const auto mesh = buildRandomMesh(width, height, 9u, 4u);
+
+    SECTION("Stepped tile request matches computePath")
+    {
+        auto rng = std::mt19937(1u);
+        for (unsigned i = 0; i < 50; ++i)
+        {
+            const auto from =
+                sf::Vector2u(1 + rng() % (width - 2), 1 + rng() % (height - 2));
+            const auto to =
+                sf::Vector2u(1 + rng() % (width - 2), 1 + rng() % (height - 2));
+            INFO("From " << from.x << ", " << from.y);
+            INFO("To " << to.x << ", " << to.y);
+
+            auto expected = dgm::TileNavMesh::computePath(from, to, mesh);
+            auto request = dgm::TileNavMesh::requestPath(from, to, mesh);
+            while (request.step(3) == dgm::PathRequestStatus::InProgress)
+                ;
+
+            auto path = request.takePath();
+            REQUIRE(path.has_value() == expected.has_value());
+            if (!expected) continue;
+
+            REQUIRE(request.getStatus() == dgm::PathRequestStatus::Found);
+            REQUIRE(
+                toCoords(std::move(*path)) == toCoords(std::move(*expected)));
+        }
+    }
+
+    SECTION("Stepped world request matches computePath")
+    {
+        const auto navmesh = dgm::WorldNavMesh(mesh.clone());
+
+        auto rng = std::mt19937(2u);
+        std::size_t multiStepCount = 0;
+        for (unsigned i = 0; i < 50; ++i)
+        {
+            auto&& randomPoint = [&]
+            {
+                return sf::Vector2f(
+                    (1 + rng() % (width - 2)) * 32.f + 16.f,
+                    (1 + rng() % (height - 2)) * 32.f + 16.f);
+            };
+            const auto from = randomPoint(), to = randomPoint();
+
+            auto request = navmesh.requestPath(from, to);
+            std::size_t stepCount = 1;
+            while (request.step(1) == dgm::PathRequestStatus::InProgress)
+                ++stepCount;
+            if (stepCount > 2) ++multiStepCount;
+
+            const auto expected = toCoords(navmesh.computePath(from, to));
+            auto path = request.takePath();
+            if (expected.empty())
+            {
+                REQUIRE((!path || path->getLength() == 0u));
+                continue;
+            }
+
+            REQUIRE(path.has_value());
+            REQUIRE(toCoords(std::move(*path)) == expected);
+        }
+
+        // Budget actually split the searches
+        REQUIRE(multiStepCount > 10u);
+    }
+
+    SECTION("Trivial requests end in the first step")
+    {
+        auto identity =
+            dgm::TileNavMesh::requestPath({ 1u, 1u }, { 1u, 1u }, mesh);
+        REQUIRE(identity.getStatus() == dgm::PathRequestStatus::InProgress);
+        REQUIRE(identity.step(0) == dgm::PathRequestStatus::Found);
+        REQUIRE(identity.takePath()->getLength() == 0u);
+
+        auto fromWall =
+            dgm::TileNavMesh::requestPath({ 0u, 0u }, { 1u, 1u }, mesh);
+        REQUIRE(fromWall.step(0) == dgm::PathRequestStatus::NotFound);
+        REQUIRE_FALSE(fromWall.takePath().has_value());
+    }
+
+    SECTION("Unconnected tiles are rejected with components")
+    {
+        // clang-format off
+        const std::vector<int> splitMap = {
+            1, 1, 1, 1, 1,
+            1, 0, 1, 0, 1,
+            1, 1, 1, 1, 1,
+        };
+        // clang-format on
+        const auto splitMesh = dgm::Mesh(splitMap, { 5u, 3u }, { 32u, 32u });
+        const auto components = dgm::ConnectedComponents(splitMesh);
+
+        auto request = dgm::TileNavMesh::requestPath(
+            { 1u, 1u }, { 3u, 1u }, splitMesh, components);
+        REQUIRE(request.step(0) == dgm::PathRequestStatus::NotFound);
+    }
+
+    SECTION("Cancelled request stops at the next step")
+    {
+        auto request = dgm::TileNavMesh::requestPath(
+            { 1u, 1u }, { width - 2, height - 2 }, mesh);
+        REQUIRE(request.step(1) == dgm::PathRequestStatus::InProgress);
+
+        request.cancel();
+        REQUIRE(request.getStatus() == dgm::PathRequestStatus::InProgress);
+        REQUIRE(request.step(1000) == dgm::PathRequestStatus::Cancelled);
+        REQUIRE(request.isDone());
+        REQUIRE_FALSE(request.takePath().has_value());
+
+        // Done requests are not affected by further steps
+        REQUIRE(request.step(1000) == dgm::PathRequestStatus::Cancelled);
+    }
+
+    SECTION("Request can be computed on a worker thread")
+    {
+        const auto navmesh = dgm::WorldNavMesh(mesh.clone());
+        const auto from = sf::Vector2f(48.f, 48.f);
+        const auto to = sf::Vector2f(1232.f, 912.f);
+
+        auto requests = std::vector<dgm::PathRequest<dgm::WorldNavpoint>>();
+        requests.push_back(navmesh.requestPath(from, to));
+        requests.push_back(navmesh.requestPath(from, to));
+        requests[1].cancel();
+
+        {
+            auto&& worker = std::jthread(
+                [&]
+                {
+                    for (auto&& request : requests)
+                        request.run();
+                });
+            requests[0].wait();
+            requests[1].wait();
+        }
+
+        REQUIRE(requests[0].getStatus() != dgm::PathRequestStatus::InProgress);
+        REQUIRE(requests[1].getStatus() == dgm::PathRequestStatus::Cancelled);
+
+        auto path = requests[0].takePath();
+        const auto expected = toCoords(navmesh.computePath(from, to));
+        REQUIRE(path.has_value() == !expected.empty());
+        if (path) REQUIRE(toCoords(std::move(*path)) == expected);
+    }
+}
@@ -230,3 +230,167 @@ TEST_CASE("[Raycaster] - raycast with callback")
         }
     }
 }
+
+TEST_CASE("[Raycaster] - hasDirectVisibility with callback")
+{
+    auto mesh = buildTestMesh();
+
+    SECTION("Traversal stops at the destination tile")
+    {
+        std::vector<sf::Vector2u> visited;
+        const bool visible = dgm::Raycaster::hasDirectVisibility(
+            tileCenter(1, 1),
+            tileCenter(3, 1),
+            mesh,
+            [&visited](const sf::Vector2u& tile) { visited.push_back(tile); });
+
+        REQUIRE(visible);
+        REQUIRE(visited.size() == 3);
+        CHECK(visited[0] == sf::Vector2u(1u, 1u));
+        CHECK(visited[1] == sf::Vector2u(2u, 1u));
+        CHECK(visited[2] == sf::Vector2u(3u, 1u));
+    }
+
+    SECTION("Blocking tile is reported")
+    {
+        std::vector<sf::Vector2u> visited;
+        const bool visible = dgm::Raycaster::hasDirectVisibility(
+            tileCenter(1, 3),
+            tileCenter(8, 3),
+            mesh,
+            [&visited](const sf::Vector2u& tile) { visited.push_back(tile); });
+
+        REQUIRE_FALSE(visible);
+        REQUIRE(visited.size() == 4);
+        CHECK(visited.back() == sf::Vector2u(4u, 3u));
+    }
+
+    SECTION("Result matches overload without callback")
+    {
+        for (unsigned y = 1; y < 7; ++y)
+        {
+            for (unsigned x = 1; x < 9; ++x)
+            {
+                INFO("Tile " << x << ", " << y);
+                REQUIRE(
+                    dgm::Raycaster::hasDirectVisibility(
+                        tileCenter(2, 5), tileCenter(x, y), mesh)
+                    == dgm::Raycaster::hasDirectVisibility(
+                        tileCenter(2, 5),
+                        tileCenter(x, y),
+                        mesh,
+                        [](const sf::Vector2u&) {}));
+            }
+        }
+    }
+}
+
+TEST_CASE("[Raycaster] - raycast with actors")
+{
+    struct Actor
+    {
+        dgm::Circle body;
+    };
+
+    auto mesh = buildTestMesh();
+    auto actors = dgm::SpatialBuffer<Actor>(
+        dgm::Rect({ 0.f, 0.f }, { 10.f * VOXEL, 8.f * VOXEL }), 8);
+    auto&& addActor = [&](const sf::Vector2f& position, float radius)
+    {
+        const auto body = dgm::Circle(position, radius);
+        return actors.insert(Actor { body }, body);
+    };
+    auto&& getBody = [](const Actor& actor) -> const dgm::Circle&
+    { return actor.body; };
+
+    SECTION("Returns the wall when no actor is in the way")
+    {
+        addActor(tileCenter(6, 5), 8.f);
+
+        const auto result = dgm::Raycaster::raycast(
+            tileCenter(1, 1), { 1.f, 0.f }, mesh, actors, getBody);
+
+        REQUIRE(result.kind == dgm::Raycaster::HitKind::Tile);
+        CHECK(result.tile == sf::Vector2u(9u, 1u));
+        CHECK(result.hitLocation.x == Catch::Approx(9.f * VOXEL));
+        CHECK(result.distance == Catch::Approx(7.5f * VOXEL));
+    }
+
+    SECTION("Returns the nearest actor in front of the wall")
+    {
+        addActor(tileCenter(7, 1), 8.f);
+        const auto nearId = addActor(tileCenter(5, 1), 8.f);
+
+        const auto result = dgm::Raycaster::raycast(
+            tileCenter(1, 1), { 1.f, 0.f }, mesh, actors, getBody);
+
+        REQUIRE(result.kind == dgm::Raycaster::HitKind::Actor);
+        CHECK(result.actorId == nearId);
+        CHECK(result.hitLocation.x == Catch::Approx(5.5f * VOXEL - 8.f));
+        CHECK(result.hitLocation.y == Catch::Approx(1.5f * VOXEL));
+        CHECK(result.distance == Catch::Approx(4.f * VOXEL - 8.f));
+    }
+
+    SECTION("Actors behind a wall are ignored")
+    {
+        addActor(tileCenter(6, 3), 8.f);
+
+        const auto result = dgm::Raycaster::raycast(
+            tileCenter(1, 3), { 1.f, 0.f }, mesh, actors, getBody);
+
+        REQUIRE(result.kind == dgm::Raycaster::HitKind::Tile);
+        CHECK(result.tile == sf::Vector2u(4u, 3u));
+    }
+
+    SECTION("Works with rectangular shapes and diagonal rays")
+    {
+        struct Crate
+        {
+            dgm::Rect box;
+        };
+
+        auto crates = dgm::SpatialBuffer<Crate>(
+            dgm::Rect({ 0.f, 0.f }, { 10.f * VOXEL, 8.f * VOXEL }), 4);
+        const auto box = dgm::Rect(tileCenter(5, 5), { 16.f, 16.f });
+        const auto id = crates.insert(Crate { box }, box);
+
+        const auto result = dgm::Raycaster::raycast(
+            tileCenter(1, 1),
+            { 1.f, 1.f },
+            mesh,
+            crates,
+            [](const Crate& crate) { return crate.box; });
+
+        REQUIRE(result.kind == dgm::Raycaster::HitKind::Actor);
+        CHECK(result.actorId == id);
+        CHECK(result.hitLocation.x == Catch::Approx(5.5f * VOXEL));
+        CHECK(result.hitLocation.y == Catch::Approx(5.5f * VOXEL));
+    }
+
+    SECTION("Ray starting inside an actor hits it immediately")
+    {
+        const auto id = addActor(tileCenter(2, 2), 20.f);
+
+        const auto result = dgm::Raycaster::raycast(
+            tileCenter(2, 2), { -1.f, 0.f }, mesh, actors, getBody);
+
+        REQUIRE(result.kind == dgm::Raycaster::HitKind::Actor);
+        CHECK(result.actorId == id);
+        CHECK(result.distance == 0.f);
+    }
+
+    SECTION("Ray starting inside a solid tile hits it immediately")
+    {
+        // Actor in front of the origin must not win over the wall
+        addActor(tileCenter(5, 4), 8.f);
+        const auto origin = tileCenter(4, 3) + sf::Vector2f(-10.f, 5.f);
+
+        const auto result = dgm::Raycaster::raycast(
+            origin, { 1.f, 0.7f }, mesh, actors, getBody);
+
+        REQUIRE(result.kind == dgm::Raycaster::HitKind::Tile);
+        CHECK(result.tile == sf::Vector2u(4u, 3u));
+        CHECK(result.hitLocation == origin);
+        CHECK(result.distance == 0.f);
+    }
+}
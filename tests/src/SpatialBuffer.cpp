@@ -69,4 +69,79 @@ TEST_CASE("[SpatialBuffer]")
             dgm::SpatialBuffer<int>(dgm::Rect({ 0.f, 0.f }, { 16.f, 16.f }), 8);
         std::ignore = std::move(buffer);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("[SpatialBuffer] - walking along a ray")
+{
+    auto&& buffer =
+        dgm::SpatialBuffer<int>(dgm::Rect({ 0.f, 0.f }, { 16.f, 16.f }), 4);
+    const auto nearId = buffer.insert(1, dgm::Circle({ 6.f, 2.f }, 1.f));
+    const auto farId = buffer.insert(2, dgm::Circle({ 14.f, 2.f }, 1.f));
+    buffer.insert(3, dgm::Circle({ 2.f, 14.f }, 1.f));
+
+    auto&& collect = [&](const sf::Vector2f& origin,
+                         const sf::Vector2f& direction,
+                         float maxDistance)
+    {
+        std::vector<std::size_t> ids;
+        buffer.forEachCellAlongRay(
+            origin,
+            direction,
+            maxDistance,
+            [&](const std::vector<std::size_t>& cell, float)
+            {
+                ids.insert(ids.end(), cell.begin(), cell.end());
+                return true;
+            });
+        return ids;
+    };
+
+    SECTION("Visits cells in the order of the ray")
+    {
+        auto&& ids = collect({ 0.5f, 2.f }, { 1.f, 0.f }, 100.f);
+        REQUIRE(ids.size() == 2u);
+        CHECK(ids[0] == nearId);
+        CHECK(ids[1] == farId);
+
+        auto&& reversed = collect({ 15.5f, 2.f }, { -1.f, 0.f }, 100.f);
+        REQUIRE(reversed.size() == 2u);
+        CHECK(reversed[0] == farId);
+        CHECK(reversed[1] == nearId);
+    }
+
+    SECTION("Stops at max distance")
+    {
+        auto&& ids = collect({ 0.5f, 2.f }, { 1.f, 0.f }, 6.f);
+        REQUIRE(ids.size() == 1u);
+        CHECK(ids[0] == nearId);
+    }
+
+    SECTION("Stops when callback returns false")
+    {
+        unsigned calls = 0;
+        buffer.forEachCellAlongRay(
+            { 0.5f, 2.f },
+            { 1.f, 0.f },
+            100.f,
+            [&](const std::vector<std::size_t>&, float exitDistance)
+            {
+                ++calls;
+                CHECK(exitDistance == Catch::Approx(7.5f));
+                return false;
+            });
+        CHECK(calls == 1u);
+    }
+
+    SECTION("Ray starting outside of the bounding box enters it")
+    {
+        auto&& ids = collect({ -10.f, 2.f }, { 1.f, 0.f }, 100.f);
+        REQUIRE(ids.size() == 2u);
+        CHECK(ids[0] == nearId);
+    }
+
+    SECTION("Ray missing the bounding box visits nothing")
+    {
+        REQUIRE(collect({ -10.f, 2.f }, { 0.f, 1.f }, 100.f).empty());
+        REQUIRE(collect({ -10.f, 2.f }, { -1.f, 0.f }, 100.f).empty());
+    }
+}
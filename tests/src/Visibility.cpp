@@ -0,0 +1,201 @@
+#include <DGM/dgm.hpp>
+#include <algorithm>
+#include <catch2/catch_all.hpp>
+#include <vector>
+
+namespace
+{
+    // 10x8 grid with border walls and one interior wall at (4,3)
+    //
+    // Row 0: 1 1 1 1 1 1 1 1 1 1
+    // Row 1: 1 . . . . . . . . 1
+    // Row 2: 1 . . . . . . . . 1
+    // Row 3: 1 . . . W . . . . 1
+    // Row 4: 1 . . . . . . . . 1
+    // Row 5: 1 . . . . . . . . 1
+    // Row 6: 1 . . . . . . . . 1
+    // Row 7: 1 1 1 1 1 1 1 1 1 1
+    [[nodiscard]] dgm::Mesh buildTestMesh()
+    {
+        // clang-format off
+        const std::vector<int> map = {
+            1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+            1, 0, 0, 0, 0, 0, 0, 0, 0, 1,
+            1, 0, 0, 0, 0, 0, 0, 0, 0, 1,
+            1, 0, 0, 0, 1, 0, 0, 0, 0, 1,
+            1, 0, 0, 0, 0, 0, 0, 0, 0, 1,
+            1, 0, 0, 0, 0, 0, 0, 0, 0, 1,
+            1, 0, 0, 0, 0, 0, 0, 0, 0, 1,
+            1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        };
+        // clang-format on
+
+        return dgm::Mesh(map, { 10u, 8u }, { 32u, 32u });
+    }
+
+    constexpr float VOXEL = 32.f;
+
+    // Center of tile (x, y) in world coordinates
+    [[nodiscard]] sf::Vector2f tileCenter(unsigned x, unsigned y)
+    {
+        return { (x + 0.5f) * VOXEL, (y + 0.5f) * VOXEL };
+    }
+} // namespace
+
+TEST_CASE("[Visibility] - visible tiles")
+{
+    auto mesh = buildTestMesh();
+    auto visibility = dgm::Visibility();
+
+    SECTION("Open rows and columns are fully visible with large radius")
+    {
+        visibility.compute(tileCenter(1, 1), 1000.f, mesh);
+
+        for (unsigned x = 0; x < 10; ++x)
+        {
+            INFO("Tile " << x << ", 1");
+            CHECK(visibility.isTileVisible({ x, 1u }));
+        }
+
+        for (unsigned y = 0; y < 8; ++y)
+        {
+            INFO("Tile 1, " << y);
+            CHECK(visibility.isTileVisible({ 1u, y }));
+        }
+
+        // Directly behind the interior wall
+        CHECK_FALSE(visibility.isTileVisible({ 6u, 4u }));
+    }
+
+    SECTION("Interior wall casts a shadow")
+    {
+        visibility.compute(tileCenter(1, 3), 1000.f, mesh);
+
+        CHECK(visibility.isTileVisible({ 3u, 3u }));
+        CHECK(visibility.isTileVisible({ 4u, 3u }));
+        CHECK_FALSE(visibility.isTileVisible({ 5u, 3u }));
+        CHECK_FALSE(visibility.isTileVisible({ 8u, 3u }));
+        CHECK(visibility.isTileVisible({ 8u, 1u }));
+        CHECK(visibility.isTileVisible({ 8u, 6u }));
+    }
+
+    SECTION("Each tile is reported exactly once")
+    {
+        visibility.compute(tileCenter(3, 4), 1000.f, mesh);
+
+        auto tiles = visibility.getVisibleTiles();
+        const auto count = tiles.size();
+        std::sort(
+            tiles.begin(),
+            tiles.end(),
+            dgm::Utility::less<sf::Vector2u>());
+        tiles.erase(std::unique(tiles.begin(), tiles.end()), tiles.end());
+
+        REQUIRE(tiles.size() == count);
+        for (auto&& tile : tiles)
+            CHECK(visibility.isTileVisible(tile));
+    }
+
+    SECTION("Radius limits the visible area")
+    {
+        visibility.compute(tileCenter(2, 2), VOXEL * 1.5f, mesh);
+
+        CHECK(visibility.isTileVisible({ 2u, 2u }));
+        CHECK(visibility.isTileVisible({ 3u, 2u }));
+        CHECK(visibility.isTileVisible({ 3u, 3u }));
+        CHECK_FALSE(visibility.isTileVisible({ 4u, 2u }));
+        CHECK_FALSE(visibility.isTileVisible({ 2u, 4u }));
+    }
+
+    SECTION("Origin inside a solid tile only sees that tile")
+    {
+        visibility.compute(tileCenter(4, 3), 1000.f, mesh);
+
+        REQUIRE(visibility.getVisibleTiles().size() == 1u);
+        CHECK(visibility.isTileVisible({ 4u, 3u }));
+    }
+
+    SECTION("Recomputing discards previous results")
+    {
+        visibility.compute(tileCenter(1, 3), 1000.f, mesh);
+        REQUIRE_FALSE(visibility.isTileVisible({ 6u, 3u }));
+
+        visibility.compute(tileCenter(8, 3), 1000.f, mesh);
+        CHECK(visibility.isTileVisible({ 6u, 3u }));
+        CHECK_FALSE(visibility.isTileVisible({ 2u, 3u }));
+    }
+
+    SECTION("Agrees with Raycaster on tile-center lines of sight")
+    {
+        const auto origin = tileCenter(2, 5);
+        visibility.compute(origin, 1000.f, mesh);
+
+        for (unsigned y = 1; y < 7; ++y)
+        {
+            for (unsigned x = 1; x < 9; ++x)
+            {
+                if (mesh[sf::Vector2u(x, y)] > 0) continue;
+                if (!dgm::Raycaster::hasDirectVisibility(
+                        origin, tileCenter(x, y), mesh))
+                    continue;
+
+                INFO("Tile " << x << ", " << y);
+                CHECK(visibility.isTileVisible({ x, y }));
+            }
+        }
+    }
+}
+
+TEST_CASE("[Visibility] - visibility polygon")
+{
+    auto mesh = buildTestMesh();
+    auto visibility = dgm::Visibility();
+
+    SECTION("Polygon is not computed unless requested")
+    {
+        visibility.compute(tileCenter(2, 2), 1000.f, mesh);
+        REQUIRE(visibility.getVisibilityPolygon().empty());
+    }
+
+    SECTION("Polygon of a closed room touches its walls")
+    {
+        visibility.compute(tileCenter(2, 5), 1000.f, mesh, true);
+        auto&& polygon = visibility.getVisibilityPolygon();
+
+        REQUIRE(polygon.size() >= 4u);
+        for (auto&& point : polygon)
+        {
+            INFO("Point " << point.x << ", " << point.y);
+            CHECK(point.x >= VOXEL - 0.01f);
+            CHECK(point.x <= 9.f * VOXEL + 0.01f);
+            CHECK(point.y >= VOXEL - 0.01f);
+            CHECK(point.y <= 7.f * VOXEL + 0.01f);
+        }
+
+        // Room corners are visible from this point
+        auto&& hasPointNear = [&](const sf::Vector2f& target)
+        {
+            return std::any_of(
+                polygon.begin(),
+                polygon.end(),
+                [&](const sf::Vector2f& p)
+                { return (p - target).length() < 0.1f; });
+        };
+
+        CHECK(hasPointNear({ VOXEL, VOXEL }));
+        CHECK(hasPointNear({ VOXEL, 7.f * VOXEL }));
+        CHECK(hasPointNear({ 9.f * VOXEL, 7.f * VOXEL }));
+    }
+
+    SECTION("Polygon is bounded by radius in open directions")
+    {
+        const auto origin = tileCenter(5, 5);
+        const float radius = VOXEL * 1.2f;
+        visibility.compute(origin, radius, mesh, true);
+
+        auto&& polygon = visibility.getVisibilityPolygon();
+        REQUIRE_FALSE(polygon.empty());
+        for (auto&& point : polygon)
+            CHECK((point - origin).length() <= radius + 0.01f);
+    }
+}
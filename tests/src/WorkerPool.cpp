@@ -0,0 +1,36 @@
+#include <DGM/classes/WorkerPool.hpp>
+#include <catch2/catch_all.hpp>
+#include <vector>
+
+TEST_CASE("[WorkerPool]")
+{
+    const unsigned threadCount = GENERATE(1u, 2u, 4u);
+    auto&& pool = dgm::WorkerPool(threadCount);
+    REQUIRE(pool.getThreadCount() == threadCount);
+
+    SECTION("Every task runs exactly once")
+    {
+        // Many short jobs in a row check that workers waking up late
+        // do not interfere with the next job
+        for (std::size_t taskCount : { 0u, 1u, 3u, 64u, 1000u })
+        {
+            for (unsigned repeat = 0; repeat < 50; ++repeat)
+            {
+                auto&& counters = std::vector<int>(taskCount);
+                pool.forEach(
+                    taskCount, [&](std::size_t i) { ++counters[i]; });
+                REQUIRE(std::ranges::all_of(
+                    counters, [](int count) { return count == 1; }));
+            }
+        }
+    }
+
+    SECTION("Const task")
+    {
+        auto&& results = std::vector<std::size_t>(16);
+        const auto task = [&](std::size_t i) { results[i] = i * i; };
+        pool.forEach(results.size(), task);
+        for (std::size_t i = 0; i < results.size(); ++i)
+            REQUIRE(results[i] == i * i);
+    }
+}